@@ -0,0 +1,551 @@
+/*
+ * BoundingVolumes.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_BOUNDINGVOLUMES_HPP
+#define GLOWL_BOUNDINGVOLUMES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLOWL_HAS_SSE2 1
+#endif
+
+#if defined(GLOWL_HAS_SSE2) || defined(__AVX__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "Exceptions.hpp"
+#include "VertexLayout.hpp"
+#include "VertexPacking.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \struct BoundingBox
+     *
+     * \brief Axis-aligned bounding box. Empty (min > max) if no point was added.
+     */
+    struct BoundingBox
+    {
+        GLfloat min[3] = {std::numeric_limits<GLfloat>::max(),
+                          std::numeric_limits<GLfloat>::max(),
+                          std::numeric_limits<GLfloat>::max()};
+        GLfloat max[3] = {std::numeric_limits<GLfloat>::lowest(),
+                          std::numeric_limits<GLfloat>::lowest(),
+                          std::numeric_limits<GLfloat>::lowest()};
+
+        bool empty() const
+        {
+            return min[0] > max[0];
+        }
+
+        void extend(GLfloat const* point)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], point[i]);
+                max[i] = std::max(max[i], point[i]);
+            }
+        }
+
+        void extend(BoundingBox const& other)
+        {
+            if (!other.empty())
+            {
+                extend(other.min);
+                extend(other.max);
+            }
+        }
+    };
+
+    /**
+     * \struct BoundingSphere
+     *
+     * \brief Bounding sphere. Empty (negative radius) if no point was added.
+     */
+    struct BoundingSphere
+    {
+        GLfloat center[3] = {0.0f, 0.0f, 0.0f};
+        GLfloat radius = -1.0f;
+
+        bool empty() const
+        {
+            return radius < 0.0f;
+        }
+
+        /**
+         * \brief Grow to the smallest sphere that contains both spheres.
+         */
+        void extend(BoundingSphere const& other)
+        {
+            if (other.empty())
+            {
+                return;
+            }
+
+            GLfloat offset[3] = {other.center[0] - center[0], other.center[1] - center[1], other.center[2] - center[2]};
+            GLfloat distance = std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+            if (empty() || distance + radius <= other.radius)
+            {
+                *this = other;
+                return;
+            }
+            if (distance + other.radius <= radius)
+            {
+                return;
+            }
+
+            GLfloat new_radius = 0.5f * (distance + radius + other.radius);
+            for (int i = 0; i < 3; ++i)
+            {
+                center[i] += offset[i] * (new_radius - radius) / distance;
+            }
+            radius = new_radius;
+        }
+    };
+
+    /**
+     * \struct Bounds
+     *
+     * \brief Bounding box and bounding sphere of the same set of points, see computeBounds().
+     */
+    struct Bounds
+    {
+        BoundingBox    box;
+        BoundingSphere sphere;
+    };
+
+    namespace detail
+    {
+        constexpr std::size_t bounds_block_size = 256;
+
+        /*
+         * The kernels read positions as 3 consecutive floats every stride bytes. SIMD paths load 4 floats per
+         * position, which stays within the data for all but the last position, since the next position starts at
+         * least 12 bytes later. The fourth lane is ignored.
+         */
+        inline void extendBoundingBox(GLubyte const* positions, std::size_t cnt, std::size_t stride, BoundingBox& box)
+        {
+            std::size_t i = 0;
+
+#if defined(__AVX__)
+            __m256 box_min = _mm256_set1_ps(std::numeric_limits<GLfloat>::max());
+            __m256 box_max = _mm256_set1_ps(std::numeric_limits<GLfloat>::lowest());
+            for (; i + 2 < cnt; i += 2)
+            {
+                __m128 p0 = _mm_loadu_ps(reinterpret_cast<float const*>(positions + i * stride));
+                __m128 p1 = _mm_loadu_ps(reinterpret_cast<float const*>(positions + (i + 1) * stride));
+                __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(p0), p1, 1);
+                box_min = _mm256_min_ps(box_min, p);
+                box_max = _mm256_max_ps(box_max, p);
+            }
+
+            GLfloat lane_min[4];
+            GLfloat lane_max[4];
+            _mm_storeu_ps(lane_min, _mm_min_ps(_mm256_castps256_ps128(box_min), _mm256_extractf128_ps(box_min, 1)));
+            _mm_storeu_ps(lane_max, _mm_max_ps(_mm256_castps256_ps128(box_max), _mm256_extractf128_ps(box_max, 1)));
+            if (i > 0)
+            {
+                box.extend(lane_min);
+                box.extend(lane_max);
+            }
+#elif defined(GLOWL_HAS_SSE2)
+            __m128 box_min = _mm_set1_ps(std::numeric_limits<GLfloat>::max());
+            __m128 box_max = _mm_set1_ps(std::numeric_limits<GLfloat>::lowest());
+            for (; i + 1 < cnt; ++i)
+            {
+                __m128 p = _mm_loadu_ps(reinterpret_cast<float const*>(positions + i * stride));
+                box_min = _mm_min_ps(box_min, p);
+                box_max = _mm_max_ps(box_max, p);
+            }
+
+            GLfloat lane_min[4];
+            GLfloat lane_max[4];
+            _mm_storeu_ps(lane_min, box_min);
+            _mm_storeu_ps(lane_max, box_max);
+            if (i > 0)
+            {
+                box.extend(lane_min);
+                box.extend(lane_max);
+            }
+#endif
+
+            for (; i < cnt; ++i)
+            {
+                GLfloat position[3];
+                std::memcpy(position, positions + i * stride, sizeof(position));
+                box.extend(position);
+            }
+        }
+
+        /*
+         * Returns the largest squared distance of a position to center, same memory access as extendBoundingBox().
+         */
+        inline GLfloat computeMaxDistanceSquared(GLubyte const* positions,
+                                                 std::size_t    cnt,
+                                                 std::size_t    stride,
+                                                 GLfloat const* center)
+        {
+            GLfloat     retval = 0.0f;
+            std::size_t i = 0;
+
+#if defined(__AVX__)
+            __m256 const c =
+                _mm256_setr_ps(center[0], center[1], center[2], 0.0f, center[0], center[1], center[2], 0.0f);
+            __m256 const xyz_mask = _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0));
+            __m256       max_distance = _mm256_setzero_ps();
+            for (; i + 2 < cnt; i += 2)
+            {
+                __m128 p0 = _mm_loadu_ps(reinterpret_cast<float const*>(positions + i * stride));
+                __m128 p1 = _mm_loadu_ps(reinterpret_cast<float const*>(positions + (i + 1) * stride));
+                __m256 d = _mm256_and_ps(_mm256_sub_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(p0), p1, 1), c),
+                                         xyz_mask);
+                __m256 sq = _mm256_mul_ps(d, d);
+                // horizontal sum per 128bit lane, every element ends up with the full sum
+                sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(1, 0, 3, 2)));
+                sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+                max_distance = _mm256_max_ps(max_distance, sq);
+            }
+
+            retval = std::max(_mm_cvtss_f32(_mm256_castps256_ps128(max_distance)),
+                              _mm_cvtss_f32(_mm256_extractf128_ps(max_distance, 1)));
+#elif defined(GLOWL_HAS_SSE2)
+            __m128 const c = _mm_setr_ps(center[0], center[1], center[2], 0.0f);
+            __m128 const xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+            __m128       max_distance = _mm_setzero_ps();
+            for (; i + 1 < cnt; ++i)
+            {
+                __m128 p = _mm_loadu_ps(reinterpret_cast<float const*>(positions + i * stride));
+                __m128 d = _mm_and_ps(_mm_sub_ps(p, c), xyz_mask);
+                __m128 sq = _mm_mul_ps(d, d);
+                sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 0, 3, 2)));
+                sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+                max_distance = _mm_max_ps(max_distance, sq);
+            }
+
+            retval = _mm_cvtss_f32(max_distance);
+#endif
+
+            for (; i < cnt; ++i)
+            {
+                GLfloat position[3];
+                std::memcpy(position, positions + i * stride, sizeof(position));
+                GLfloat d[3] = {position[0] - center[0], position[1] - center[1], position[2] - center[2]};
+                retval = std::max(retval, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            }
+
+            return retval;
+        }
+
+        /*
+         * Decoders write positions as 4 floats each (xyz and an ignored fourth component).
+         */
+        inline void decodeHalfPositions(GLubyte const* data, std::size_t cnt, std::size_t stride, GLfloat* dst)
+        {
+            std::size_t i = 0;
+
+#if defined(__F16C__)
+            // loads 4 halfs, safe for all but the last position like the float kernels
+            for (; i + 1 < cnt; ++i)
+            {
+                __m128i half = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(data + i * stride));
+                _mm_storeu_ps(dst + 4 * i, _mm_cvtph_ps(half));
+            }
+#endif
+
+            for (; i < cnt; ++i)
+            {
+                std::uint16_t half[3];
+                std::memcpy(half, data + i * stride, sizeof(half));
+                for (int c = 0; c < 3; ++c)
+                {
+                    dst[4 * i + c] = convertHalfToFloat(half[c]);
+                }
+                dst[4 * i + 3] = 0.0f;
+            }
+        }
+
+#if defined(__SSE4_1__)
+        /*
+         * Load 4 components and widen them to 32 bit integers. There is no overload for unsigned int, which
+         * _mm_cvtepi32_ps would misinterpret above 2^31.
+         */
+        inline __m128i loadWidenedComponents(GLubyte const* data, std::int8_t)
+        {
+            int packed;
+            std::memcpy(&packed, data, sizeof(packed));
+            return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed));
+        }
+
+        inline __m128i loadWidenedComponents(GLubyte const* data, std::uint8_t)
+        {
+            int packed;
+            std::memcpy(&packed, data, sizeof(packed));
+            return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+        }
+
+        inline __m128i loadWidenedComponents(GLubyte const* data, std::int16_t)
+        {
+            return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data)));
+        }
+
+        inline __m128i loadWidenedComponents(GLubyte const* data, std::uint16_t)
+        {
+            return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data)));
+        }
+
+        inline __m128i loadWidenedComponents(GLubyte const* data, std::int32_t)
+        {
+            return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+        }
+
+        /*
+         * Returns the number of decoded positions, the remaining ones are left to the scalar loop.
+         */
+        template<typename ComponentType>
+        inline std::size_t decodeIntegerPositionsSIMD(GLubyte const* data,
+                                                      std::size_t    cnt,
+                                                      std::size_t    stride,
+                                                      GLfloat        scale,
+                                                      GLfloat        lower_limit,
+                                                      GLfloat*       dst,
+                                                      ComponentType  tag)
+        {
+            __m128 const scale_v = _mm_set1_ps(scale);
+            __m128 const lower_v = _mm_setr_ps(lower_limit, lower_limit, lower_limit, 0.0f);
+            __m128 const xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+            // loads 4 components, safe for all but the last position like the float kernels
+            std::size_t i = 0;
+            for (; i + 1 < cnt; ++i)
+            {
+                __m128 p = _mm_cvtepi32_ps(loadWidenedComponents(data + i * stride, tag));
+                _mm_storeu_ps(dst + 4 * i, _mm_max_ps(_mm_and_ps(_mm_mul_ps(p, scale_v), xyz_mask), lower_v));
+            }
+            return i;
+        }
+
+        inline std::size_t decodeIntegerPositionsSIMD(
+            GLubyte const*, std::size_t, std::size_t, GLfloat, GLfloat, GLfloat*, std::uint32_t)
+        {
+            return 0;
+        }
+#endif
+
+        template<typename ComponentType>
+        inline void decodeIntegerPositions(GLubyte const* data,
+                                           std::size_t    cnt,
+                                           std::size_t    stride,
+                                           GLfloat        scale,
+                                           GLfloat        lower_limit,
+                                           GLfloat*       dst)
+        {
+            std::size_t i = 0;
+
+#if defined(__SSE4_1__)
+            i = decodeIntegerPositionsSIMD(data, cnt, stride, scale, lower_limit, dst, ComponentType());
+#endif
+
+            for (; i < cnt; ++i)
+            {
+                ComponentType value[3];
+                std::memcpy(value, data + i * stride, sizeof(value));
+                for (int c = 0; c < 3; ++c)
+                {
+                    dst[4 * i + c] = std::max(static_cast<GLfloat>(value[c]) * scale, lower_limit);
+                }
+                dst[4 * i + 3] = 0.0f;
+            }
+        }
+
+        inline bool isBoundsAttributeSupported(VertexLayout::Attribute const& attribute, std::size_t stride)
+        {
+            switch (attribute.type)
+            {
+            case GL_FLOAT:
+            case GL_HALF_FLOAT:
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+                break;
+            default:
+                return false;
+            }
+
+            // GL_BGRA sizes are excluded as well
+            return attribute.size >= 3 && attribute.size <= 4 && attribute.offset >= 0 &&
+                   static_cast<std::size_t>(attribute.offset) + 3 * computeByteSize(attribute.type) <= stride;
+        }
+
+        /*
+         * Calls kernel(positions, cnt, stride) for the positions as 3 consecutive floats. Float positions are passed
+         * directly, others are decoded block-wise into a small buffer first.
+         */
+        template<typename Kernel>
+        inline void forEachPositionBlock(void const*                    vertex_data,
+                                         std::size_t                    vertex_cnt,
+                                         std::size_t                    stride,
+                                         VertexLayout::Attribute const& attribute,
+                                         Kernel                         kernel)
+        {
+            GLubyte const* data = static_cast<GLubyte const*>(vertex_data) + attribute.offset;
+            if (attribute.type == GL_FLOAT)
+            {
+                kernel(data, vertex_cnt, stride);
+                return;
+            }
+
+            // integer vertex shader inputs read the plain values
+            bool    normalized = attribute.normalized == GL_TRUE && attribute.shader_input_type == GL_FLOAT;
+            GLfloat unbounded = std::numeric_limits<GLfloat>::lowest();
+
+            GLfloat block[4 * bounds_block_size];
+            for (std::size_t first = 0; first < vertex_cnt; first += bounds_block_size)
+            {
+                std::size_t    cnt = std::min(bounds_block_size, vertex_cnt - first);
+                GLubyte const* src = data + first * stride;
+                switch (attribute.type)
+                {
+                case GL_HALF_FLOAT:
+                    decodeHalfPositions(src, cnt, stride, block);
+                    break;
+                case GL_BYTE:
+                    decodeIntegerPositions<std::int8_t>(
+                        src, cnt, stride, normalized ? 1.0f / 127.0f : 1.0f, normalized ? -1.0f : unbounded, block);
+                    break;
+                case GL_UNSIGNED_BYTE:
+                    decodeIntegerPositions<std::uint8_t>(
+                        src, cnt, stride, normalized ? 1.0f / 255.0f : 1.0f, unbounded, block);
+                    break;
+                case GL_SHORT:
+                    decodeIntegerPositions<std::int16_t>(
+                        src, cnt, stride, normalized ? 1.0f / 32767.0f : 1.0f, normalized ? -1.0f : unbounded, block);
+                    break;
+                case GL_UNSIGNED_SHORT:
+                    decodeIntegerPositions<std::uint16_t>(
+                        src, cnt, stride, normalized ? 1.0f / 65535.0f : 1.0f, unbounded, block);
+                    break;
+                case GL_INT:
+                    decodeIntegerPositions<std::int32_t>(src,
+                                                         cnt,
+                                                         stride,
+                                                         normalized ? 1.0f / 2147483647.0f : 1.0f,
+                                                         normalized ? -1.0f : unbounded,
+                                                         block);
+                    break;
+                case GL_UNSIGNED_INT:
+                    decodeIntegerPositions<std::uint32_t>(
+                        src, cnt, stride, normalized ? 1.0f / 4294967295.0f : 1.0f, unbounded, block);
+                    break;
+                }
+                kernel(reinterpret_cast<GLubyte const*>(block), cnt, 4 * sizeof(GLfloat));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * \brief Compute the bounding box and bounding sphere of a position attribute. The sphere is centered at the
+     * center of the box.
+     *
+     * Supports at least three components of type float, half float and (normalized) integer types. Float positions
+     * are processed in place with AVX or SSE2 kernels if available, other types are decoded (using F16C for half
+     * floats and SSE4.1 for integers except unsigned int if available) in small blocks first. Uses the first three
+     * components of the attribute.
+     *
+     * \param vertex_data Start of the vertex buffer, the attribute's offset is added
+     *
+     * \return Returns empty bounds if there are no vertices or if the attribute type is not supported.
+     */
+    inline Bounds computeBounds(void const*                    vertex_data,
+                                std::size_t                    vertex_cnt,
+                                std::size_t                    stride,
+                                VertexLayout::Attribute const& position)
+    {
+        Bounds retval;
+        if (vertex_cnt == 0 || !detail::isBoundsAttributeSupported(position, stride))
+        {
+            return retval;
+        }
+
+        detail::forEachPositionBlock(
+            vertex_data, vertex_cnt, stride, position, [&retval](GLubyte const* p, std::size_t cnt, std::size_t s) {
+                detail::extendBoundingBox(p, cnt, s, retval.box);
+            });
+
+        for (int c = 0; c < 3; ++c)
+        {
+            retval.sphere.center[c] = 0.5f * (retval.box.min[c] + retval.box.max[c]);
+        }
+
+        GLfloat radius_squared = 0.0f;
+        detail::forEachPositionBlock(
+            vertex_data, vertex_cnt, stride, position, [&](GLubyte const* p, std::size_t cnt, std::size_t s) {
+                radius_squared =
+                    std::max(radius_squared, detail::computeMaxDistanceSquared(p, cnt, s, retval.sphere.center));
+            });
+        retval.sphere.radius = std::sqrt(radius_squared);
+
+        return retval;
+    }
+
+    /**
+     * \brief Compute the bounds of consecutive vertex ranges of cluster_vertex_cnt vertices each (the last one
+     * possibly smaller), e.g. of vertex clusters or of submeshes stored one after another.
+     */
+    inline std::vector<Bounds> computeClusterBounds(void const*                    vertex_data,
+                                                    std::size_t                    vertex_cnt,
+                                                    std::size_t                    stride,
+                                                    VertexLayout::Attribute const& position,
+                                                    std::size_t                    cluster_vertex_cnt)
+    {
+        if (cluster_vertex_cnt == 0)
+        {
+            throw MeshException("computeClusterBounds - Cluster vertex count has to be > 0");
+        }
+
+        std::vector<Bounds> retval;
+        retval.reserve((vertex_cnt + cluster_vertex_cnt - 1) / cluster_vertex_cnt);
+        for (std::size_t first = 0; first < vertex_cnt; first += cluster_vertex_cnt)
+        {
+            retval.push_back(computeBounds(static_cast<GLubyte const*>(vertex_data) + first * stride,
+                                           std::min(cluster_vertex_cnt, vertex_cnt - first),
+                                           stride,
+                                           position));
+        }
+
+        return retval;
+    }
+
+    /**
+     * \brief Returns the index of the vertex layout that holds the positions, i.e. the first per-vertex layout.
+     * Its first attribute is the position. Returns the number of layouts if there is none.
+     */
+    inline std::size_t findPositionLayout(std::vector<VertexLayout> const& vertex_descriptor)
+    {
+        std::size_t retval = 0;
+        while (retval < vertex_descriptor.size() &&
+               (vertex_descriptor[retval].divisor != 0 || vertex_descriptor[retval].attributes.empty()))
+        {
+            ++retval;
+        }
+        return retval;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_BOUNDINGVOLUMES_HPP
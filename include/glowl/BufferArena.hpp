@@ -0,0 +1,710 @@
+/*
+ * BufferArena.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_BUFFERARENA_HPP
+#define GLOWL_BUFFERARENA_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "ImmutableBufferObject.hpp"
+#include "glinclude.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace glowl
+{
+
+    /**
+     * \class OffsetAllocator
+     *
+     * \brief Constant time range allocator in the spirit of TLSF.
+     *
+     * Free ranges are sorted into 256 size bins (a small floating point representation with 3 mantissa bits) that are
+     * tracked by a two level bitmask. Allocation and release only touch a fixed number of bins and neighbour nodes.
+     * The allocator only manages offsets and sizes (in arbitrary units), no memory.
+     */
+    class OffsetAllocator
+    {
+    public:
+        static constexpr std::uint32_t NO_SPACE = 0xFFFFFFFF;
+
+        struct Allocation
+        {
+            std::uint32_t offset = NO_SPACE;
+            std::uint32_t node = NO_SPACE;
+        };
+
+        OffsetAllocator(std::uint32_t size, std::uint32_t max_allocs = 128 * 1024);
+
+        /**
+         * \brief Allocate size units. Returns an allocation with offset NO_SPACE if no fitting free range exists.
+         */
+        Allocation allocate(std::uint32_t size);
+
+        void free(Allocation allocation);
+
+        std::uint32_t getAllocationSize(Allocation allocation) const;
+
+        std::uint32_t getSize() const;
+
+        std::uint32_t getFreeSize() const;
+
+    private:
+        static constexpr std::uint32_t MANTISSA_BITS = 3;
+        static constexpr std::uint32_t MANTISSA_VALUE = 1 << MANTISSA_BITS;
+        static constexpr std::uint32_t MANTISSA_MASK = MANTISSA_VALUE - 1;
+        static constexpr std::uint32_t NUM_TOP_BINS = 32;
+        static constexpr std::uint32_t BINS_PER_LEAF = 8;
+        static constexpr std::uint32_t TOP_BINS_INDEX_SHIFT = 3;
+        static constexpr std::uint32_t LEAF_BINS_INDEX_MASK = 0x7;
+        static constexpr std::uint32_t NUM_LEAF_BINS = NUM_TOP_BINS * BINS_PER_LEAF;
+        static constexpr std::uint32_t UNUSED = 0xFFFFFFFF;
+
+        struct Node
+        {
+            std::uint32_t data_offset = 0;
+            std::uint32_t data_size = 0;
+            std::uint32_t bin_list_prev = UNUSED;
+            std::uint32_t bin_list_next = UNUSED;
+            std::uint32_t neighbor_prev = UNUSED;
+            std::uint32_t neighbor_next = UNUSED;
+            bool          used = false;
+        };
+
+        static std::uint32_t lzcnt(std::uint32_t v);
+        static std::uint32_t tzcnt(std::uint32_t v);
+        static std::uint32_t findLowestSetBitAfter(std::uint32_t mask, std::uint32_t start_bit_index);
+        static std::uint32_t sizeToBinRoundUp(std::uint32_t size);
+        static std::uint32_t sizeToBinRoundDown(std::uint32_t size);
+
+        std::uint32_t insertNodeIntoBin(std::uint32_t size, std::uint32_t data_offset);
+        void          removeNodeFromBin(std::uint32_t node_index);
+
+        std::uint32_t m_size;
+        std::uint32_t m_free_storage;
+
+        std::uint32_t              m_used_bins_top;
+        std::uint8_t               m_used_bins[NUM_TOP_BINS];
+        std::uint32_t              m_bin_indices[NUM_LEAF_BINS];
+        std::vector<Node>          m_nodes;
+        std::vector<std::uint32_t> m_free_nodes;
+    };
+
+    /**
+     * \class BufferArena
+     *
+     * \brief Sub-allocates element ranges from a few large immutable buffer blocks.
+     *
+     * An arena manages one or more parallel streams (e.g. one per VertexLayout). Each block holds one
+     * ImmutableBufferObject per stream with space for block_element_cnt elements each. An allocation reserves the same
+     * element range in all streams of a block, so that a single first element (e.g. a base vertex) addresses the data
+     * in every stream. New blocks are added on demand.
+     *
+     * \author Michael Becher
+     */
+    class BufferArena
+    {
+    public:
+        struct Allocation
+        {
+            GLuint        block;
+            GLuint        first; ///< Index of the first element within the block
+            GLuint        count; ///< Element count
+            std::uint32_t node;  ///< Allocator internal handle
+        };
+
+        /**
+         * \brief BufferArena constructor.
+         *
+         * \param element_byte_sizes Byte size of a single element for each stream, e.g. the vertex layout strides
+         * \param block_element_cnt Number of elements per block
+         * \param flags Storage flags of the block buffers. Uploads via bufferSubData require GL_DYNAMIC_STORAGE_BIT.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        BufferArena(std::vector<GLsizeiptr> const& element_byte_sizes,
+                    GLuint                         block_element_cnt,
+                    GLbitfield                     flags = GL_DYNAMIC_STORAGE_BIT);
+
+        BufferArena(const BufferArena&) = delete;
+        BufferArena(BufferArena&&) noexcept = default;
+        BufferArena& operator=(BufferArena&&) noexcept = default;
+        BufferArena& operator=(const BufferArena&) = delete;
+
+        /**
+         * \brief Allocate element_cnt elements in any block. Adds a new block if no existing block has space left.
+         */
+        Allocation allocate(GLuint element_cnt);
+
+        /**
+         * \brief Allocate element_cnt elements in the given block, if possible.
+         */
+        std::optional<Allocation> allocate(GLuint element_cnt, GLuint block);
+
+        void free(Allocation const& allocation);
+
+        /**
+         * \brief Append a new, empty block and return its index.
+         */
+        GLuint addBlock();
+
+        /**
+         * \brief Upload data for the given stream into an allocation.
+         *
+         * \param element_offset Offset in elements relative to the start of the allocation
+         */
+        void bufferSubData(Allocation const& allocation,
+                           std::size_t       stream_idx,
+                           GLvoid const*     data,
+                           GLsizeiptr        byte_size,
+                           GLuint            element_offset = 0) const;
+
+        /**
+         * \brief Returns the byte offset of an allocation within its block buffer of the given stream.
+         */
+        GLintptr getByteOffset(Allocation const& allocation, std::size_t stream_idx) const;
+
+        ImmutableBufferObject const& getBuffer(GLuint block, std::size_t stream_idx) const;
+
+        GLuint getBlockCount() const;
+
+        GLuint getBlockElementCount() const;
+
+        std::size_t getStreamCount() const;
+
+        GLsizeiptr getElementByteSize(std::size_t stream_idx) const;
+
+        /**
+         * \brief Returns the number of elements currently allocated over all blocks.
+         */
+        std::size_t getAllocatedElementCount() const;
+
+    private:
+        struct Block
+        {
+            Block(GLuint element_cnt) : allocator(element_cnt) {}
+
+            OffsetAllocator                    allocator;
+            std::vector<ImmutableBufferObject> buffers;
+        };
+
+        std::vector<GLsizeiptr> m_element_byte_sizes;
+        GLuint                  m_block_element_cnt;
+        GLbitfield              m_flags;
+        std::vector<Block>      m_blocks;
+        std::size_t             m_allocated_element_cnt;
+    };
+
+    inline OffsetAllocator::OffsetAllocator(std::uint32_t size, std::uint32_t max_allocs)
+        : m_size(size),
+          m_free_storage(0),
+          m_used_bins_top(0),
+          m_used_bins(),
+          m_nodes(max_allocs),
+          m_free_nodes(max_allocs)
+    {
+        for (std::uint32_t i = 0; i < NUM_LEAF_BINS; ++i)
+        {
+            m_bin_indices[i] = UNUSED;
+        }
+
+        // free node indices are popped from the back, start with node 0
+        for (std::uint32_t i = 0; i < max_allocs; ++i)
+        {
+            m_free_nodes[i] = max_allocs - i - 1;
+        }
+
+        insertNodeIntoBin(m_size, 0);
+    }
+
+    inline OffsetAllocator::Allocation OffsetAllocator::allocate(std::uint32_t size)
+    {
+        // keep one node in reserve for splitting off the remainder
+        if (m_free_nodes.size() < 2 || size == 0)
+        {
+            return {};
+        }
+
+        // round up to the smallest bin that is guaranteed to fit the request
+        std::uint32_t min_bin_index = sizeToBinRoundUp(size);
+        std::uint32_t min_top_bin_index = min_bin_index >> TOP_BINS_INDEX_SHIFT;
+        std::uint32_t min_leaf_bin_index = min_bin_index & LEAF_BINS_INDEX_MASK;
+
+        std::uint32_t top_bin_index = min_top_bin_index;
+        std::uint32_t leaf_bin_index = NO_SPACE;
+
+        if (m_used_bins_top & (1u << top_bin_index))
+        {
+            leaf_bin_index = findLowestSetBitAfter(m_used_bins[top_bin_index], min_leaf_bin_index);
+        }
+
+        if (leaf_bin_index == NO_SPACE)
+        {
+            top_bin_index = findLowestSetBitAfter(m_used_bins_top, min_top_bin_index + 1);
+
+            if (top_bin_index != NO_SPACE)
+            {
+                // any leaf bin of a larger top bin fits
+                leaf_bin_index = tzcnt(m_used_bins[top_bin_index]);
+            }
+        }
+
+        if (top_bin_index == NO_SPACE || leaf_bin_index == NO_SPACE)
+        {
+            // no bin is guaranteed to fit, but nodes in the round down bin of the request may still be large enough
+            // (e.g. a fresh allocator whose size is not exactly representable by a bin)
+            std::uint32_t fallback_bin_index = sizeToBinRoundDown(size);
+            std::uint32_t fallback_node_index = m_bin_indices[fallback_bin_index];
+            if (fallback_node_index == UNUSED || m_nodes[fallback_node_index].data_size < size)
+            {
+                return {};
+            }
+
+            top_bin_index = fallback_bin_index >> TOP_BINS_INDEX_SHIFT;
+            leaf_bin_index = fallback_bin_index & LEAF_BINS_INDEX_MASK;
+        }
+
+        std::uint32_t bin_index = (top_bin_index << TOP_BINS_INDEX_SHIFT) | leaf_bin_index;
+
+        // pop the head node of the bin
+        std::uint32_t node_index = m_bin_indices[bin_index];
+        Node&         node = m_nodes[node_index];
+        std::uint32_t node_total_size = node.data_size;
+        node.data_size = size;
+        node.used = true;
+        m_bin_indices[bin_index] = node.bin_list_next;
+        if (node.bin_list_next != UNUSED)
+        {
+            m_nodes[node.bin_list_next].bin_list_prev = UNUSED;
+        }
+        m_free_storage -= node_total_size;
+
+        if (m_bin_indices[bin_index] == UNUSED)
+        {
+            m_used_bins[top_bin_index] &= ~(1u << leaf_bin_index);
+            if (m_used_bins[top_bin_index] == 0)
+            {
+                m_used_bins_top &= ~(1u << top_bin_index);
+            }
+        }
+
+        // return the remainder to the bins
+        std::uint32_t remainder_size = node_total_size - size;
+        if (remainder_size > 0)
+        {
+            std::uint32_t new_node_index = insertNodeIntoBin(remainder_size, m_nodes[node_index].data_offset + size);
+
+            if (m_nodes[node_index].neighbor_next != UNUSED)
+            {
+                m_nodes[m_nodes[node_index].neighbor_next].neighbor_prev = new_node_index;
+            }
+            m_nodes[new_node_index].neighbor_prev = node_index;
+            m_nodes[new_node_index].neighbor_next = m_nodes[node_index].neighbor_next;
+            m_nodes[node_index].neighbor_next = new_node_index;
+        }
+
+        return {m_nodes[node_index].data_offset, node_index};
+    }
+
+    inline void OffsetAllocator::free(Allocation allocation)
+    {
+        if (allocation.node == NO_SPACE || allocation.node >= m_nodes.size() || !m_nodes[allocation.node].used)
+        {
+            throw BufferObjectException("OffsetAllocator::free - invalid allocation");
+        }
+
+        std::uint32_t node_index = allocation.node;
+        std::uint32_t offset = m_nodes[node_index].data_offset;
+        std::uint32_t size = m_nodes[node_index].data_size;
+
+        // merge with free neighbours
+        std::uint32_t prev = m_nodes[node_index].neighbor_prev;
+        if (prev != UNUSED && !m_nodes[prev].used)
+        {
+            offset = m_nodes[prev].data_offset;
+            size += m_nodes[prev].data_size;
+            m_nodes[node_index].neighbor_prev = m_nodes[prev].neighbor_prev;
+
+            removeNodeFromBin(prev);
+        }
+
+        std::uint32_t next = m_nodes[node_index].neighbor_next;
+        if (next != UNUSED && !m_nodes[next].used)
+        {
+            size += m_nodes[next].data_size;
+            m_nodes[node_index].neighbor_next = m_nodes[next].neighbor_next;
+
+            removeNodeFromBin(next);
+        }
+
+        std::uint32_t neighbor_prev = m_nodes[node_index].neighbor_prev;
+        std::uint32_t neighbor_next = m_nodes[node_index].neighbor_next;
+
+        // release the node itself and insert the merged range as a new node
+        m_nodes[node_index] = Node();
+        m_free_nodes.push_back(node_index);
+
+        std::uint32_t merged_node_index = insertNodeIntoBin(size, offset);
+
+        m_nodes[merged_node_index].neighbor_prev = neighbor_prev;
+        m_nodes[merged_node_index].neighbor_next = neighbor_next;
+        if (neighbor_prev != UNUSED)
+        {
+            m_nodes[neighbor_prev].neighbor_next = merged_node_index;
+        }
+        if (neighbor_next != UNUSED)
+        {
+            m_nodes[neighbor_next].neighbor_prev = merged_node_index;
+        }
+    }
+
+    inline std::uint32_t OffsetAllocator::getAllocationSize(Allocation allocation) const
+    {
+        if (allocation.node == NO_SPACE || allocation.node >= m_nodes.size())
+        {
+            return 0;
+        }
+        return m_nodes[allocation.node].data_size;
+    }
+
+    inline std::uint32_t OffsetAllocator::getSize() const
+    {
+        return m_size;
+    }
+
+    inline std::uint32_t OffsetAllocator::getFreeSize() const
+    {
+        return m_free_storage;
+    }
+
+    inline std::uint32_t OffsetAllocator::lzcnt(std::uint32_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long retval;
+        return _BitScanReverse(&retval, v) ? 31 - retval : 32;
+#else
+        return v == 0 ? 32 : __builtin_clz(v);
+#endif
+    }
+
+    inline std::uint32_t OffsetAllocator::tzcnt(std::uint32_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long retval;
+        return _BitScanForward(&retval, v) ? retval : 32;
+#else
+        return v == 0 ? 32 : __builtin_ctz(v);
+#endif
+    }
+
+    inline std::uint32_t OffsetAllocator::findLowestSetBitAfter(std::uint32_t mask, std::uint32_t start_bit_index)
+    {
+        if (start_bit_index >= 32)
+        {
+            return NO_SPACE;
+        }
+
+        std::uint32_t mask_after_start_index = mask & ~((1u << start_bit_index) - 1);
+        if (mask_after_start_index == 0)
+        {
+            return NO_SPACE;
+        }
+        return tzcnt(mask_after_start_index);
+    }
+
+    inline std::uint32_t OffsetAllocator::sizeToBinRoundUp(std::uint32_t size)
+    {
+        std::uint32_t exp = 0;
+        std::uint32_t mantissa = 0;
+
+        if (size < MANTISSA_VALUE)
+        {
+            // denorm: 0..(MANTISSA_VALUE-1)
+            mantissa = size;
+        }
+        else
+        {
+            // normalized: hidden high bit always 1, not stored
+            std::uint32_t highest_set_bit = 31 - lzcnt(size);
+            std::uint32_t mantissa_start_bit = highest_set_bit - MANTISSA_BITS;
+            exp = mantissa_start_bit + 1;
+            mantissa = (size >> mantissa_start_bit) & MANTISSA_MASK;
+
+            std::uint32_t low_bits_mask = (1u << mantissa_start_bit) - 1;
+
+            // round up
+            if ((size & low_bits_mask) != 0)
+            {
+                ++mantissa;
+            }
+        }
+
+        // mantissa overflow carries into the exponent
+        return (exp << MANTISSA_BITS) + mantissa;
+    }
+
+    inline std::uint32_t OffsetAllocator::sizeToBinRoundDown(std::uint32_t size)
+    {
+        std::uint32_t exp = 0;
+        std::uint32_t mantissa = 0;
+
+        if (size < MANTISSA_VALUE)
+        {
+            mantissa = size;
+        }
+        else
+        {
+            std::uint32_t highest_set_bit = 31 - lzcnt(size);
+            std::uint32_t mantissa_start_bit = highest_set_bit - MANTISSA_BITS;
+            exp = mantissa_start_bit + 1;
+            mantissa = (size >> mantissa_start_bit) & MANTISSA_MASK;
+        }
+
+        return (exp << MANTISSA_BITS) | mantissa;
+    }
+
+    inline std::uint32_t OffsetAllocator::insertNodeIntoBin(std::uint32_t size, std::uint32_t data_offset)
+    {
+        // round down: every node in a bin is at least as large as the bin size
+        std::uint32_t bin_index = sizeToBinRoundDown(size);
+        std::uint32_t top_bin_index = bin_index >> TOP_BINS_INDEX_SHIFT;
+        std::uint32_t leaf_bin_index = bin_index & LEAF_BINS_INDEX_MASK;
+
+        if (m_bin_indices[bin_index] == UNUSED)
+        {
+            m_used_bins[top_bin_index] |= static_cast<std::uint8_t>(1u << leaf_bin_index);
+            m_used_bins_top |= 1u << top_bin_index;
+        }
+
+        std::uint32_t top_node_index = m_bin_indices[bin_index];
+        std::uint32_t node_index = m_free_nodes.back();
+        m_free_nodes.pop_back();
+
+        m_nodes[node_index] = Node();
+        m_nodes[node_index].data_offset = data_offset;
+        m_nodes[node_index].data_size = size;
+        m_nodes[node_index].bin_list_next = top_node_index;
+        if (top_node_index != UNUSED)
+        {
+            m_nodes[top_node_index].bin_list_prev = node_index;
+        }
+        m_bin_indices[bin_index] = node_index;
+
+        m_free_storage += size;
+
+        return node_index;
+    }
+
+    inline void OffsetAllocator::removeNodeFromBin(std::uint32_t node_index)
+    {
+        Node& node = m_nodes[node_index];
+
+        if (node.bin_list_prev != UNUSED)
+        {
+            // easy case: not the head of the bin list
+            m_nodes[node.bin_list_prev].bin_list_next = node.bin_list_next;
+            if (node.bin_list_next != UNUSED)
+            {
+                m_nodes[node.bin_list_next].bin_list_prev = node.bin_list_prev;
+            }
+        }
+        else
+        {
+            // head of the bin list, update the bin and possibly the bitmasks
+            std::uint32_t bin_index = sizeToBinRoundDown(node.data_size);
+            std::uint32_t top_bin_index = bin_index >> TOP_BINS_INDEX_SHIFT;
+            std::uint32_t leaf_bin_index = bin_index & LEAF_BINS_INDEX_MASK;
+
+            m_bin_indices[bin_index] = node.bin_list_next;
+            if (node.bin_list_next != UNUSED)
+            {
+                m_nodes[node.bin_list_next].bin_list_prev = UNUSED;
+            }
+
+            if (m_bin_indices[bin_index] == UNUSED)
+            {
+                m_used_bins[top_bin_index] &= ~(1u << leaf_bin_index);
+                if (m_used_bins[top_bin_index] == 0)
+                {
+                    m_used_bins_top &= ~(1u << top_bin_index);
+                }
+            }
+        }
+
+        m_free_storage -= node.data_size;
+
+        m_nodes[node_index] = Node();
+        m_free_nodes.push_back(node_index);
+    }
+
+    inline BufferArena::BufferArena(std::vector<GLsizeiptr> const& element_byte_sizes,
+                                    GLuint                         block_element_cnt,
+                                    GLbitfield                     flags)
+        : m_element_byte_sizes(element_byte_sizes),
+          m_block_element_cnt(block_element_cnt),
+          m_flags(flags),
+          m_blocks(),
+          m_allocated_element_cnt(0)
+    {
+        if (m_element_byte_sizes.empty() || m_block_element_cnt == 0)
+        {
+            throw BufferObjectException("BufferArena::BufferArena - arena requires at least one stream and element");
+        }
+
+        addBlock();
+    }
+
+    inline BufferArena::Allocation BufferArena::allocate(GLuint element_cnt)
+    {
+        if (element_cnt == 0 || element_cnt > m_block_element_cnt)
+        {
+            throw BufferObjectException("BufferArena::allocate - requested " + std::to_string(element_cnt) +
+                                        " elements exceed block size of " + std::to_string(m_block_element_cnt));
+        }
+
+        for (GLuint block = 0; block < m_blocks.size(); ++block)
+        {
+            auto allocation = allocate(element_cnt, block);
+            if (allocation.has_value())
+            {
+                return allocation.value();
+            }
+        }
+
+        auto allocation = allocate(element_cnt, addBlock());
+        if (!allocation.has_value())
+        {
+            throw BufferObjectException("BufferArena::allocate - failed to allocate " + std::to_string(element_cnt) +
+                                        " elements in a new block");
+        }
+
+        return allocation.value();
+    }
+
+    inline std::optional<BufferArena::Allocation> BufferArena::allocate(GLuint element_cnt, GLuint block)
+    {
+        if (block >= m_blocks.size())
+        {
+            throw BufferObjectException("BufferArena::allocate - block index out of range");
+        }
+
+        auto allocation = m_blocks[block].allocator.allocate(element_cnt);
+        if (allocation.offset == OffsetAllocator::NO_SPACE)
+        {
+            return std::nullopt;
+        }
+
+        m_allocated_element_cnt += element_cnt;
+
+        return Allocation{block, allocation.offset, element_cnt, allocation.node};
+    }
+
+    inline void BufferArena::free(Allocation const& allocation)
+    {
+        if (allocation.block >= m_blocks.size())
+        {
+            throw BufferObjectException("BufferArena::free - block index out of range");
+        }
+
+        m_blocks[allocation.block].allocator.free({allocation.first, allocation.node});
+        m_allocated_element_cnt -= allocation.count;
+    }
+
+    inline GLuint BufferArena::addBlock()
+    {
+        Block block(m_block_element_cnt);
+
+        for (auto element_byte_size : m_element_byte_sizes)
+        {
+            GLsizeiptr byte_size = element_byte_size * static_cast<GLsizeiptr>(m_block_element_cnt);
+            block.buffers.emplace_back(nullptr, byte_size, m_flags);
+        }
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException("BufferArena::addBlock - OpenGL error " + std::to_string(err));
+        }
+
+        m_blocks.emplace_back(std::move(block));
+
+        return static_cast<GLuint>(m_blocks.size() - 1);
+    }
+
+    inline void BufferArena::bufferSubData(Allocation const& allocation,
+                                           std::size_t       stream_idx,
+                                           GLvoid const*     data,
+                                           GLsizeiptr        byte_size,
+                                           GLuint            element_offset) const
+    {
+        GLsizeiptr element_byte_size = getElementByteSize(stream_idx);
+
+        if ((static_cast<GLsizeiptr>(element_offset) * element_byte_size + byte_size) >
+            static_cast<GLsizeiptr>(allocation.count) * element_byte_size)
+        {
+            throw BufferObjectException("BufferArena::bufferSubData - given data too large for allocation");
+        }
+
+        glNamedBufferSubData(getBuffer(allocation.block, stream_idx).getName(),
+                             getByteOffset(allocation, stream_idx) + element_offset * element_byte_size,
+                             byte_size,
+                             data);
+    }
+
+    inline GLintptr BufferArena::getByteOffset(Allocation const& allocation, std::size_t stream_idx) const
+    {
+        return static_cast<GLintptr>(allocation.first) * getElementByteSize(stream_idx);
+    }
+
+    inline ImmutableBufferObject const& BufferArena::getBuffer(GLuint block, std::size_t stream_idx) const
+    {
+        if (block >= m_blocks.size() || stream_idx >= m_element_byte_sizes.size())
+        {
+            throw BufferObjectException("BufferArena::getBuffer - index out of range");
+        }
+        return m_blocks[block].buffers[stream_idx];
+    }
+
+    inline GLuint BufferArena::getBlockCount() const
+    {
+        return static_cast<GLuint>(m_blocks.size());
+    }
+
+    inline GLuint BufferArena::getBlockElementCount() const
+    {
+        return m_block_element_cnt;
+    }
+
+    inline std::size_t BufferArena::getStreamCount() const
+    {
+        return m_element_byte_sizes.size();
+    }
+
+    inline GLsizeiptr BufferArena::getElementByteSize(std::size_t stream_idx) const
+    {
+        if (stream_idx >= m_element_byte_sizes.size())
+        {
+            throw BufferObjectException("BufferArena::getElementByteSize - stream index out of range");
+        }
+        return m_element_byte_sizes[stream_idx];
+    }
+
+    inline std::size_t BufferArena::getAllocatedElementCount() const
+    {
+        return m_allocated_element_cnt;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_BUFFERARENA_HPP
@@ -0,0 +1,733 @@
+/*
+ * BufferKernels.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_BUFFERKERNELS_HPP
+#define GLOWL_BUFFERKERNELS_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "GLSLProgram.hpp"
+#include "ImmutableBufferObject.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    enum class ReduceOp
+    {
+        Sum,
+        Min,
+        Max
+    };
+
+    /**
+     * \struct BufferRange
+     *
+     * \brief Start of a range of elements within a buffer, used as kernel argument.
+     * The byte offset has to be a multiple of the element size.
+     */
+    struct BufferRange
+    {
+        BufferRange(GLuint buffer, GLintptr byte_offset = 0) : buffer(buffer), byte_offset(byte_offset) {}
+
+        BufferRange(BufferObject const& buffer, GLintptr byte_offset = 0)
+            : buffer(buffer.getName()),
+              byte_offset(byte_offset)
+        {
+        }
+
+        BufferRange(ImmutableBufferObject const& buffer, GLintptr byte_offset = 0)
+            : buffer(buffer.getName()),
+              byte_offset(byte_offset)
+        {
+        }
+
+        GLuint   buffer;
+        GLintptr byte_offset;
+    };
+
+    /**
+     * \class BufferKernels
+     *
+     * \brief Compute shader kernels for common operations on buffer contents: fill, iota, exclusive and inclusive
+     * prefix sum, reduction and stream compaction.
+     *
+     * All kernels operate on 32bit element types (GLuint, GLint, GLfloat) and keep the data on the GPU. The prefix
+     * sum is a work-efficient (Blelloch) scan per work group, with recursively scanned block sums. Programs are
+     * compiled on first use and cached. Each dispatch is followed by a GL_SHADER_STORAGE_BARRIER_BIT memory barrier,
+     * other barriers (e.g. GL_COMMAND_BARRIER_BIT before using results as indirect draw commands) are left to the
+     * caller. Results can be checked against the CPU implementations in glowl::reference.
+     *
+     * Note that the currently bound program and shader storage buffer bindings 0 to 3 are changed.
+     *
+     * \author Michael Becher
+     */
+    class BufferKernels
+    {
+    public:
+        /**
+         * \brief BufferKernels constructor.
+         *
+         * \param workgroup_size Number of invocations per work group, has to be a power of two.
+         * Scans process two elements per invocation.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        explicit BufferKernels(GLuint workgroup_size = 256);
+
+        BufferKernels(const BufferKernels&) = delete;
+        BufferKernels(BufferKernels&&) = default;
+        BufferKernels& operator=(BufferKernels&&) = default;
+        BufferKernels& operator=(const BufferKernels&) = delete;
+
+        /**
+         * \brief Set count elements to value. Uses glClearNamedBufferSubData, no kernel required.
+         */
+        template<typename T>
+        void fill(BufferRange dst, GLuint count, T value);
+
+        /**
+         * \brief Set element i to start + i * step.
+         */
+        template<typename T>
+        void iota(BufferRange dst, GLuint count, T start = T(0), T step = T(1));
+
+        /**
+         * \brief Exclusive prefix sum. Source and destination may be identical.
+         */
+        template<typename T>
+        void exclusiveScan(BufferRange src, BufferRange dst, GLuint count);
+
+        /**
+         * \brief Inclusive prefix sum. Source and destination may be identical.
+         */
+        template<typename T>
+        void inclusiveScan(BufferRange src, BufferRange dst, GLuint count);
+
+        /**
+         * \brief Reduce count elements to a single element that is written to dst.
+         */
+        template<typename T>
+        void reduce(ReduceOp op, BufferRange src, GLuint count, BufferRange dst);
+
+        /**
+         * \brief Copy all elements for which the predicate holds to dst, keeping their order.
+         *
+         * \param predicate GLSL boolean expression of the element named value, e.g. "value > 0.5"
+         * \param count_dst Receives the number of copied elements as GLuint
+         */
+        template<typename T>
+        void compact(BufferRange        src,
+                     GLuint             count,
+                     std::string const& predicate,
+                     BufferRange        dst,
+                     BufferRange        count_dst);
+
+        GLuint getWorkgroupSize() const;
+
+        /**
+         * \brief Returns the number of compiled and cached programs.
+         */
+        std::size_t getProgramCount() const;
+
+    private:
+        template<typename T>
+        struct ElementType;
+
+        GLSLProgram& getProgram(std::string const& key, std::function<std::string()> const& body);
+
+        std::string header(char const* element_type) const;
+
+        void dispatch(GLuint group_cnt) const;
+
+        BufferObject& getScratchBuffer(std::size_t idx, GLsizeiptr byte_size);
+
+        template<typename T>
+        void scan(BufferRange src, BufferRange dst, GLuint count, bool inclusive, std::size_t level);
+
+        void checkError(char const* function) const;
+
+        template<typename T>
+        static GLuint elementOffset(BufferRange const& range);
+
+        GLuint                             m_workgroup_size;
+        std::map<std::string, GLSLProgram> m_programs;
+        std::vector<BufferObject>          m_scratch_buffers;
+    };
+
+    template<>
+    struct BufferKernels::ElementType<GLuint>
+    {
+        static constexpr char const* glsl = "uint";
+        static constexpr GLenum      internal_format = GL_R32UI;
+        static constexpr GLenum      format = GL_RED_INTEGER;
+        static constexpr GLenum      type = GL_UNSIGNED_INT;
+        static constexpr char const* min_identity = "0xFFFFFFFFu";
+        static constexpr char const* max_identity = "0u";
+    };
+
+    template<>
+    struct BufferKernels::ElementType<GLint>
+    {
+        static constexpr char const* glsl = "int";
+        static constexpr GLenum      internal_format = GL_R32I;
+        static constexpr GLenum      format = GL_RED_INTEGER;
+        static constexpr GLenum      type = GL_INT;
+        static constexpr char const* min_identity = "0x7FFFFFFF";
+        static constexpr char const* max_identity = "(-0x7FFFFFFF - 1)";
+    };
+
+    template<>
+    struct BufferKernels::ElementType<GLfloat>
+    {
+        static constexpr char const* glsl = "float";
+        static constexpr GLenum      internal_format = GL_R32F;
+        static constexpr GLenum      format = GL_RED;
+        static constexpr GLenum      type = GL_FLOAT;
+        static constexpr char const* min_identity = "uintBitsToFloat(0x7F800000u)";
+        static constexpr char const* max_identity = "uintBitsToFloat(0xFF800000u)";
+    };
+
+    namespace reference
+    {
+        /**
+         * CPU reference implementations of the BufferKernels operations.
+         */
+
+        template<typename T>
+        std::vector<T> iota(std::size_t count, T start = T(0), T step = T(1))
+        {
+            std::vector<T> retval(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                retval[i] = start + static_cast<T>(i) * step;
+            }
+            return retval;
+        }
+
+        template<typename T>
+        std::vector<T> exclusiveScan(std::vector<T> const& input)
+        {
+            std::vector<T> retval(input.size());
+            T              sum = T(0);
+            for (std::size_t i = 0; i < input.size(); ++i)
+            {
+                retval[i] = sum;
+                sum += input[i];
+            }
+            return retval;
+        }
+
+        template<typename T>
+        std::vector<T> inclusiveScan(std::vector<T> const& input)
+        {
+            std::vector<T> retval(input.size());
+            T              sum = T(0);
+            for (std::size_t i = 0; i < input.size(); ++i)
+            {
+                sum += input[i];
+                retval[i] = sum;
+            }
+            return retval;
+        }
+
+        template<typename T>
+        T reduce(ReduceOp op, std::vector<T> const& input)
+        {
+            switch (op)
+            {
+            case ReduceOp::Min:
+                return input.empty() ? std::numeric_limits<T>::max() : *std::min_element(input.begin(), input.end());
+            case ReduceOp::Max:
+                return input.empty() ? std::numeric_limits<T>::lowest()
+                                     : *std::max_element(input.begin(), input.end());
+            case ReduceOp::Sum:
+            default:
+                break;
+            }
+
+            T sum = T(0);
+            for (auto const& value : input)
+            {
+                sum += value;
+            }
+            return sum;
+        }
+
+        template<typename T, typename Predicate>
+        std::vector<T> compact(std::vector<T> const& input, Predicate predicate)
+        {
+            std::vector<T> retval;
+            for (auto const& value : input)
+            {
+                if (predicate(value))
+                {
+                    retval.push_back(value);
+                }
+            }
+            return retval;
+        }
+    } // namespace reference
+
+    inline BufferKernels::BufferKernels(GLuint workgroup_size)
+        : m_workgroup_size(workgroup_size),
+          m_programs(),
+          m_scratch_buffers()
+    {
+        if (workgroup_size == 0 || (workgroup_size & (workgroup_size - 1)) != 0)
+        {
+            throw BufferObjectException("BufferKernels::BufferKernels - work group size has to be a power of two");
+        }
+    }
+
+    template<typename T>
+    inline void BufferKernels::fill(BufferRange dst, GLuint count, T value)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        glClearNamedBufferSubData(dst.buffer,
+                                  ElementType<T>::internal_format,
+                                  dst.byte_offset,
+                                  static_cast<GLsizeiptr>(count) * sizeof(T),
+                                  ElementType<T>::format,
+                                  ElementType<T>::type,
+                                  &value);
+
+        checkError("BufferKernels::fill");
+    }
+
+    template<typename T>
+    inline void BufferKernels::iota(BufferRange dst, GLuint count, T start, T step)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::string key = std::string("iota_") + ElementType<T>::glsl;
+        auto&       program = getProgram(key, [this]() {
+            return header(ElementType<T>::glsl) +
+                   "layout(std430, binding = 0) writeonly buffer Dst { TYPE dst_data[]; };\n"
+                   "uniform uint u_dst_offset;\n"
+                   "uniform uint u_count;\n"
+                   "uniform TYPE u_start;\n"
+                   "uniform TYPE u_step;\n"
+                   "void main() {\n"
+                   "    uint i = groupIndex() * WG + gl_LocalInvocationID.x;\n"
+                   "    if (i < u_count) { dst_data[u_dst_offset + i] = u_start + TYPE(i) * u_step; }\n"
+                   "}\n";
+        });
+
+        program.use();
+        program.setUniform("u_dst_offset", elementOffset<T>(dst));
+        program.setUniform("u_count", count);
+        program.setUniform("u_start", start);
+        program.setUniform("u_step", step);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, dst.buffer);
+
+        dispatch((count + m_workgroup_size - 1) / m_workgroup_size);
+
+        checkError("BufferKernels::iota");
+    }
+
+    template<typename T>
+    inline void BufferKernels::exclusiveScan(BufferRange src, BufferRange dst, GLuint count)
+    {
+        scan<T>(src, dst, count, false, 0);
+        checkError("BufferKernels::exclusiveScan");
+    }
+
+    template<typename T>
+    inline void BufferKernels::inclusiveScan(BufferRange src, BufferRange dst, GLuint count)
+    {
+        scan<T>(src, dst, count, true, 0);
+        checkError("BufferKernels::inclusiveScan");
+    }
+
+    template<typename T>
+    inline void BufferKernels::reduce(ReduceOp op, BufferRange src, GLuint count, BufferRange dst)
+    {
+        char const* op_name = op == ReduceOp::Sum ? "sum" : (op == ReduceOp::Min ? "min" : "max");
+        std::string key = std::string("reduce_") + op_name + "_" + ElementType<T>::glsl;
+        auto&       program = getProgram(key, [this, op]() {
+            std::string identity = "TYPE(0)";
+            std::string op_expr = "(a + b)";
+            if (op == ReduceOp::Min)
+            {
+                identity = ElementType<T>::min_identity;
+                op_expr = "min(a, b)";
+            }
+            else if (op == ReduceOp::Max)
+            {
+                identity = ElementType<T>::max_identity;
+                op_expr = "max(a, b)";
+            }
+
+            return header(ElementType<T>::glsl) + "#define IDENTITY " + identity + "\n#define OP(a, b) " + op_expr +
+                   "\n"
+                   "layout(std430, binding = 0) readonly buffer Src { TYPE src_data[]; };\n"
+                   "layout(std430, binding = 1) writeonly buffer Dst { TYPE dst_data[]; };\n"
+                   "uniform uint u_src_offset;\n"
+                   "uniform uint u_dst_offset;\n"
+                   "uniform uint u_count;\n"
+                   "shared TYPE s_data[WG];\n"
+                   "void main() {\n"
+                   "    uint lid = gl_LocalInvocationID.x;\n"
+                   "    uint base = groupIndex() * 2u * WG;\n"
+                   "    uint i = base + lid;\n"
+                   "    TYPE v = IDENTITY;\n"
+                   "    if (i < u_count) { v = src_data[u_src_offset + i]; }\n"
+                   "    if (i + WG < u_count) { v = OP(v, src_data[u_src_offset + i + WG]); }\n"
+                   "    s_data[lid] = v;\n"
+                   "    memoryBarrierShared();\n"
+                   "    barrier();\n"
+                   "    for (uint s = WG / 2u; s > 0u; s >>= 1u) {\n"
+                   "        if (lid < s) { s_data[lid] = OP(s_data[lid], s_data[lid + s]); }\n"
+                   "        memoryBarrierShared();\n"
+                   "        barrier();\n"
+                   "    }\n"
+                   "    if (lid == 0u && base < u_count) { dst_data[u_dst_offset + groupIndex()] = s_data[0]; }\n"
+                   "}\n";
+        });
+
+        if (count == 0)
+        {
+            throw BufferObjectException("BufferKernels::reduce - empty input");
+        }
+
+        program.use();
+
+        // each pass reduces 2 * workgroup size elements per group, ping-pong between two scratch buffers
+        GLuint      elements_per_group = 2 * m_workgroup_size;
+        BufferRange pass_src = src;
+        std::size_t scratch_idx = 0;
+        while (true)
+        {
+            GLuint      group_cnt = (count + elements_per_group - 1) / elements_per_group;
+            BufferRange pass_dst = dst;
+            if (group_cnt > 1)
+            {
+                pass_dst = BufferRange(getScratchBuffer(scratch_idx, group_cnt * sizeof(T)));
+            }
+
+            program.setUniform("u_src_offset", elementOffset<T>(pass_src));
+            program.setUniform("u_dst_offset", elementOffset<T>(pass_dst));
+            program.setUniform("u_count", count);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, pass_src.buffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, pass_dst.buffer);
+
+            dispatch(group_cnt);
+
+            if (group_cnt == 1)
+            {
+                break;
+            }
+
+            pass_src = pass_dst;
+            count = group_cnt;
+            scratch_idx = 1 - scratch_idx;
+        }
+
+        checkError("BufferKernels::reduce");
+    }
+
+    template<typename T>
+    inline void BufferKernels::compact(BufferRange        src,
+                                       GLuint             count,
+                                       std::string const& predicate,
+                                       BufferRange        dst,
+                                       BufferRange        count_dst)
+    {
+        if (count == 0)
+        {
+            fill<GLuint>(count_dst, 1, 0);
+            return;
+        }
+
+        std::string predicate_function = std::string("bool predicate(") + ElementType<T>::glsl +
+                                         " value) { return " + predicate + "; }\n";
+
+        auto& flag_program =
+            getProgram(std::string("compact_flags_") + ElementType<T>::glsl + "_" + predicate, [&]() {
+                return header(ElementType<T>::glsl) + predicate_function +
+                       "layout(std430, binding = 0) readonly buffer Src { TYPE src_data[]; };\n"
+                       "layout(std430, binding = 1) writeonly buffer Flags { uint flags[]; };\n"
+                       "uniform uint u_src_offset;\n"
+                       "uniform uint u_count;\n"
+                       "void main() {\n"
+                       "    uint i = groupIndex() * WG + gl_LocalInvocationID.x;\n"
+                       "    if (i < u_count) { flags[i] = predicate(src_data[u_src_offset + i]) ? 1u : 0u; }\n"
+                       "}\n";
+            });
+
+        auto& scatter_program =
+            getProgram(std::string("compact_scatter_") + ElementType<T>::glsl + "_" + predicate, [&]() {
+                return header(ElementType<T>::glsl) + predicate_function +
+                       "layout(std430, binding = 0) readonly buffer Src { TYPE src_data[]; };\n"
+                       "layout(std430, binding = 1) writeonly buffer Dst { TYPE dst_data[]; };\n"
+                       "layout(std430, binding = 2) readonly buffer Indices { uint indices[]; };\n"
+                       "layout(std430, binding = 3) writeonly buffer Count { uint count_data[]; };\n"
+                       "uniform uint u_src_offset;\n"
+                       "uniform uint u_dst_offset;\n"
+                       "uniform uint u_count_offset;\n"
+                       "uniform uint u_count;\n"
+                       "void main() {\n"
+                       "    uint i = groupIndex() * WG + gl_LocalInvocationID.x;\n"
+                       "    if (i >= u_count) { return; }\n"
+                       "    TYPE value = src_data[u_src_offset + i];\n"
+                       "    bool selected = predicate(value);\n"
+                       "    if (selected) { dst_data[u_dst_offset + indices[i]] = value; }\n"
+                       "    if (i == u_count - 1u) {\n"
+                       "        count_data[u_count_offset] = indices[i] + (selected ? 1u : 0u);\n"
+                       "    }\n"
+                       "}\n";
+            });
+
+        GLuint group_cnt = (count + m_workgroup_size - 1) / m_workgroup_size;
+
+        // the flag buffer is scanned in place, so it is taken from the end of the scratch buffers used by scan
+        BufferObject& flags = getScratchBuffer(0, static_cast<GLsizeiptr>(count) * sizeof(GLuint));
+        GLuint        flags_name = flags.getName();
+
+        flag_program.use();
+        flag_program.setUniform("u_src_offset", elementOffset<T>(src));
+        flag_program.setUniform("u_count", count);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, src.buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, flags_name);
+        dispatch(group_cnt);
+
+        scan<GLuint>(BufferRange(flags_name), BufferRange(flags_name), count, false, 1);
+
+        scatter_program.use();
+        scatter_program.setUniform("u_src_offset", elementOffset<T>(src));
+        scatter_program.setUniform("u_dst_offset", elementOffset<T>(dst));
+        scatter_program.setUniform("u_count_offset", elementOffset<GLuint>(count_dst));
+        scatter_program.setUniform("u_count", count);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, src.buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, dst.buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, flags_name);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, count_dst.buffer);
+        dispatch(group_cnt);
+
+        checkError("BufferKernels::compact");
+    }
+
+    inline GLuint BufferKernels::getWorkgroupSize() const
+    {
+        return m_workgroup_size;
+    }
+
+    inline std::size_t BufferKernels::getProgramCount() const
+    {
+        return m_programs.size();
+    }
+
+    inline GLSLProgram& BufferKernels::getProgram(std::string const& key, std::function<std::string()> const& body)
+    {
+        auto it = m_programs.find(key);
+        if (it == m_programs.end())
+        {
+            it = m_programs.emplace(key, GLSLProgram({{GLSLProgram::ShaderType::Compute, body()}})).first;
+        }
+        return it->second;
+    }
+
+    inline std::string BufferKernels::header(char const* element_type) const
+    {
+        std::string wg = std::to_string(m_workgroup_size);
+        return "#version 430\n"
+               "#define TYPE " +
+               std::string(element_type) + "\n#define WG " + wg + "u\nlayout(local_size_x = " + wg +
+               ") in;\n"
+               "uint groupIndex() { return gl_WorkGroupID.x + gl_WorkGroupID.y * gl_NumWorkGroups.x; }\n";
+    }
+
+    inline void BufferKernels::dispatch(GLuint group_cnt) const
+    {
+        // stay within the guaranteed minimum of 65535 work groups per dimension
+        GLuint group_cnt_x = std::min(group_cnt, 65535u);
+        GLuint group_cnt_y = (group_cnt + group_cnt_x - 1) / group_cnt_x;
+
+        glDispatchCompute(group_cnt_x, group_cnt_y, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    inline BufferObject& BufferKernels::getScratchBuffer(std::size_t idx, GLsizeiptr byte_size)
+    {
+        while (m_scratch_buffers.size() <= idx)
+        {
+            m_scratch_buffers.emplace_back(GL_SHADER_STORAGE_BUFFER,
+                                           static_cast<GLvoid const*>(nullptr),
+                                           0,
+                                           GL_DYNAMIC_COPY);
+        }
+
+        // content is not needed, so grow via rebuffer which keeps the name if the capacity suffices
+        BufferObject& buffer = m_scratch_buffers[idx];
+        if (buffer.getByteSize() < byte_size)
+        {
+            buffer.rebuffer(nullptr, byte_size);
+        }
+        return buffer;
+    }
+
+    template<typename T>
+    inline void BufferKernels::scan(BufferRange src, BufferRange dst, GLuint count, bool inclusive, std::size_t level)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::string key = std::string("scan_") + ElementType<T>::glsl;
+        auto&       scan_program = getProgram(key, [this]() {
+            return header(ElementType<T>::glsl) +
+                   "layout(std430, binding = 0) readonly buffer Src { TYPE src_data[]; };\n"
+                   "layout(std430, binding = 1) writeonly buffer Dst { TYPE dst_data[]; };\n"
+                   "layout(std430, binding = 2) writeonly buffer Sums { TYPE block_sums[]; };\n"
+                   "uniform uint u_src_offset;\n"
+                   "uniform uint u_dst_offset;\n"
+                   "uniform uint u_count;\n"
+                   "uniform uint u_inclusive;\n"
+                   "uniform uint u_write_sums;\n"
+                   "shared TYPE s_data[2u * WG];\n"
+                   "void main() {\n"
+                   "    uint lid = gl_LocalInvocationID.x;\n"
+                   "    uint base = groupIndex() * 2u * WG;\n"
+                   "    uint ai = lid;\n"
+                   "    uint bi = lid + WG;\n"
+                   "    TYPE a = (base + ai < u_count) ? src_data[u_src_offset + base + ai] : TYPE(0);\n"
+                   "    TYPE b = (base + bi < u_count) ? src_data[u_src_offset + base + bi] : TYPE(0);\n"
+                   "    s_data[ai] = a;\n"
+                   "    s_data[bi] = b;\n"
+                   "    uint offset = 1u;\n"
+                   "    for (uint d = WG; d > 0u; d >>= 1u) {\n" // up-sweep
+                   "        memoryBarrierShared();\n"
+                   "        barrier();\n"
+                   "        if (lid < d) {\n"
+                   "            uint i = offset * (2u * lid + 1u) - 1u;\n"
+                   "            uint j = offset * (2u * lid + 2u) - 1u;\n"
+                   "            s_data[j] += s_data[i];\n"
+                   "        }\n"
+                   "        offset <<= 1u;\n"
+                   "    }\n"
+                   "    memoryBarrierShared();\n"
+                   "    barrier();\n"
+                   "    if (lid == 0u) {\n"
+                   "        if (u_write_sums != 0u && base < u_count) {\n"
+                   "            block_sums[groupIndex()] = s_data[2u * WG - 1u];\n"
+                   "        }\n"
+                   "        s_data[2u * WG - 1u] = TYPE(0);\n"
+                   "    }\n"
+                   "    for (uint d = 1u; d <= WG; d <<= 1u) {\n" // down-sweep
+                   "        offset >>= 1u;\n"
+                   "        memoryBarrierShared();\n"
+                   "        barrier();\n"
+                   "        if (lid < d) {\n"
+                   "            uint i = offset * (2u * lid + 1u) - 1u;\n"
+                   "            uint j = offset * (2u * lid + 2u) - 1u;\n"
+                   "            TYPE t = s_data[i];\n"
+                   "            s_data[i] = s_data[j];\n"
+                   "            s_data[j] += t;\n"
+                   "        }\n"
+                   "    }\n"
+                   "    memoryBarrierShared();\n"
+                   "    barrier();\n"
+                   "    TYPE inc_a = u_inclusive != 0u ? a : TYPE(0);\n"
+                   "    TYPE inc_b = u_inclusive != 0u ? b : TYPE(0);\n"
+                   "    if (base + ai < u_count) { dst_data[u_dst_offset + base + ai] = s_data[ai] + inc_a; }\n"
+                   "    if (base + bi < u_count) { dst_data[u_dst_offset + base + bi] = s_data[bi] + inc_b; }\n"
+                   "}\n";
+        });
+
+        auto& add_program = getProgram(key + "_add", [this]() {
+            return header(ElementType<T>::glsl) +
+                   "layout(std430, binding = 1) buffer Dst { TYPE dst_data[]; };\n"
+                   "layout(std430, binding = 2) readonly buffer Sums { TYPE block_sums[]; };\n"
+                   "uniform uint u_dst_offset;\n"
+                   "uniform uint u_count;\n"
+                   "void main() {\n"
+                   "    uint base = groupIndex() * 2u * WG;\n"
+                   "    uint i = base + gl_LocalInvocationID.x;\n"
+                   "    if (base >= u_count) { return; }\n"
+                   "    TYPE sum = block_sums[groupIndex()];\n"
+                   "    if (i < u_count) { dst_data[u_dst_offset + i] += sum; }\n"
+                   "    if (i + WG < u_count) { dst_data[u_dst_offset + i + WG] += sum; }\n"
+                   "}\n";
+        });
+
+        GLuint elements_per_group = 2 * m_workgroup_size;
+        GLuint group_cnt = (count + elements_per_group - 1) / elements_per_group;
+
+        // one block sum buffer per recursion level, the levels below are used by the recursive scan
+        GLuint block_sums = 0;
+        if (group_cnt > 1)
+        {
+            block_sums = getScratchBuffer(level + 1, static_cast<GLsizeiptr>(group_cnt) * sizeof(T)).getName();
+        }
+
+        scan_program.use();
+        scan_program.setUniform("u_src_offset", elementOffset<T>(src));
+        scan_program.setUniform("u_dst_offset", elementOffset<T>(dst));
+        scan_program.setUniform("u_count", count);
+        scan_program.setUniform("u_inclusive", static_cast<GLuint>(inclusive ? 1 : 0));
+        scan_program.setUniform("u_write_sums", static_cast<GLuint>(group_cnt > 1 ? 1 : 0));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, src.buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, dst.buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, block_sums != 0 ? block_sums : dst.buffer);
+        dispatch(group_cnt);
+
+        if (group_cnt > 1)
+        {
+            scan<T>(BufferRange(block_sums), BufferRange(block_sums), group_cnt, false, level + 1);
+
+            add_program.use();
+            add_program.setUniform("u_dst_offset", elementOffset<T>(dst));
+            add_program.setUniform("u_count", count);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, dst.buffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, block_sums);
+            dispatch(group_cnt);
+        }
+    }
+
+    inline void BufferKernels::checkError(char const* function) const
+    {
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException(std::string(function) + " - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    template<typename T>
+    inline GLuint BufferKernels::elementOffset(BufferRange const& range)
+    {
+        static_assert(std::is_same_v<T, GLuint> || std::is_same_v<T, GLint> || std::is_same_v<T, GLfloat>,
+                      "BufferKernels only support GLuint, GLint and GLfloat elements");
+
+        if ((range.byte_offset % sizeof(T)) != 0)
+        {
+            throw BufferObjectException("BufferKernels - byte offset is not a multiple of the element size");
+        }
+        return static_cast<GLuint>(range.byte_offset / sizeof(T));
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_BUFFERKERNELS_HPP
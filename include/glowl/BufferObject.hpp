@@ -8,7 +8,12 @@
 #ifndef GLOWL_BUFFEROBJECT_HPP
 #define GLOWL_BUFFEROBJECT_HPP
 
+#include <algorithm>
+#include <utility>
+
 #include "Exceptions.hpp"
+#include "MappedRange.hpp"
+#include "NamePool.hpp"
 #include "glinclude.h"
 
 namespace glowl
@@ -27,37 +32,104 @@ namespace glowl
         /**
          * \brief BufferObject constructor that uses std containers as input.
          *
+         * \param name_pool Optional buffer name pool, has to outlive the buffer object
+         *
          * Note: Active OpenGL context required for construction.
          * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
          */
         template<typename Container>
-        BufferObject(GLenum target, Container const& datastorage, GLenum usage = GL_DYNAMIC_DRAW);
+        BufferObject(GLenum           target,
+                     Container const& datastorage,
+                     GLenum           usage = GL_DYNAMIC_DRAW,
+                     NamePool*        name_pool = nullptr);
 
         /**
          * \brief BufferObject constructor that uses data pointer and byte size as input.
          *
+         * \param name_pool Optional buffer name pool, has to outlive the buffer object
+         *
          * Note: Active OpenGL context required for construction.
          * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
          */
-        BufferObject(GLenum target, GLvoid const* data, GLsizeiptr byte_size, GLenum usage = GL_DYNAMIC_DRAW);
+        BufferObject(GLenum        target,
+                     GLvoid const* data,
+                     GLsizeiptr    byte_size,
+                     GLenum        usage = GL_DYNAMIC_DRAW,
+                     NamePool*     name_pool = nullptr);
 
         ~BufferObject();
 
         BufferObject(const BufferObject&) = delete;
-        BufferObject(BufferObject&&) = delete;
-        BufferObject& operator=(BufferObject&&) = delete;
         BufferObject& operator=(const BufferObject&) = delete;
 
+        /**
+         * \brief Move constructor. Takes over the buffer name, the moved-from object is left with name 0.
+         */
+        BufferObject(BufferObject&& other) noexcept;
+
+        BufferObject& operator=(BufferObject&& rhs) noexcept;
+
         template<typename Container>
         void bufferSubData(Container const& datastorage, GLsizeiptr byte_offset = 0) const;
 
         void bufferSubData(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset = 0) const;
 
+        /**
+         * \brief Map a range of the buffer for direct access.
+         *
+         * \param byte_offset Start of the range in bytes
+         * \param byte_size Size of the range in bytes, must be a multiple of sizeof(T)
+         * \param access Access flags for glMapNamedBufferRange, e.g. GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT,
+         * optionally combined with GL_MAP_UNSYNCHRONIZED_BIT or GL_MAP_FLUSH_EXPLICIT_BIT
+         */
+        template<typename T>
+        MappedRange<T> mapRange(GLsizeiptr byte_offset, GLsizeiptr byte_size, GLbitfield access) const;
+
+        /**
+         * \brief Map the whole buffer for direct access.
+         */
+        template<typename T>
+        MappedRange<T> map(GLbitfield access) const;
+
+        /**
+         * \brief Replace the buffer content. Storage is only reallocated if byte_size exceeds the current capacity.
+         * The buffer name does not change. The previous content is invalidated before the upload, which allows the
+         * driver to orphan storage that is still in use by pending draws instead of synchronizing with them.
+         */
         template<typename Container>
         void rebuffer(Container const& datastorage);
 
         void rebuffer(GLvoid const* data, GLsizeiptr byte_size);
 
+        /**
+         * \brief Append data at the end of the buffer, growing the capacity geometrically if required.
+         * Existing content is kept. The buffer name does not change.
+         *
+         * \return Returns the byte offset of the appended data.
+         */
+        template<typename Container>
+        GLsizeiptr append(Container const& datastorage);
+
+        GLsizeiptr append(GLvoid const* data, GLsizeiptr byte_size);
+
+        /**
+         * \brief Change the byte size of the buffer, growing the capacity geometrically if required.
+         * Content up to the smaller of old and new size is kept. The buffer name does not change.
+         */
+        void resize(GLsizeiptr byte_size);
+
+        /**
+         * \brief Make sure the storage can hold at least byte_capacity bytes without reallocation.
+         * Existing content is kept. The buffer name does not change.
+         */
+        void reserve(GLsizeiptr byte_capacity);
+
+        /**
+         * \brief Reduce the capacity to the current byte size. Existing content is kept.
+         * The buffer name does not change.
+         */
+        void shrinkToFit();
+
         void bind() const;
 
         void bind(GLuint index) const;
@@ -78,23 +150,42 @@ namespace glowl
 
         GLsizeiptr getByteSize() const;
 
+        /**
+         * \brief Returns the byte size of the allocated storage, which might exceed the byte size of the content.
+         */
+        GLsizeiptr getCapacity() const;
+
         GLenum getUsage() const;
 
     private:
+        bool fits(GLsizeiptr byte_offset, GLsizeiptr byte_size) const;
+
+        /**
+         * \brief Respecify the storage of the current name with the given capacity, keeping the content.
+         */
+        void reallocate(GLsizeiptr byte_capacity);
+
         GLenum     m_target;
         GLuint     m_name;
         GLsizeiptr m_byte_size;
+        GLsizeiptr m_capacity;
         GLenum     m_usage;
+        NamePool*  m_name_pool;
     };
 
     template<typename Container>
-    inline BufferObject::BufferObject(GLenum target, Container const& datastorage, GLenum usage)
+    inline BufferObject::BufferObject(GLenum           target,
+                                      Container const& datastorage,
+                                      GLenum           usage,
+                                      NamePool*        name_pool)
         : m_target(target),
           m_name(0),
           m_byte_size(static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type))),
-          m_usage(usage)
+          m_capacity(m_byte_size),
+          m_usage(usage),
+          m_name_pool(name_pool)
     {
-        glCreateBuffers(1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Buffer);
         glNamedBufferData(m_name, m_byte_size, datastorage.data(), m_usage);
 
         auto err = glGetError();
@@ -104,13 +195,19 @@ namespace glowl
         }
     }
 
-    inline BufferObject::BufferObject(GLenum target, GLvoid const* data, GLsizeiptr byte_size, GLenum usage)
+    inline BufferObject::BufferObject(GLenum        target,
+                                      GLvoid const* data,
+                                      GLsizeiptr    byte_size,
+                                      GLenum        usage,
+                                      NamePool*     name_pool)
         : m_target(target),
           m_name(0),
           m_byte_size(byte_size),
-          m_usage(usage)
+          m_capacity(byte_size),
+          m_usage(usage),
+          m_name_pool(name_pool)
     {
-        glCreateBuffers(1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Buffer);
         glNamedBufferData(m_name, m_byte_size, data, m_usage);
 
         auto err = glGetError();
@@ -122,15 +219,39 @@ namespace glowl
 
     inline BufferObject::~BufferObject()
     {
-        glDeleteBuffers(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Buffer, m_name, true);
+    }
+
+    inline BufferObject::BufferObject(BufferObject&& other) noexcept
+        : m_target(other.m_target),
+          m_name(std::exchange(other.m_name, 0)),
+          m_byte_size(std::exchange(other.m_byte_size, 0)),
+          m_capacity(std::exchange(other.m_capacity, 0)),
+          m_usage(other.m_usage),
+          m_name_pool(other.m_name_pool)
+    {
+    }
+
+    inline BufferObject& BufferObject::operator=(BufferObject&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Buffer, m_name, true);
+            m_target = rhs.m_target;
+            m_name = std::exchange(rhs.m_name, 0);
+            m_byte_size = std::exchange(rhs.m_byte_size, 0);
+            m_capacity = std::exchange(rhs.m_capacity, 0);
+            m_usage = rhs.m_usage;
+            m_name_pool = rhs.m_name_pool;
+        }
+        return *this;
     }
 
     template<typename Container>
     inline void BufferObject::bufferSubData(Container const& datastorage, GLsizeiptr byte_offset) const
     {
         // check if feasible
-        if ((byte_offset + static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type))) >
-            m_byte_size)
+        if (!fits(byte_offset, static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type))))
         {
             // error message
             throw BufferObjectException("BufferObject::bufferSubData - given data too large for buffer");
@@ -145,7 +266,7 @@ namespace glowl
     inline void BufferObject::bufferSubData(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset) const
     {
         // check if feasible
-        if ((byte_offset + byte_size) > m_byte_size)
+        if (!fits(byte_offset, byte_size))
         {
             // error message
             throw BufferObjectException("BufferObject::bufferSubData - given data too large for buffer");
@@ -154,11 +275,51 @@ namespace glowl
         glNamedBufferSubData(m_name, byte_offset, byte_size, data);
     }
 
+    template<typename T>
+    inline MappedRange<T> BufferObject::mapRange(GLsizeiptr byte_offset, GLsizeiptr byte_size, GLbitfield access) const
+    {
+        // check if feasible
+        if (byte_offset < 0 || !fits(byte_offset, byte_size))
+        {
+            // error message
+            throw BufferObjectException("BufferObject::mapRange - given range out of buffer bounds");
+        }
+
+        return MappedRange<T>(m_name, byte_offset, byte_size, access);
+    }
+
+    template<typename T>
+    inline MappedRange<T> BufferObject::map(GLbitfield access) const
+    {
+        return mapRange<T>(0, m_byte_size, access);
+    }
+
     template<typename Container>
     inline void BufferObject::rebuffer(Container const& datastorage)
     {
-        m_byte_size = static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type));
-        glNamedBufferData(m_name, m_byte_size, datastorage.data(), m_usage);
+        rebuffer(datastorage.data(),
+                 static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type)));
+    }
+
+    inline void BufferObject::rebuffer(GLvoid const* data, GLsizeiptr byte_size)
+    {
+        if (byte_size > m_capacity)
+        {
+            // old content is replaced anyway, so simply respecify the storage of the current name
+            m_capacity = std::max(byte_size, 2 * m_capacity);
+            glNamedBufferData(m_name, m_capacity, nullptr, m_usage);
+        }
+        else if (m_capacity > 0)
+        {
+            // storage is reused, mark the whole content as undefined so the upload need not wait for the GPU
+            glInvalidateBufferData(m_name);
+        }
+
+        m_byte_size = byte_size;
+        if (data != nullptr && byte_size > 0)
+        {
+            glNamedBufferSubData(m_name, 0, m_byte_size, data);
+        }
 
         auto err = glGetError();
         if (err != GL_NO_ERROR)
@@ -167,15 +328,77 @@ namespace glowl
         }
     }
 
-    inline void BufferObject::rebuffer(GLvoid const* data, GLsizeiptr byte_size)
+    template<typename Container>
+    inline GLsizeiptr BufferObject::append(Container const& datastorage)
+    {
+        return append(datastorage.data(),
+                      static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type)));
+    }
+
+    inline GLsizeiptr BufferObject::append(GLvoid const* data, GLsizeiptr byte_size)
+    {
+        GLsizeiptr byte_offset = m_byte_size;
+
+        resize(m_byte_size + byte_size);
+        bufferSubData(data, byte_size, byte_offset);
+
+        return byte_offset;
+    }
+
+    inline void BufferObject::resize(GLsizeiptr byte_size)
     {
+        if (byte_size > m_capacity)
+        {
+            reserve(std::max(byte_size, 2 * m_capacity));
+        }
+
         m_byte_size = byte_size;
-        glNamedBufferData(m_name, m_byte_size, data, m_usage);
+    }
+
+    inline void BufferObject::reserve(GLsizeiptr byte_capacity)
+    {
+        if (byte_capacity > m_capacity)
+        {
+            reallocate(byte_capacity);
+        }
+    }
+
+    inline void BufferObject::shrinkToFit()
+    {
+        if (m_capacity > m_byte_size)
+        {
+            reallocate(m_byte_size);
+        }
+    }
+
+    inline void BufferObject::reallocate(GLsizeiptr byte_capacity)
+    {
+        // keep the content on the GPU in a scratch buffer, so that vertex arrays and binding points that reference the
+        // name stay valid
+        GLsizeiptr kept_byte_size = std::min(m_byte_size, byte_capacity);
+        GLuint     scratch_name = 0;
+        if (kept_byte_size > 0)
+        {
+            glCreateBuffers(1, &scratch_name);
+            glNamedBufferData(scratch_name, kept_byte_size, nullptr, GL_STREAM_COPY);
+            glCopyNamedBufferSubData(m_name, scratch_name, 0, 0, kept_byte_size);
+        }
+
+        glNamedBufferData(m_name, byte_capacity, nullptr, m_usage);
+
+        if (kept_byte_size > 0)
+        {
+            glCopyNamedBufferSubData(scratch_name, m_name, 0, 0, kept_byte_size);
+            glDeleteBuffers(1, &scratch_name);
+        }
+
+        m_capacity = byte_capacity;
+        m_byte_size = kept_byte_size;
 
         auto err = glGetError();
         if (err != GL_NO_ERROR)
         {
-            throw BufferObjectException("BufferObject::rebuffer - OpenGL error " + std::to_string(err));
+            throw BufferObjectException("BufferObject::reallocate - OpenGL error " + std::to_string(err));
         }
     }
 
@@ -242,11 +465,21 @@ namespace glowl
         return m_byte_size;
     }
 
+    inline GLsizeiptr BufferObject::getCapacity() const
+    {
+        return m_capacity;
+    }
+
     inline GLenum BufferObject::getUsage() const
     {
         return m_usage;
     }
 
+    inline bool BufferObject::fits(GLsizeiptr byte_offset, GLsizeiptr byte_size) const
+    {
+        return (byte_offset + byte_size) <= m_byte_size;
+    }
+
 } // namespace glowl
 
 #endif // GLOWL_BUFFEROBJECT_HPP
@@ -43,6 +43,12 @@ namespace glowl
         using BaseException::BaseException;
     };
 
+    class NamePoolException : public BaseException
+    {
+    public:
+        using BaseException::BaseException;
+    };
+
     class TextureException : public BaseException
     {
     public:
@@ -11,6 +11,7 @@
 #include <any>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Exceptions.hpp"
@@ -91,11 +92,14 @@ namespace glowl
         /* Deleted copy constructor (C++11). Don't wanna go around copying objects with OpenGL handles. */
         FramebufferObject(const FramebufferObject& cpy) = delete;
 
-        FramebufferObject(FramebufferObject&& other) = delete;
+        /**
+         * \brief Move constructor. Takes over the FBO and its attachments, the moved-from FBO is left with handle 0.
+         */
+        FramebufferObject(FramebufferObject&& other) noexcept;
 
         FramebufferObject& operator=(const FramebufferObject& rhs) = delete;
 
-        FramebufferObject& operator=(FramebufferObject&& rhs) = delete;
+        FramebufferObject& operator=(FramebufferObject&& rhs) noexcept;
 
         /**
         * \brief Adds one color attachment to the framebuffer.
@@ -291,6 +295,35 @@ namespace glowl
         glDeleteFramebuffers(1, &m_handle);
     }
 
+    inline FramebufferObject::FramebufferObject(FramebufferObject&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, 0)),
+          m_colorbuffers(std::move(other.m_colorbuffers)),
+          m_depth_stencil(std::move(other.m_depth_stencil)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_drawBufs(std::move(other.m_drawBufs)),
+          m_debug_label(std::move(other.m_debug_label)),
+          m_log(std::move(other.m_log))
+    {
+    }
+
+    inline FramebufferObject& FramebufferObject::operator=(FramebufferObject&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            glDeleteFramebuffers(1, &m_handle);
+            m_handle = std::exchange(rhs.m_handle, 0);
+            m_colorbuffers = std::move(rhs.m_colorbuffers);
+            m_depth_stencil = std::move(rhs.m_depth_stencil);
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_drawBufs = std::move(rhs.m_drawBufs);
+            m_debug_label = std::move(rhs.m_debug_label);
+            m_log = std::move(rhs.m_log);
+        }
+        return *this;
+    }
+
     inline void FramebufferObject::createColorAttachment(GLenum   internalFormat,
                                                          GLenum   format,
                                                          GLenum   type,
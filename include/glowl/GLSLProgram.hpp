@@ -78,9 +78,13 @@ namespace glowl
 
         // Deleted copy constructor (C++11). No going around deleting copies of OpenGL Object with identical handles!
         GLSLProgram(GLSLProgram const& cpy) = delete;
-        GLSLProgram(GLSLProgram&& other) = delete;
         GLSLProgram& operator=(GLSLProgram const& rhs) = delete;
-        GLSLProgram& operator=(GLSLProgram&& rhs) = delete;
+
+        /**
+         * \brief Move constructor. Takes over the program handle, the moved-from program is left with handle 0.
+         */
+        GLSLProgram(GLSLProgram&& other) noexcept;
+        GLSLProgram& operator=(GLSLProgram&& rhs) noexcept;
 
         /**
          * \brief Calls glUseProgram.
@@ -212,6 +216,23 @@ namespace glowl
         glDeleteProgram(m_handle);
     }
 
+    inline GLSLProgram::GLSLProgram(GLSLProgram&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, 0)),
+          m_debug_label(std::move(other.m_debug_label))
+    {
+    }
+
+    inline GLSLProgram& GLSLProgram::operator=(GLSLProgram&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            glDeleteProgram(m_handle);
+            m_handle = std::exchange(rhs.m_handle, 0);
+            m_debug_label = std::move(rhs.m_debug_label);
+        }
+        return *this;
+    }
+
     inline void GLSLProgram::compileShaderFromString(ShaderType shaderType, std::string const& source)
     {
         // Check if the source is empty.
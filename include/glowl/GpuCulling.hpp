@@ -0,0 +1,514 @@
+/*
+ * GpuCulling.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_GPUCULLING_HPP
+#define GLOWL_GPUCULLING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "GLSLProgram.hpp"
+#include "Mesh.hpp"
+#include "MeshBatch.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class GpuCulling
+     *
+     * \brief Compute shader frustum and (optional) Hi-Z occlusion culling of indirect draw commands.
+     *
+     * cull() tests one bounding sphere per DrawElementsCommand and compacts the surviving commands into an output
+     * indirect buffer, counting them atomically in a parameter buffer. The bounding sphere of a command is looked up
+     * by its base_instance, i.e. by the draw ID when used with MeshBatch. Bounding spheres are given as vec4 (world
+     * space center, radius) in a shader storage buffer.
+     *
+     * draw() consumes the results with glMultiDrawElementsIndirectCount if GL 4.6 or ARB_indirect_parameters is
+     * available. Otherwise, culling falls back to keeping all commands in place with the instance count of culled
+     * commands set to zero, which is drawn with glMultiDrawElementsIndirect.
+     *
+     * For occlusion culling, a depth pyramid (R32F texture with full mip chain holding the maximum depth per texel,
+     * see buildDepthPyramid()) of the previous frame is sampled at the level where the projected bounds span at most
+     * 2x2 texels.
+     *
+     * \author Michael Becher
+     */
+    class GpuCulling
+    {
+    public:
+        /**
+         * \brief GpuCulling constructor. Compiles the culling programs and detects indirect count support.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        GpuCulling();
+
+        GpuCulling(const GpuCulling&) = delete;
+        GpuCulling(GpuCulling&&) noexcept = default;
+        GpuCulling& operator=(GpuCulling&&) noexcept = default;
+        GpuCulling& operator=(const GpuCulling&) = delete;
+
+        /**
+         * \brief Cull command_cnt DrawElementsCommands of the given indirect buffer.
+         *
+         * \param bounds_buffer Shader storage buffer with one vec4 bounding sphere per base_instance
+         * \param view_proj Column-major view-projection matrix (16 floats, OpenGL clip space)
+         */
+        void cull(GLuint command_buffer, GLuint command_cnt, GLuint bounds_buffer, GLfloat const* view_proj);
+
+        /**
+         * \brief Draw the commands of the last cull() call. The vertex array has to be bound by the caller.
+         */
+        void draw(GLenum primitive_type, GLenum index_type) const;
+
+        /**
+         * \brief Cull and draw all blocks of a MeshBatch.
+         */
+        void cullAndDraw(MeshBatch& batch, GLuint bounds_buffer, GLfloat const* view_proj);
+
+        /**
+         * \brief Enable occlusion culling against the given depth pyramid.
+         */
+        void setDepthPyramid(GLuint pyramid_texture, GLsizei width, GLsizei height, GLsizei levels);
+
+        void disableDepthPyramid();
+
+        /**
+         * \brief Build a maximum depth pyramid from a depth texture of the same size as level 0.
+         *
+         * \param pyramid_texture R32F texture with the given number of levels, see computeDepthPyramidLevels()
+         */
+        void buildDepthPyramid(GLuint  depth_texture,
+                               GLuint  pyramid_texture,
+                               GLsizei width,
+                               GLsizei height,
+                               GLsizei levels);
+
+        static GLsizei computeDepthPyramidLevels(GLsizei width, GLsizei height);
+
+        /**
+         * \brief Returns true if culled commands are compacted and drawn with an indirect count.
+         */
+        bool isIndirectCountEnabled() const;
+
+        /**
+         * \brief Force the fallback path, e.g. for comparison. Enabling fails if not supported.
+         */
+        void setIndirectCountEnabled(bool enabled);
+
+        BufferObject const& getCommandBuffer() const;
+
+        /**
+         * \brief Returns the parameter buffer that holds the number of visible commands as single GLuint.
+         */
+        BufferObject const& getDrawCountBuffer() const;
+
+        /**
+         * \brief Returns the number of commands of the last cull() call, i.e. the maximum draw count.
+         */
+        GLuint getCommandCount() const;
+
+    private:
+        enum class IndirectCount
+        {
+            None,
+            Core,
+            ARB
+        };
+
+        static IndirectCount detectIndirectCount();
+
+        static constexpr GLuint workgroup_size = 64;
+
+        GLSLProgram  m_cull_program;
+        GLSLProgram  m_pyramid_program;
+        BufferObject m_command_buffer;
+        BufferObject m_draw_count_buffer;
+        GLuint       m_command_cnt;
+
+        IndirectCount m_supported_indirect_count;
+        bool          m_indirect_count_enabled;
+
+        GLuint  m_pyramid_texture;
+        GLsizei m_pyramid_width;
+        GLsizei m_pyramid_height;
+        GLsizei m_pyramid_levels;
+    };
+
+    inline GpuCulling::GpuCulling()
+        : m_cull_program({{GLSLProgram::ShaderType::Compute,
+                           "#version 430\n"
+                           "layout(local_size_x = 64) in;\n"
+                           "struct DrawCommand { uint cnt; uint instance_cnt; uint first_idx; uint base_vertex;"
+                           " uint base_instance; };\n"
+                           "layout(std430, binding = 0) readonly buffer Commands { DrawCommand commands[]; };\n"
+                           "layout(std430, binding = 1) readonly buffer Bounds { vec4 bounds[]; };\n"
+                           "layout(std430, binding = 2) writeonly buffer Output { DrawCommand output_commands[]; };\n"
+                           "layout(std430, binding = 3) buffer DrawCount { uint draw_cnt; };\n"
+                           "layout(binding = 0) uniform sampler2D u_pyramid;\n"
+                           "uniform vec4 u_planes[6];\n"
+                           "uniform mat4 u_view_proj;\n"
+                           "uniform uint u_command_cnt;\n"
+                           "uniform uint u_compact;\n"
+                           "uniform int u_pyramid_levels;\n"
+                           "uniform ivec2 u_pyramid_size;\n"
+                           "bool isOccluded(vec4 sphere) {\n"
+                           "    vec3 ndc_min = vec3(1.0);\n"
+                           "    vec3 ndc_max = vec3(-1.0);\n"
+                           "    for (int i = 0; i < 8; ++i) {\n" // corners of the sphere's bounding box
+                           "        vec3 dir = vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0,"
+                           " (i & 4) != 0 ? 1.0 : -1.0);\n"
+                           "        vec4 clip = u_view_proj * vec4(sphere.xyz + sphere.w * dir, 1.0);\n"
+                           "        if (clip.w <= 0.0) { return false; }\n"
+                           "        vec3 ndc = clip.xyz / clip.w;\n"
+                           "        ndc_min = (i == 0) ? ndc : min(ndc_min, ndc);\n"
+                           "        ndc_max = (i == 0) ? ndc : max(ndc_max, ndc);\n"
+                           "    }\n"
+                           "    vec2 uv_min = clamp(ndc_min.xy * 0.5 + 0.5, 0.0, 1.0);\n"
+                           "    vec2 uv_max = clamp(ndc_max.xy * 0.5 + 0.5, 0.0, 1.0);\n"
+                           "    vec2 extent = (uv_max - uv_min) * vec2(u_pyramid_size);\n"
+                           "    int level = int(ceil(log2(max(max(extent.x, extent.y), 1.0))));\n"
+                           "    level = clamp(level, 0, u_pyramid_levels - 1);\n"
+                           "    ivec2 level_size = max(u_pyramid_size >> level, ivec2(1));\n"
+                           // follow the reduction mapping of buildDepthPyramid(): level 0 texel x is covered by
+                           // level texel x >> level, with the remainder of odd sizes folded into the last texel
+                           "    ivec2 texel0_min = clamp(ivec2(uv_min * vec2(u_pyramid_size)), ivec2(0),"
+                           " u_pyramid_size - 1);\n"
+                           "    ivec2 texel0_max = clamp(ivec2(uv_max * vec2(u_pyramid_size)), ivec2(0),"
+                           " u_pyramid_size - 1);\n"
+                           "    ivec2 texel_min = min(texel0_min >> level, level_size - 1);\n"
+                           "    ivec2 texel_max = min(texel0_max >> level, level_size - 1);\n"
+                           "    float depth = max(texelFetch(u_pyramid, texel_min, level).r,\n"
+                           "                      texelFetch(u_pyramid, ivec2(texel_max.x, texel_min.y), level).r);\n"
+                           "    depth = max(depth, texelFetch(u_pyramid, ivec2(texel_min.x, texel_max.y), level).r);\n"
+                           "    depth = max(depth, texelFetch(u_pyramid, texel_max, level).r);\n"
+                           "    return (ndc_min.z * 0.5 + 0.5) > depth;\n"
+                           "}\n"
+                           "void main() {\n"
+                           "    uint i = gl_GlobalInvocationID.x;\n"
+                           "    i += gl_GlobalInvocationID.y * gl_NumWorkGroups.x * gl_WorkGroupSize.x;\n"
+                           "    if (i >= u_command_cnt) { return; }\n"
+                           "    DrawCommand command = commands[i];\n"
+                           "    vec4 sphere = bounds[command.base_instance];\n"
+                           "    bool visible = command.instance_cnt > 0u;\n"
+                           "    for (int p = 0; p < 6 && visible; ++p) {\n"
+                           "        visible = dot(u_planes[p].xyz, sphere.xyz) + u_planes[p].w >= -sphere.w;\n"
+                           "    }\n"
+                           "    if (visible && u_pyramid_levels > 0) { visible = !isOccluded(sphere); }\n"
+                           "    if (u_compact != 0u) {\n"
+                           "        if (visible) { output_commands[atomicAdd(draw_cnt, 1u)] = command; }\n"
+                           "    } else {\n"
+                           "        if (!visible) { command.instance_cnt = 0u; }\n"
+                           "        output_commands[i] = command;\n"
+                           "    }\n"
+                           "}\n"}}),
+          m_pyramid_program({{GLSLProgram::ShaderType::Compute,
+                              "#version 430\n"
+                              "layout(local_size_x = 8, local_size_y = 8) in;\n"
+                              "layout(binding = 0) uniform sampler2D u_src;\n"
+                              "layout(r32f, binding = 0) uniform writeonly image2D u_dst;\n"
+                              "uniform int u_src_level;\n"
+                              "uniform int u_reduce;\n"
+                              "void main() {\n"
+                              "    ivec2 dst_size = imageSize(u_dst);\n"
+                              "    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);\n"
+                              "    if (any(greaterThanEqual(texel, dst_size))) { return; }\n"
+                              "    if (u_reduce == 0) {\n"
+                              "        imageStore(u_dst, texel, vec4(texelFetch(u_src, texel, 0).r));\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    ivec2 src_size = textureSize(u_src, u_src_level);\n"
+                              "    ivec2 src_begin = 2 * texel;\n"
+                              // odd source sizes: the last texel row/column also covers the remaining source texel
+                              "    ivec2 odd = ivec2(equal(texel, dst_size - 1)) * (src_size & 1);\n"
+                              "    ivec2 src_end = src_begin + 1 + odd;\n"
+                              "    src_end = min(src_end, src_size - 1);\n"
+                              "    float depth = 0.0;\n"
+                              "    for (int y = src_begin.y; y <= src_end.y; ++y) {\n"
+                              "        for (int x = src_begin.x; x <= src_end.x; ++x) {\n"
+                              "            depth = max(depth, texelFetch(u_src, ivec2(x, y), u_src_level).r);\n"
+                              "        }\n"
+                              "    }\n"
+                              "    imageStore(u_dst, texel, vec4(depth));\n"
+                              "}\n"}}),
+          m_command_buffer(GL_DRAW_INDIRECT_BUFFER, static_cast<GLvoid const*>(nullptr), 0, GL_DYNAMIC_COPY),
+          m_draw_count_buffer(GL_SHADER_STORAGE_BUFFER, static_cast<GLvoid const*>(nullptr), 4, GL_DYNAMIC_COPY),
+          m_command_cnt(0),
+          m_supported_indirect_count(detectIndirectCount()),
+          m_indirect_count_enabled(m_supported_indirect_count != IndirectCount::None),
+          m_pyramid_texture(0),
+          m_pyramid_width(0),
+          m_pyramid_height(0),
+          m_pyramid_levels(0)
+    {
+    }
+
+    inline void GpuCulling::cull(GLuint         command_buffer,
+                                 GLuint         command_cnt,
+                                 GLuint         bounds_buffer,
+                                 GLfloat const* view_proj)
+    {
+        m_command_cnt = command_cnt;
+        m_command_buffer.rebuffer(nullptr, static_cast<GLsizeiptr>(command_cnt * sizeof(DrawElementsCommand)));
+
+        GLuint zero = 0;
+        glClearNamedBufferData(m_draw_count_buffer.getName(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+        if (command_cnt == 0)
+        {
+            return;
+        }
+
+        // frustum planes from the rows of the column-major matrix (Gribb/Hartmann), normalized for sphere tests
+        std::array<GLfloat, 24> planes;
+        for (int p = 0; p < 6; ++p)
+        {
+            int   row = p / 2;
+            float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                planes[p * 4 + c] = view_proj[c * 4 + 3] + sign * view_proj[c * 4 + row];
+            }
+
+            float length = std::sqrt(planes[p * 4] * planes[p * 4] + planes[p * 4 + 1] * planes[p * 4 + 1] +
+                                     planes[p * 4 + 2] * planes[p * 4 + 2]);
+            for (int c = 0; c < 4; ++c)
+            {
+                planes[p * 4 + c] /= length;
+            }
+        }
+
+        // keep the caller's program bound for drawing the results
+        GLint previous_program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+
+        m_cull_program.use();
+        glUniform4fv(m_cull_program.getUniformLocation("u_planes"), 6, planes.data());
+        glUniformMatrix4fv(m_cull_program.getUniformLocation("u_view_proj"), 1, GL_FALSE, view_proj);
+        m_cull_program.setUniform("u_command_cnt", command_cnt);
+        m_cull_program.setUniform("u_compact", static_cast<GLuint>(m_indirect_count_enabled ? 1 : 0));
+        m_cull_program.setUniform("u_pyramid_levels", static_cast<GLint>(m_pyramid_levels));
+        m_cull_program.setUniform("u_pyramid_size", m_pyramid_width, m_pyramid_height);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, command_buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, bounds_buffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_command_buffer.getName());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_draw_count_buffer.getName());
+        if (m_pyramid_levels > 0)
+        {
+            glBindTextureUnit(0, m_pyramid_texture);
+        }
+
+        // stay within the guaranteed minimum of 65535 work groups per dimension
+        GLuint group_cnt = (command_cnt + workgroup_size - 1) / workgroup_size;
+        GLuint group_cnt_x = std::min(group_cnt, 65535u);
+        glDispatchCompute(group_cnt_x, (group_cnt + group_cnt_x - 1) / group_cnt_x, 1);
+
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+        glUseProgram(static_cast<GLuint>(previous_program));
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException("GpuCulling::cull - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline void GpuCulling::draw(GLenum primitive_type, GLenum index_type) const
+    {
+        if (m_command_cnt == 0)
+        {
+            return;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_command_buffer.getName());
+
+        if (m_indirect_count_enabled)
+        {
+#if defined(GL_VERSION_4_6)
+            if (m_supported_indirect_count == IndirectCount::Core)
+            {
+                glBindBuffer(GL_PARAMETER_BUFFER, m_draw_count_buffer.getName());
+                glMultiDrawElementsIndirectCount(primitive_type,
+                                                 index_type,
+                                                 nullptr,
+                                                 0,
+                                                 static_cast<GLsizei>(m_command_cnt),
+                                                 0);
+                glBindBuffer(GL_PARAMETER_BUFFER, 0);
+            }
+#endif
+#if defined(GL_ARB_indirect_parameters)
+            if (m_supported_indirect_count == IndirectCount::ARB)
+            {
+                glBindBuffer(GL_PARAMETER_BUFFER_ARB, m_draw_count_buffer.getName());
+                glMultiDrawElementsIndirectCountARB(primitive_type,
+                                                    index_type,
+                                                    nullptr,
+                                                    0,
+                                                    static_cast<GLsizei>(m_command_cnt),
+                                                    0);
+                glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+            }
+#endif
+        }
+        else
+        {
+            glMultiDrawElementsIndirect(primitive_type, index_type, nullptr, static_cast<GLsizei>(m_command_cnt), 0);
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    inline void GpuCulling::cullAndDraw(MeshBatch& batch, GLuint bounds_buffer, GLfloat const* view_proj)
+    {
+        batch.flush();
+
+        MeshArena const& arena = batch.getMeshArena();
+        for (GLuint block = 0; block < arena.getBlockCount(); ++block)
+        {
+            if (batch.getDrawCount(block) == 0)
+            {
+                continue;
+            }
+
+            cull(batch.getCommandBuffer(block).getName(), batch.getDrawCount(block), bounds_buffer, view_proj);
+
+            arena.bindVertexArray(block);
+            draw(arena.getPrimitiveType(), arena.getIndexType());
+        }
+
+        glBindVertexArray(0);
+    }
+
+    inline void GpuCulling::setDepthPyramid(GLuint pyramid_texture, GLsizei width, GLsizei height, GLsizei levels)
+    {
+        m_pyramid_texture = pyramid_texture;
+        m_pyramid_width = width;
+        m_pyramid_height = height;
+        m_pyramid_levels = levels;
+    }
+
+    inline void GpuCulling::disableDepthPyramid()
+    {
+        setDepthPyramid(0, 0, 0, 0);
+    }
+
+    inline void GpuCulling::buildDepthPyramid(GLuint  depth_texture,
+                                              GLuint  pyramid_texture,
+                                              GLsizei width,
+                                              GLsizei height,
+                                              GLsizei levels)
+    {
+        GLint previous_program = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+
+        m_pyramid_program.use();
+
+        for (GLsizei level = 0; level < levels; ++level)
+        {
+            GLsizei level_width = std::max(width >> level, 1);
+            GLsizei level_height = std::max(height >> level, 1);
+
+            // level 0 copies the depth texture, all other levels reduce the previous level
+            glBindTextureUnit(0, level == 0 ? depth_texture : pyramid_texture);
+            glBindImageTexture(0, pyramid_texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            m_pyramid_program.setUniform("u_src_level", static_cast<GLint>(std::max(level - 1, 0)));
+            m_pyramid_program.setUniform("u_reduce", static_cast<GLint>(level == 0 ? 0 : 1));
+
+            glDispatchCompute((level_width + 7) / 8, (level_height + 7) / 8, 1);
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        }
+        glUseProgram(static_cast<GLuint>(previous_program));
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw TextureException("GpuCulling::buildDepthPyramid - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline GLsizei GpuCulling::computeDepthPyramidLevels(GLsizei width, GLsizei height)
+    {
+        GLsizei levels = 1;
+        while ((std::max(width, height) >> levels) > 0)
+        {
+            ++levels;
+        }
+        return levels;
+    }
+
+    inline bool GpuCulling::isIndirectCountEnabled() const
+    {
+        return m_indirect_count_enabled;
+    }
+
+    inline void GpuCulling::setIndirectCountEnabled(bool enabled)
+    {
+        if (enabled && m_supported_indirect_count == IndirectCount::None)
+        {
+            throw BufferObjectException("GpuCulling::setIndirectCountEnabled - indirect count draws not supported");
+        }
+        m_indirect_count_enabled = enabled;
+    }
+
+    inline BufferObject const& GpuCulling::getCommandBuffer() const
+    {
+        return m_command_buffer;
+    }
+
+    inline BufferObject const& GpuCulling::getDrawCountBuffer() const
+    {
+        return m_draw_count_buffer;
+    }
+
+    inline GLuint GpuCulling::getCommandCount() const
+    {
+        return m_command_cnt;
+    }
+
+    inline GpuCulling::IndirectCount GpuCulling::detectIndirectCount()
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+#if defined(GL_VERSION_4_6)
+        if (major > 4 || (major == 4 && minor >= 6))
+        {
+            return IndirectCount::Core;
+        }
+#endif
+
+#if defined(GL_ARB_indirect_parameters)
+        GLint extension_cnt = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extension_cnt);
+        for (GLint i = 0; i < extension_cnt; ++i)
+        {
+            char const* extension = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (extension != nullptr && std::strcmp(extension, "GL_ARB_indirect_parameters") == 0)
+            {
+                return IndirectCount::ARB;
+            }
+        }
+#endif
+
+        return IndirectCount::None;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_GPUCULLING_HPP
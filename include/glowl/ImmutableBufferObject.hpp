@@ -8,6 +8,11 @@
 #ifndef GLOWL_IMMUTABLEBUFFEROBJECT_HPP
 #define GLOWL_IMMUTABLEBUFFEROBJECT_HPP
 
+#include <utility>
+
+#include "Exceptions.hpp"
+#include "MappedRange.hpp"
+#include "NamePool.hpp"
 #include "glinclude.h"
 
 namespace glowl
@@ -25,16 +30,22 @@ namespace glowl
     private:
         GLuint     m_name;
         GLsizeiptr m_byte_size;
+        NamePool*  m_name_pool;
 
     public:
         /**
          * \brief ImmutableBufferObject constructor that uses std containers as input.
          *
+         * \param name_pool Optional buffer name pool, has to outlive the buffer object. Since the storage is
+         * immutable, the name is deleted instead of recycled on destruction.
+         *
          * Note: Active OpenGL context required for construction.
          * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
          */
         template<typename Container>
-        explicit ImmutableBufferObject(Container const& datastorage, GLbitfield flags = 0);
+        explicit ImmutableBufferObject(Container const& datastorage,
+                                       GLbitfield       flags = 0,
+                                       NamePool*        name_pool = nullptr);
 
         /**
          * \brief ImmutableBufferObject constructor that uses data pointer and byte size as input.
@@ -42,15 +53,23 @@ namespace glowl
          * Note: Active OpenGL context required for construction.
          * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
          */
-        ImmutableBufferObject(GLvoid const* data, GLsizeiptr byte_size, GLbitfield flags = 0);
+        ImmutableBufferObject(GLvoid const* data,
+                              GLsizeiptr    byte_size,
+                              GLbitfield    flags = 0,
+                              NamePool*     name_pool = nullptr);
 
         ~ImmutableBufferObject();
 
         ImmutableBufferObject(const ImmutableBufferObject&) = delete;
-        ImmutableBufferObject(ImmutableBufferObject&&) = delete;
-        ImmutableBufferObject& operator=(ImmutableBufferObject&&) = delete;
         ImmutableBufferObject& operator=(const ImmutableBufferObject&) = delete;
 
+        /**
+         * \brief Move constructor. Takes over the buffer name, the moved-from object is left with name 0.
+         */
+        ImmutableBufferObject(ImmutableBufferObject&& other) noexcept;
+
+        ImmutableBufferObject& operator=(ImmutableBufferObject&& rhs) noexcept;
+
         GLuint getName() const;
 
         GLsizeiptr getByteSize() const;
@@ -59,6 +78,25 @@ namespace glowl
 
         void bindBase(GLenum target, GLuint index) const;
 
+        /**
+         * \brief Map a range of the buffer for direct access.
+         *
+         * Requires matching GL_MAP_READ_BIT/GL_MAP_WRITE_BIT (and GL_MAP_PERSISTENT_BIT) storage flags.
+         *
+         * \param byte_offset Start of the range in bytes
+         * \param byte_size Size of the range in bytes, must be a multiple of sizeof(T)
+         * \param access Access flags for glMapNamedBufferRange, e.g. GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT,
+         * optionally combined with GL_MAP_UNSYNCHRONIZED_BIT or GL_MAP_FLUSH_EXPLICIT_BIT
+         */
+        template<typename T>
+        MappedRange<T> mapRange(GLsizeiptr byte_offset, GLsizeiptr byte_size, GLbitfield access) const;
+
+        /**
+         * \brief Map the whole buffer for direct access.
+         */
+        template<typename T>
+        MappedRange<T> map(GLbitfield access) const;
+
         static void copy(ImmutableBufferObject& src,
                          ImmutableBufferObject& tgt,
                          GLintptr               readOffset,
@@ -67,25 +105,51 @@ namespace glowl
     };
 
     template<typename Container>
-    inline ImmutableBufferObject::ImmutableBufferObject(Container const& datastorage, GLbitfield flags)
+    inline ImmutableBufferObject::ImmutableBufferObject(Container const& datastorage,
+                                                        GLbitfield       flags,
+                                                        NamePool*        name_pool)
         : m_name(0),
-          m_byte_size(static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type)))
+          m_byte_size(static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type))),
+          m_name_pool(name_pool)
     {
-        glCreateBuffers(1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Buffer);
         glNamedBufferStorage(m_name, m_byte_size, datastorage.data(), flags);
     }
 
-    inline ImmutableBufferObject::ImmutableBufferObject(GLvoid const* data, GLsizeiptr byte_size, GLbitfield flags)
+    inline ImmutableBufferObject::ImmutableBufferObject(GLvoid const* data,
+                                                        GLsizeiptr    byte_size,
+                                                        GLbitfield    flags,
+                                                        NamePool*     name_pool)
         : m_name(0),
-          m_byte_size(byte_size)
+          m_byte_size(byte_size),
+          m_name_pool(name_pool)
     {
-        glCreateBuffers(1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Buffer);
         glNamedBufferStorage(m_name, m_byte_size, data, flags);
     }
 
     inline ImmutableBufferObject::~ImmutableBufferObject()
     {
-        glDeleteBuffers(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Buffer, m_name, false);
+    }
+
+    inline ImmutableBufferObject::ImmutableBufferObject(ImmutableBufferObject&& other) noexcept
+        : m_name(std::exchange(other.m_name, 0)),
+          m_byte_size(std::exchange(other.m_byte_size, 0)),
+          m_name_pool(other.m_name_pool)
+    {
+    }
+
+    inline ImmutableBufferObject& ImmutableBufferObject::operator=(ImmutableBufferObject&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Buffer, m_name, false);
+            m_name = std::exchange(rhs.m_name, 0);
+            m_byte_size = std::exchange(rhs.m_byte_size, 0);
+            m_name_pool = rhs.m_name_pool;
+        }
+        return *this;
     }
 
     inline GLuint ImmutableBufferObject::getName() const
@@ -108,6 +172,25 @@ namespace glowl
         glBindBufferBase(target, index, m_name);
     }
 
+    template<typename T>
+    inline MappedRange<T> ImmutableBufferObject::mapRange(GLsizeiptr byte_offset,
+                                                          GLsizeiptr byte_size,
+                                                          GLbitfield access) const
+    {
+        if (byte_offset < 0 || (byte_offset + byte_size) > m_byte_size)
+        {
+            throw BufferObjectException("ImmutableBufferObject::mapRange - given range out of buffer bounds");
+        }
+
+        return MappedRange<T>(m_name, byte_offset, byte_size, access);
+    }
+
+    template<typename T>
+    inline MappedRange<T> ImmutableBufferObject::map(GLbitfield access) const
+    {
+        return mapRange<T>(0, m_byte_size, access);
+    }
+
     inline void ImmutableBufferObject::copy(ImmutableBufferObject& src,
                                             ImmutableBufferObject& tgt,
                                             GLintptr               readOffset,
@@ -0,0 +1,312 @@
+/*
+ * IndexPacking.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_INDEXPACKING_HPP
+#define GLOWL_INDEXPACKING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Exceptions.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \struct IndexRange
+     *
+     * \brief Smallest and largest index of an index buffer. Empty (min_index > max_index) if there are no indices.
+     */
+    struct IndexRange
+    {
+        GLuint min_index = std::numeric_limits<GLuint>::max();
+        GLuint max_index = 0;
+
+        bool empty() const
+        {
+            return min_index > max_index;
+        }
+
+        void extend(IndexRange const& other)
+        {
+            min_index = std::min(min_index, other.min_index);
+            max_index = std::max(max_index, other.max_index);
+        }
+    };
+
+    /**
+     * \struct PackedIndexData
+     *
+     * \brief Result of packIndexData(). Holds indices in the narrowest index type that fits, and can be passed to the
+     * Mesh constructor directly.
+     *
+     * Indices may be rebased, i.e. stored relative to base_vertex, which is then added back by the draw call.
+     * The index range refers to the stored indices.
+     */
+    struct PackedIndexData
+    {
+        std::vector<GLubyte> index_data;
+        GLenum               index_type = GL_UNSIGNED_INT;
+        GLint                base_vertex = 0;
+        IndexRange           index_range;
+        std::size_t          unpacked_byte_size = 0;
+
+        std::size_t getIndexCount() const
+        {
+            std::size_t index_byte_size = computeByteSize(index_type);
+            return index_byte_size > 0 ? index_data.size() / index_byte_size : 0;
+        }
+    };
+
+    namespace detail
+    {
+        template<typename IndexType>
+        inline void computeIndexRangeScalar(IndexType const* indices, std::size_t count, IndexRange& range)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                range.min_index = std::min(range.min_index, static_cast<GLuint>(indices[i]));
+                range.max_index = std::max(range.max_index, static_cast<GLuint>(indices[i]));
+            }
+        }
+
+#if defined(__AVX2__)
+        inline __m256i minIndices(__m256i lhs, __m256i rhs, GLubyte)
+        {
+            return _mm256_min_epu8(lhs, rhs);
+        }
+
+        inline __m256i maxIndices(__m256i lhs, __m256i rhs, GLubyte)
+        {
+            return _mm256_max_epu8(lhs, rhs);
+        }
+
+        inline __m256i minIndices(__m256i lhs, __m256i rhs, GLushort)
+        {
+            return _mm256_min_epu16(lhs, rhs);
+        }
+
+        inline __m256i maxIndices(__m256i lhs, __m256i rhs, GLushort)
+        {
+            return _mm256_max_epu16(lhs, rhs);
+        }
+
+        inline __m256i minIndices(__m256i lhs, __m256i rhs, GLuint)
+        {
+            return _mm256_min_epu32(lhs, rhs);
+        }
+
+        inline __m256i maxIndices(__m256i lhs, __m256i rhs, GLuint)
+        {
+            return _mm256_max_epu32(lhs, rhs);
+        }
+#endif
+
+        template<typename IndexType>
+        inline IndexRange computeIndexRange(IndexType const* indices, std::size_t count)
+        {
+            IndexRange  retval;
+            std::size_t i = 0;
+
+#if defined(__AVX2__)
+            constexpr std::size_t lanes = 32 / sizeof(IndexType);
+            if (count >= lanes)
+            {
+                __m256i min_value = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(indices));
+                __m256i max_value = min_value;
+                for (i = lanes; i + lanes <= count; i += lanes)
+                {
+                    __m256i value = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(indices + i));
+                    min_value = minIndices(min_value, value, IndexType());
+                    max_value = maxIndices(max_value, value, IndexType());
+                }
+
+                IndexType lane_values[lanes];
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_values), min_value);
+                computeIndexRangeScalar(lane_values, lanes, retval);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_values), max_value);
+                computeIndexRangeScalar(lane_values, lanes, retval);
+            }
+#endif
+
+            computeIndexRangeScalar(indices + i, count - i, retval);
+
+            return retval;
+        }
+
+        template<typename SrcType, typename DstType>
+        inline void convertIndices(SrcType const* src, std::size_t count, GLuint offset, DstType* dst)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dst[i] = static_cast<DstType>(static_cast<GLuint>(src[i]) - offset);
+            }
+        }
+
+        template<typename SrcType>
+        inline void convertIndices(SrcType const* src, std::size_t count, GLuint offset, GLenum dst_type, GLubyte* dst)
+        {
+            switch (dst_type)
+            {
+            case GL_UNSIGNED_BYTE:
+                convertIndices(src, count, offset, dst);
+                break;
+            case GL_UNSIGNED_SHORT:
+                convertIndices(src, count, offset, reinterpret_cast<GLushort*>(dst));
+                break;
+            case GL_UNSIGNED_INT:
+                convertIndices(src, count, offset, reinterpret_cast<GLuint*>(dst));
+                break;
+            }
+        }
+    } // namespace detail
+
+    /**
+     * \brief Compute the smallest and largest index. Uses AVX2 if available.
+     */
+    inline IndexRange computeIndexRange(void const* index_data, std::size_t index_cnt, GLenum index_type)
+    {
+        switch (index_type)
+        {
+        case GL_UNSIGNED_BYTE:
+            return detail::computeIndexRange(static_cast<GLubyte const*>(index_data), index_cnt);
+        case GL_UNSIGNED_SHORT:
+            return detail::computeIndexRange(static_cast<GLushort const*>(index_data), index_cnt);
+        case GL_UNSIGNED_INT:
+            return detail::computeIndexRange(static_cast<GLuint const*>(index_data), index_cnt);
+        default:
+            throw MeshException("computeIndexRange - Invalid index type");
+        }
+    }
+
+    /**
+     * \brief Convert indices to the narrowest index type that can represent them.
+     *
+     * If rebasing is allowed and the index range does not fit the narrow type but its extent does, indices are stored
+     * relative to the smallest index and the base vertex is set accordingly. Primitive restart indices are not
+     * preserved.
+     *
+     * \param min_index_type Narrowest index type to use, e.g. GL_UNSIGNED_SHORT if byte indices are not desired
+     */
+    inline PackedIndexData packIndexData(void const* index_data,
+                                         std::size_t index_data_byte_size,
+                                         GLenum      index_type,
+                                         bool        allow_rebase = true,
+                                         GLenum      min_index_type = GL_UNSIGNED_BYTE)
+    {
+        for (GLenum type : {index_type, min_index_type})
+        {
+            if (type != GL_UNSIGNED_BYTE && type != GL_UNSIGNED_SHORT && type != GL_UNSIGNED_INT)
+            {
+                throw MeshException("packIndexData - Invalid index type");
+            }
+        }
+
+        std::size_t index_cnt = index_data_byte_size / computeByteSize(index_type);
+
+        PackedIndexData retval;
+        retval.unpacked_byte_size = index_data_byte_size;
+        retval.index_range = computeIndexRange(index_data, index_cnt, index_type);
+
+        GLuint offset = 0;
+        if (!retval.index_range.empty())
+        {
+            // for each type from narrow to wide, use it directly or, failing that, with rebased indices
+            GLenum const candidates[] = {GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_UNSIGNED_INT};
+            bool         found = false;
+            for (GLenum candidate : candidates)
+            {
+                if (found || computeByteSize(candidate) < computeByteSize(min_index_type))
+                {
+                    continue;
+                }
+
+                // narrow types keep their maximum value free, it is the fixed primitive restart index
+                GLuint max_value = candidate == GL_UNSIGNED_BYTE
+                                       ? 0xFEu
+                                       : (candidate == GL_UNSIGNED_SHORT ? 0xFFFEu : 0xFFFFFFFFu);
+                if (retval.index_range.max_index <= max_value)
+                {
+                    retval.index_type = candidate;
+                    found = true;
+                }
+                else if (allow_rebase && retval.index_range.max_index - retval.index_range.min_index <= max_value &&
+                         retval.index_range.min_index <= static_cast<GLuint>(std::numeric_limits<GLint>::max()))
+                {
+                    retval.index_type = candidate;
+                    offset = retval.index_range.min_index;
+                    found = true;
+                }
+            }
+
+            retval.base_vertex = static_cast<GLint>(offset);
+            retval.index_range.min_index -= offset;
+            retval.index_range.max_index -= offset;
+        }
+        else
+        {
+            retval.index_type = min_index_type;
+        }
+
+        retval.index_data.resize(index_cnt * computeByteSize(retval.index_type));
+        switch (index_type)
+        {
+        case GL_UNSIGNED_BYTE:
+            detail::convertIndices(static_cast<GLubyte const*>(index_data),
+                                   index_cnt,
+                                   offset,
+                                   retval.index_type,
+                                   retval.index_data.data());
+            break;
+        case GL_UNSIGNED_SHORT:
+            detail::convertIndices(static_cast<GLushort const*>(index_data),
+                                   index_cnt,
+                                   offset,
+                                   retval.index_type,
+                                   retval.index_data.data());
+            break;
+        case GL_UNSIGNED_INT:
+            detail::convertIndices(static_cast<GLuint const*>(index_data),
+                                   index_cnt,
+                                   offset,
+                                   retval.index_type,
+                                   retval.index_data.data());
+            break;
+        }
+
+        return retval;
+    }
+
+    /**
+     * \brief Convert indices to the narrowest index type that can represent them, see above.
+     */
+    template<typename IndexDataType>
+    inline PackedIndexData packIndexData(std::vector<IndexDataType> const& index_data,
+                                         GLenum                            index_type,
+                                         bool                              allow_rebase = true,
+                                         GLenum                            min_index_type = GL_UNSIGNED_BYTE)
+    {
+        return packIndexData(index_data.data(),
+                             index_data.size() * sizeof(IndexDataType),
+                             index_type,
+                             allow_rebase,
+                             min_index_type);
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_INDEXPACKING_HPP
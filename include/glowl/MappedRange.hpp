@@ -0,0 +1,210 @@
+/*
+ * MappedRange.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MAPPEDRANGE_HPP
+#define GLOWL_MAPPEDRANGE_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "Exceptions.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class MappedRange
+     *
+     * \brief Typed, span-like view of a mapped buffer range. The range is unmapped on destruction.
+     *
+     * Obtained via BufferObject::mapRange or ImmutableBufferObject::mapRange. Allows writing directly into driver
+     * memory instead of staging data in a CPU-side container first.
+     * If mapped with GL_MAP_FLUSH_EXPLICIT_BIT, modified sub-ranges have to be flushed using flush() before unmapping.
+     *
+     * \author Michael Becher
+     */
+    template<typename T>
+    class MappedRange
+    {
+    public:
+        using value_type = T;
+        using iterator = T*;
+
+        /**
+         * \brief Maps byte_size bytes starting at byte_offset of the given buffer.
+         *
+         * Note: Bounds are not checked here, use the mapRange methods of the buffer classes.
+         */
+        MappedRange(GLuint buffer, GLintptr byte_offset, GLsizeiptr byte_size, GLbitfield access);
+
+        ~MappedRange();
+
+        MappedRange(const MappedRange&) = delete;
+        MappedRange(MappedRange&& other) noexcept;
+        MappedRange& operator=(MappedRange&& rhs) noexcept;
+        MappedRange& operator=(const MappedRange&) = delete;
+
+        T* data() const
+        {
+            return m_data;
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        T& operator[](std::size_t idx) const
+        {
+            return m_data[idx];
+        }
+
+        iterator begin() const
+        {
+            return m_data;
+        }
+
+        iterator end() const
+        {
+            return m_data + m_size;
+        }
+
+        /**
+         * \brief Byte offset of the mapped range within the buffer.
+         */
+        GLintptr getByteOffset() const
+        {
+            return m_byte_offset;
+        }
+
+        /**
+         * \brief Flush the whole mapped range. Requires GL_MAP_FLUSH_EXPLICIT_BIT.
+         */
+        void flush();
+
+        /**
+         * \brief Flush count elements starting at element first. Requires GL_MAP_FLUSH_EXPLICIT_BIT.
+         */
+        void flush(std::size_t first, std::size_t count);
+
+        /**
+         * \brief Unmap the range before destruction.
+         * \return Returns false if the buffer content became corrupt while mapped, true otherwise.
+         */
+        bool unmap();
+
+    private:
+        GLuint      m_buffer;
+        GLintptr    m_byte_offset;
+        T*          m_data;
+        std::size_t m_size;
+        GLbitfield  m_access;
+    };
+
+    template<typename T>
+    inline MappedRange<T>::MappedRange(GLuint buffer, GLintptr byte_offset, GLsizeiptr byte_size, GLbitfield access)
+        : m_buffer(buffer),
+          m_byte_offset(byte_offset),
+          m_data(nullptr),
+          m_size(static_cast<std::size_t>(byte_size) / sizeof(T)),
+          m_access(access)
+    {
+        if ((static_cast<std::size_t>(byte_size) % sizeof(T)) != 0)
+        {
+            throw BufferObjectException("MappedRange::MappedRange - byte size is not a multiple of the element size");
+        }
+
+        m_data = static_cast<T*>(glMapNamedBufferRange(m_buffer, m_byte_offset, byte_size, m_access));
+
+        if (m_data == nullptr)
+        {
+            m_buffer = 0;
+            throw BufferObjectException("MappedRange::MappedRange - OpenGL error " + std::to_string(glGetError()));
+        }
+    }
+
+    template<typename T>
+    inline MappedRange<T>::~MappedRange()
+    {
+        unmap();
+    }
+
+    template<typename T>
+    inline MappedRange<T>::MappedRange(MappedRange&& other) noexcept
+        : m_buffer(std::exchange(other.m_buffer, 0)),
+          m_byte_offset(other.m_byte_offset),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_access(other.m_access)
+    {
+    }
+
+    template<typename T>
+    inline MappedRange<T>& MappedRange<T>::operator=(MappedRange&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            unmap();
+            m_buffer = std::exchange(rhs.m_buffer, 0);
+            m_byte_offset = rhs.m_byte_offset;
+            m_data = std::exchange(rhs.m_data, nullptr);
+            m_size = std::exchange(rhs.m_size, 0);
+            m_access = rhs.m_access;
+        }
+        return *this;
+    }
+
+    template<typename T>
+    inline void MappedRange<T>::flush()
+    {
+        flush(0, m_size);
+    }
+
+    template<typename T>
+    inline void MappedRange<T>::flush(std::size_t first, std::size_t count)
+    {
+        if ((m_access & GL_MAP_FLUSH_EXPLICIT_BIT) == 0)
+        {
+            throw BufferObjectException("MappedRange::flush - range not mapped with GL_MAP_FLUSH_EXPLICIT_BIT");
+        }
+        if ((first + count) > m_size)
+        {
+            throw BufferObjectException("MappedRange::flush - flush range out of bounds");
+        }
+
+        // offset is relative to the start of the mapped range
+        glFlushMappedNamedBufferRange(m_buffer,
+                                      static_cast<GLintptr>(first * sizeof(T)),
+                                      static_cast<GLsizeiptr>(count * sizeof(T)));
+    }
+
+    template<typename T>
+    inline bool MappedRange<T>::unmap()
+    {
+        bool retval = true;
+
+        if (m_data != nullptr)
+        {
+            retval = glUnmapNamedBuffer(m_buffer) == GL_TRUE;
+            m_buffer = 0;
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        return retval;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MAPPEDRANGE_HPP
@@ -8,12 +8,20 @@
 #ifndef GLOWL_MESH_HPP
 #define GLOWL_MESH_HPP
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "BoundingVolumes.hpp"
 #include "BufferObject.hpp"
+#include "IndexPacking.hpp"
+#include "MeshLod.hpp"
+#include "NamePool.hpp"
+#include "VertexArrayCache.hpp"
 #include "VertexLayout.hpp"
+#include "VertexPacking.hpp"
 #include "glinclude.h"
 
 namespace glowl
@@ -39,6 +47,9 @@ namespace glowl
      *
      * \brief Encapsulates mesh functionality.
      *
+     * Bounds are computed on the CPU from the position attribute (see findPositionLayout()) whenever position data
+     * is passed to the mesh. They only grow on partial updates and removals, so they stay conservative.
+     *
      * \author Michael Becher
      */
     class Mesh
@@ -59,6 +70,9 @@ namespace glowl
         /**
          * \brief Mesh constructor that requires data pointers and byte sizes as input.
          *
+         * \param buffer_pool Optional name pool for the vertex and index buffers (same for all constructors)
+         * \param vertex_array_pool Optional name pool for the vertex array (same for all constructors)
+         *
          * Note: Active OpenGL context required for construction.
          * Use std::unqiue_ptr (or shared_ptr) for delayed construction of class member variables of this type.
          */
@@ -69,7 +83,9 @@ namespace glowl
              std::size_t const                index_data_byte_size,
              GLenum const                     index_type = GL_UNSIGNED_INT,
              GLenum const                     primitive_type = GL_TRIANGLES,
-             GLenum const                     usage = GL_STATIC_DRAW);
+             GLenum const                     usage = GL_STATIC_DRAW,
+             NamePool*                        buffer_pool = nullptr,
+             NamePool*                        vertex_array_pool = nullptr);
 
         /**
          * \brief Mesh constructor that requires data pointers and byte sizes as input.
@@ -85,7 +101,9 @@ namespace glowl
              std::size_t const        index_data_byte_size,
              GLenum const             index_type = GL_UNSIGNED_INT,
              GLenum const             primitive_type = GL_TRIANGLES,
-             GLenum const             usage = GL_STATIC_DRAW);
+             GLenum const             usage = GL_STATIC_DRAW,
+             NamePool*                buffer_pool = nullptr,
+             NamePool*                vertex_array_pool = nullptr);
 
         /**
          * \brief Mesh constructor that requires data in std vectors as input.
@@ -99,7 +117,9 @@ namespace glowl
              std::vector<IndexDataType> const&               index_data,
              GLenum const                                    index_type = GL_UNSIGNED_INT,
              GLenum const                                    primitive_type = GL_TRIANGLES,
-             GLenum const                                    usage = GL_STATIC_DRAW);
+             GLenum const                                    usage = GL_STATIC_DRAW,
+             NamePool*                                       buffer_pool = nullptr,
+             NamePool*                                       vertex_array_pool = nullptr);
 
         /**
          * \brief Mesh constructor that requires data in std vectors as input.
@@ -115,18 +135,87 @@ namespace glowl
              std::vector<IndexDataType> const&     index_data,
              GLenum const                          index_type = GL_UNSIGNED_INT,
              GLenum const                          primitive_type = GL_TRIANGLES,
-             GLenum const                          usage = GL_STATIC_DRAW);
+             GLenum const                          usage = GL_STATIC_DRAW,
+             NamePool*                             buffer_pool = nullptr,
+             NamePool*                             vertex_array_pool = nullptr);
+
+        /**
+         * \brief Mesh constructor that uses packed vertex data as input, see packVertexData().
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unqiue_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        Mesh(PackedVertexData const& vertex_data,
+             void const*             index_data,
+             std::size_t const       index_data_byte_size,
+             GLenum const            index_type = GL_UNSIGNED_INT,
+             GLenum const            primitive_type = GL_TRIANGLES,
+             GLenum const            usage = GL_STATIC_DRAW,
+             NamePool*               buffer_pool = nullptr,
+             NamePool*               vertex_array_pool = nullptr);
+
+        /**
+         * \brief Mesh constructor that uses narrowed (and possibly rebased) indices as input, see packIndexData().
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unqiue_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        Mesh(std::vector<void const*> const&  vertex_data,
+             std::vector<std::size_t> const&  vertex_data_byte_sizes,
+             std::vector<VertexLayout> const& vertex_descriptor,
+             PackedIndexData const&           index_data,
+             GLenum const                     primitive_type = GL_TRIANGLES,
+             GLenum const                     usage = GL_STATIC_DRAW,
+             NamePool*                        buffer_pool = nullptr,
+             NamePool*                        vertex_array_pool = nullptr);
+
+        /**
+         * \brief Mesh constructor for levels of detail, see buildLodChain(). All levels share the vertex buffers and
+         * are stored (narrowed, see packIndexData()) in the index buffer. draw() renders level 0, use drawLod() for
+         * other levels.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unqiue_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        Mesh(std::vector<void const*> const&  vertex_data,
+             std::vector<std::size_t> const&  vertex_data_byte_sizes,
+             std::vector<VertexLayout> const& vertex_descriptor,
+             LodChain const&                  lod_chain,
+             GLenum const                     usage = GL_STATIC_DRAW,
+             NamePool*                        buffer_pool = nullptr,
+             NamePool*                        vertex_array_pool = nullptr);
+
+        /**
+         * \brief Mesh constructor for dynamic meshes. Creates empty buffers with capacity for the given number of
+         * vertices and indices, content is added with appendVertexData() and appendIndexData().
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unqiue_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        Mesh(std::vector<VertexLayout> const& vertex_descriptor,
+             GLuint const                     vertex_capacity,
+             GLuint const                     index_capacity,
+             GLenum const                     index_type = GL_UNSIGNED_INT,
+             GLenum const                     primitive_type = GL_TRIANGLES,
+             GLenum const                     usage = GL_DYNAMIC_DRAW,
+             NamePool*                        buffer_pool = nullptr,
+             NamePool*                        vertex_array_pool = nullptr);
 
         ~Mesh()
         {
-            glDeleteVertexArrays(1, &m_va_handle);
+            releaseVertexArray();
         }
 
         Mesh(const Mesh& cpy) = delete;
-        Mesh(Mesh&& other) = delete;
-        Mesh& operator=(Mesh&& rhs) = delete;
         Mesh& operator=(const Mesh& rhs) = delete;
 
+        /**
+         * \brief Move constructor. Takes over vertex array and buffers, the moved-from mesh is left empty.
+         */
+        Mesh(Mesh&& other) noexcept;
+
+        Mesh& operator=(Mesh&& rhs) noexcept;
+
         template<typename VertexDataType>
         void bufferVertexSubData(std::size_t                        vbo_idx,
                                  std::vector<VertexDataType> const& vertices,
@@ -139,33 +228,221 @@ namespace glowl
 
         void bufferIndexSubData(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset);
 
+        /**
+         * \brief Replace the content of a vertex buffer. Storage is only reallocated if the data exceeds its capacity.
+         */
+        template<typename VertexDataType>
+        void rebufferVertexData(std::size_t vbo_idx, std::vector<VertexDataType> const& vertices);
+
+        void rebufferVertexData(std::size_t vbo_idx, GLvoid const* data, GLsizeiptr byte_size);
+
+        /**
+         * \brief Replace the content of the index buffer and update the indices count accordingly. Removes levels of
+         * detail.
+         */
+        template<typename IndexDataType>
+        void rebufferIndexData(std::vector<IndexDataType> const& indices);
+
+        void rebufferIndexData(GLvoid const* data, GLsizeiptr byte_size);
+
+        /**
+         * \brief Replace the content of the index buffer, adopting index type and base vertex of the packed indices.
+         */
+        void rebufferIndexData(PackedIndexData const& index_data);
+
+        /**
+         * \brief Add a vertex buffer with per-instance data, e.g. transforms that are streamed every frame with
+         * streamInstanceData(). The layout's divisor has to be > 0, attribute indices continue after those of the
+         * existing vertex buffers.
+         *
+         * \return Returns the index of the new vertex buffer.
+         */
+        std::size_t addInstanceBuffer(VertexLayout const& instance_layout,
+                                      GLsizeiptr          byte_capacity = 0,
+                                      GLenum              usage = GL_STREAM_DRAW);
+
+        /**
+         * \brief Replace the content of an instance buffer. The previous content is invalidated first, so that the
+         * driver can provide fresh storage instead of waiting for pending draws that still read it.
+         */
+        template<typename InstanceDataType>
+        void streamInstanceData(std::size_t vbo_idx, std::vector<InstanceDataType> const& instances);
+
+        void streamInstanceData(std::size_t vbo_idx, GLvoid const* data, GLsizeiptr byte_size);
+
+        /**
+         * \brief Append vertices to all per-vertex buffers (divisor 0), growing their capacity geometrically if
+         * required. Existing content stays on the GPU and the vertex array is updated if storage is reallocated.
+         *
+         * \param vertex_data One pointer per per-vertex buffer in order, all covering the same number of vertices
+         *
+         * \return Returns the index of the first appended vertex.
+         */
+        GLuint appendVertexData(std::vector<void const*> const& vertex_data,
+                                std::vector<std::size_t> const& vertex_data_byte_sizes);
+
+        template<typename VertexDataType>
+        GLuint appendVertexData(std::vector<std::vector<VertexDataType>> const& vertex_data);
+
+        /**
+         * \brief Append indices to the index buffer, growing its capacity geometrically if required. Removes levels
+         * of detail.
+         *
+         * \return Returns the position of the first appended index, e.g. for drawing only the appended range.
+         */
+        GLuint appendIndexData(GLvoid const* data, GLsizeiptr byte_size);
+
+        template<typename IndexDataType>
+        GLuint appendIndexData(std::vector<IndexDataType> const& indices);
+
+        /**
+         * \brief Remove vertices by moving the last vertices of each per-vertex buffer into the gap. Capacity is
+         * kept. Indices referencing moved vertices are not updated.
+         *
+         * \return Returns the number of vertices that were moved from the end of the buffers to first_vertex.
+         */
+        GLuint removeVertexRange(GLuint first_vertex, GLuint vertex_cnt);
+
+        /**
+         * \brief Remove indices by moving the last indices into the gap, which changes the primitive order. Only
+         * meaningful for list primitive types and whole primitives. Capacity is kept, levels of detail are removed.
+         *
+         * \return Returns the number of indices that were moved from the end of the buffer to first_index.
+         */
+        GLuint removeIndexRange(GLuint first_index, GLuint index_cnt);
+
+        /**
+         * \brief Reserve vertex buffer storage, keeping existing content. Updates the vertex array if required.
+         */
+        void reserveVertexBuffer(std::size_t vbo_idx, GLsizeiptr byte_capacity);
+
+        /**
+         * \brief Reserve index buffer storage, keeping existing content. Updates the vertex array if required.
+         */
+        void reserveIndexBuffer(GLsizeiptr byte_capacity);
+
+        /**
+         * \brief Release unused capacity of all buffers. Updates the vertex array if required.
+         */
+        void shrinkToFit();
+
+        /**
+         * \brief Use a vertex array shared with all meshes of identical vertex layouts instead of a dedicated one.
+         * Pass nullptr to go back to a dedicated vertex array. The cache has to outlive the mesh.
+         */
+        void setVertexArrayCache(VertexArrayCache* vertex_array_cache);
+
+        /**
+         * \brief Bind the vertex array. A shared vertex array (see setVertexArrayCache()) gets the mesh's buffers
+         * attached if required.
+         */
         void bindVertexArray() const
         {
             glBindVertexArray(m_va_handle);
+            if (m_va_cache != nullptr)
+            {
+                m_va_cache->attachBuffers(m_va_handle, m_vbos, m_ibo);
+            }
         }
 
         /**
          * Draw function for your conveniences.
-         * If you need/want to work with sth. different from glDrawElementsInstanced,
-         * use bindVertexArray() and do your own thing.
+         * Uses glDrawRangeElementsBaseVertex for single instances if the index range is known and
+         * glDrawElementsInstancedBaseVertex otherwise. If you need/want to work with sth. different,
+         * use bindVertexArray() and do your own thing. Meshes with levels of detail draw level 0.
+         * Meshes with a shared vertex array leave it bound within a batch (see VertexArrayCache::beginBatch()), so
+         * consecutive draws of meshes with identical vertex layouts avoid re-binding.
          */
         void draw(GLsizei instance_cnt = 1)
         {
-            glBindVertexArray(m_va_handle);
-            glDrawElementsInstanced(m_primitive_type, m_indices_cnt, m_index_type, nullptr, instance_cnt);
-            glBindVertexArray(0);
+            drawElements(0, m_lod_levels.empty() ? m_indices_cnt : m_lod_levels.front().index_cnt, instance_cnt);
         }
 
+        /**
+         * \brief Draw the given level of detail, see selectLodLevel().
+         */
+        void drawLod(std::size_t level, GLsizei instance_cnt = 1);
+
+        /**
+         * \brief Select the coarsest level of detail whose projected error stays within max_screen_error pixels.
+         *
+         * \param distance Distance between camera and the (closest point of the) mesh
+         * \param projection_scale See computeLodProjectionScale()
+         */
+        std::size_t selectLodLevel(GLfloat distance, GLfloat projection_scale, GLfloat max_screen_error = 1.0f) const
+        {
+            return glowl::selectLodLevel(m_lod_levels, distance, projection_scale, max_screen_error);
+        }
+
+        std::vector<LodLevel> const& getLodLevels() const
+        {
+            return m_lod_levels;
+        }
+
+        /**
+         * \brief Set the levels of detail of the index buffer, e.g. when restoring a mesh from a cache. Throws if a
+         * level exceeds the index count.
+         */
+        void setLodLevels(std::vector<LodLevel> const& lod_levels);
+
         std::vector<VertexLayout> getVertexLayouts() const
         {
             return m_vertex_descriptor;
         }
 
+        /**
+         * \brief Returns the bounding box of the positions, empty if the position type is not supported by
+         * computeBounds().
+         */
+        BoundingBox const& getBoundingBox() const
+        {
+            return m_bounds.box;
+        }
+
+        /**
+         * \brief Returns the bounding sphere of the positions, empty if the position type is not supported by
+         * computeBounds().
+         */
+        BoundingSphere const& getBoundingSphere() const
+        {
+            return m_bounds.sphere;
+        }
+
         GLuint getIndicesCount() const
         {
             return m_indices_cnt;
         }
 
+        /**
+         * \brief Returns the number of vertices, derived from the byte size of the first per-vertex buffer.
+         */
+        GLuint getVertexCount() const
+        {
+            for (std::size_t i = 0; i < m_vbos.size(); ++i)
+            {
+                if (m_vertex_descriptor[i].divisor == 0)
+                {
+                    GLsizei stride = m_vertex_descriptor[i].stride;
+                    return stride > 0 ? static_cast<GLuint>(m_vbos[i].getByteSize() / stride) : 0;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * \brief Returns the number of instances covered by the content of an instance buffer.
+         */
+        GLuint getInstanceCount(std::size_t vbo_idx) const
+        {
+            if (vbo_idx >= m_vbos.size() || m_vertex_descriptor[vbo_idx].divisor == 0 ||
+                m_vertex_descriptor[vbo_idx].stride == 0)
+            {
+                return 0;
+            }
+            return static_cast<GLuint>(m_vbos[vbo_idx].getByteSize() / m_vertex_descriptor[vbo_idx].stride) *
+                   m_vertex_descriptor[vbo_idx].divisor;
+        }
+
         GLenum getIndexType() const
         {
             return m_index_type;
@@ -176,10 +453,60 @@ namespace glowl
             return m_primitive_type;
         }
 
+        /**
+         * \brief Returns the value added to each index when drawing, non-zero for rebased indices.
+         */
+        GLint getBaseVertex() const
+        {
+            return m_base_vertex;
+        }
+
+        /**
+         * \brief Set the value added to each index when drawing, e.g. for rebased indices from a mesh cache.
+         */
+        void setBaseVertex(GLint base_vertex)
+        {
+            m_base_vertex = base_vertex;
+        }
+
+        /**
+         * \brief Returns the range of the stored indices (before adding the base vertex). Indices written with
+         * bufferIndexSubData() only extend the range. Empty if unknown.
+         */
+        IndexRange getIndexRange() const
+        {
+            return m_index_range_valid ? m_index_range : IndexRange();
+        }
+
+        /**
+         * \brief Forget the tracked index range, e.g. after writing indices through mapRange(), raw GL calls or
+         * compute shaders. The range stays unknown until the next rebufferIndexData().
+         */
+        void invalidateIndexRange()
+        {
+            m_index_range = IndexRange();
+            m_index_range_valid = false;
+        }
+
+        /**
+         * \brief Pass the tracked index range to glDrawRangeElementsBaseVertex for single instance draws. Disabled by
+         * default. Only enable if all index writes go through this class or are followed by invalidateIndexRange(),
+         * since indices outside of the range are undefined behaviour.
+         */
+        void setIndexRangeHintEnabled(bool enabled)
+        {
+            m_index_range_hint = enabled;
+        }
+
+        bool isIndexRangeHintEnabled() const
+        {
+            return m_index_range_hint;
+        }
+
         GLsizeiptr getVertexBufferByteSize(std::size_t vbo_idx) const
         {
             if (vbo_idx < m_vbos.size())
-                return m_vbos[vbo_idx]->getByteSize();
+                return m_vbos[vbo_idx].getByteSize();
             else
                 return 0;
             // TODO: log some kind of error?
@@ -190,7 +517,7 @@ namespace glowl
             return m_ibo.getByteSize();
         }
 
-        std::vector<BufferObjectPtr> const& getVbos() const
+        std::vector<BufferObject> const& getVbos() const
         {
             return m_vbos;
         }
@@ -201,19 +528,38 @@ namespace glowl
         }
 
     private:
-        GLuint                       m_va_handle;
-        std::vector<BufferObjectPtr> m_vbos;
-        BufferObject                 m_ibo;
+        GLuint                    m_va_handle;
+        NamePool*                 m_va_pool;
+        NamePool*                 m_buffer_pool;
+        VertexArrayCache*         m_va_cache;
+        std::vector<BufferObject> m_vbos;
+        BufferObject              m_ibo;
 
         std::vector<VertexLayout> m_vertex_descriptor;
 
-        GLuint m_indices_cnt;
-        GLenum m_index_type;
-        GLenum m_primitive_type;
-        GLenum m_usage;
+        GLuint     m_indices_cnt;
+        GLenum     m_index_type;
+        GLint      m_base_vertex;
+        IndexRange m_index_range;
+        bool       m_index_range_valid;
+        bool       m_index_range_hint;
+        GLenum     m_primitive_type;
+        GLenum     m_usage;
+
+        std::vector<LodLevel> m_lod_levels;
+
+        Bounds m_bounds;
 
         void createVertexArray();
+        void releaseVertexArray();
+        void updateVertexArrayBuffers();
         void setIndicesCount(GLuint index_data_byte_size);
+        void extendIndexRange(GLvoid const* index_data, GLsizeiptr index_data_byte_size);
+        void drawElements(GLuint first_index, GLuint index_cnt, GLsizei instance_cnt);
+        void updateVertexArrayIfReallocated(std::vector<GLuint> const& previous_names);
+        void extendBounds(std::size_t vbo_idx, GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset);
+        std::vector<GLuint> getBufferNames() const;
+        static GLsizeiptr swapRemove(BufferObject& buffer, GLsizeiptr byte_offset, GLsizeiptr byte_size);
         void checkError();
     };
 
@@ -224,12 +570,21 @@ namespace glowl
                       std::size_t const                index_data_byte_size,
                       GLenum const                     index_type,
                       GLenum const                     primitive_type,
-                      GLenum const                     usage)
+                      GLenum const                     usage,
+                      NamePool*                        buffer_pool,
+                      NamePool*                        vertex_array_pool)
         : m_va_handle(0),
-          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, index_data_byte_size, usage),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
+          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, index_data_byte_size, usage, buffer_pool),
           m_vertex_descriptor(vertex_descriptor),
           m_indices_cnt(0),
           m_index_type(index_type),
+          m_base_vertex(0),
+          m_index_range(),
+          m_index_range_valid(true),
+          m_index_range_hint(false),
           m_primitive_type(primitive_type),
           m_usage(usage)
     {
@@ -240,12 +595,13 @@ namespace glowl
 
         for (unsigned int i = 0; i < vertex_data.size(); ++i)
         {
-            m_vbos.emplace_back(
-                std::make_unique<BufferObject>(GL_ARRAY_BUFFER, vertex_data[i], vertex_data_byte_sizes[i], usage));
+            m_vbos.emplace_back(GL_ARRAY_BUFFER, vertex_data[i], vertex_data_byte_sizes[i], usage, buffer_pool);
+            extendBounds(i, vertex_data[i], static_cast<GLsizeiptr>(vertex_data_byte_sizes[i]), 0);
         }
 
         createVertexArray();
         setIndicesCount(static_cast<GLuint>(index_data_byte_size));
+        extendIndexRange(index_data, static_cast<GLsizeiptr>(index_data_byte_size));
 
         checkError();
     }
@@ -255,26 +611,38 @@ namespace glowl
                       std::size_t const        index_data_byte_size,
                       GLenum const             index_type,
                       GLenum const             primitive_type,
-                      GLenum const             usage)
+                      GLenum const             usage,
+                      NamePool*                buffer_pool,
+                      NamePool*                vertex_array_pool)
         : m_va_handle(0),
-          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, index_data_byte_size, usage),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
+          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, index_data_byte_size, usage, buffer_pool),
           m_vertex_descriptor(),
           m_indices_cnt(0),
           m_index_type(index_type),
+          m_base_vertex(0),
+          m_index_range(),
+          m_index_range_valid(true),
+          m_index_range_hint(false),
           m_primitive_type(primitive_type),
           m_usage(usage)
     {
         for (unsigned int i = 0; i < vertex_data.size(); ++i)
         {
-            m_vbos.emplace_back(std::make_unique<BufferObject>(GL_ARRAY_BUFFER,
-                                                               std::get<0>(vertex_data[i]),
-                                                               std::get<1>(vertex_data[i]),
-                                                               usage));
+            m_vbos.emplace_back(GL_ARRAY_BUFFER,
+                                std::get<0>(vertex_data[i]),
+                                std::get<1>(vertex_data[i]),
+                                usage,
+                                buffer_pool);
             m_vertex_descriptor.push_back(std::get<2>(vertex_data[i]));
+            extendBounds(i, std::get<0>(vertex_data[i]), static_cast<GLsizeiptr>(std::get<1>(vertex_data[i])), 0);
         }
 
         createVertexArray();
         setIndicesCount(static_cast<GLuint>(index_data_byte_size));
+        extendIndexRange(index_data, static_cast<GLsizeiptr>(index_data_byte_size));
 
         checkError();
     }
@@ -285,14 +653,24 @@ namespace glowl
                       std::vector<IndexDataType> const&               index_data,
                       GLenum const                                    index_type,
                       GLenum const                                    primitive_type,
-                      GLenum const                                    usage)
+                      GLenum const                                    usage,
+                      NamePool*                                       buffer_pool,
+                      NamePool*                                       vertex_array_pool)
         : m_va_handle(0),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
           m_ibo(GL_ELEMENT_ARRAY_BUFFER,
                 index_data,
-                usage), // TODO ibo generation in constructor might fail? needs a bound vao?
+                usage,
+                buffer_pool), // TODO ibo generation in constructor might fail? needs a bound vao?
           m_vertex_descriptor(vertex_descriptor),
           m_indices_cnt(0),
           m_index_type(index_type),
+          m_base_vertex(0),
+          m_index_range(),
+          m_index_range_valid(true),
+          m_index_range_hint(false),
           m_primitive_type(primitive_type),
           m_usage(usage)
     {
@@ -303,7 +681,11 @@ namespace glowl
 
         for (unsigned int i = 0; i < vertex_data.size(); ++i)
         {
-            m_vbos.emplace_back(std::make_unique<BufferObject>(GL_ARRAY_BUFFER, vertex_data[i], m_usage));
+            m_vbos.emplace_back(GL_ARRAY_BUFFER, vertex_data[i], m_usage, buffer_pool);
+            extendBounds(i,
+                         vertex_data[i].data(),
+                         static_cast<GLsizeiptr>(vertex_data[i].size() * sizeof(VertexDataType)),
+                         0);
         }
 
         createVertexArray();
@@ -311,6 +693,7 @@ namespace glowl
         GLuint vi_size =
             static_cast<GLuint>(index_data.size() * sizeof(typename std::vector<IndexDataType>::value_type));
         setIndicesCount(vi_size);
+        extendIndexRange(index_data.data(), static_cast<GLsizeiptr>(vi_size));
 
         checkError();
     }
@@ -320,18 +703,31 @@ namespace glowl
                       std::vector<IndexDataType> const&     index_data,
                       GLenum const                          index_type,
                       GLenum const                          primitive_type,
-                      GLenum const                          usage)
+                      GLenum const                          usage,
+                      NamePool*                             buffer_pool,
+                      NamePool*                             vertex_array_pool)
         : m_va_handle(0),
-          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, usage),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
+          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data, usage, buffer_pool),
           m_indices_cnt(0),
           m_index_type(index_type),
+          m_base_vertex(0),
+          m_index_range(),
+          m_index_range_valid(true),
+          m_index_range_hint(false),
           m_primitive_type(primitive_type),
           m_usage(usage)
     {
         for (auto const& vertex_data : vertex_data_list)
         {
-            m_vbos.emplace_back(std::make_unique<BufferObject>(GL_ARRAY_BUFFER, vertex_data.first, m_usage));
+            m_vbos.emplace_back(GL_ARRAY_BUFFER, vertex_data.first, m_usage, buffer_pool);
             m_vertex_descriptor.push_back(vertex_data.second);
+            extendBounds(m_vbos.size() - 1,
+                         vertex_data.first.data(),
+                         static_cast<GLsizeiptr>(vertex_data.first.size() * sizeof(VertexDataType)),
+                         0);
         }
 
         createVertexArray();
@@ -339,20 +735,187 @@ namespace glowl
         GLuint vi_size =
             static_cast<GLuint>(index_data.size() * sizeof(typename std::vector<IndexDataType>::value_type));
         setIndicesCount(vi_size);
+        extendIndexRange(index_data.data(), static_cast<GLsizeiptr>(vi_size));
+
+        checkError();
+    }
+
+    inline Mesh::Mesh(PackedVertexData const& vertex_data,
+                      void const*             index_data,
+                      std::size_t const       index_data_byte_size,
+                      GLenum const            index_type,
+                      GLenum const            primitive_type,
+                      GLenum const            usage,
+                      NamePool*               buffer_pool,
+                      NamePool*               vertex_array_pool)
+        : Mesh(vertex_data.getDataPointers(),
+               vertex_data.getByteSizes(),
+               vertex_data.vertex_descriptor,
+               index_data,
+               index_data_byte_size,
+               index_type,
+               primitive_type,
+               usage,
+               buffer_pool,
+               vertex_array_pool)
+    {
+    }
+
+    inline Mesh::Mesh(std::vector<void const*> const&  vertex_data,
+                      std::vector<std::size_t> const&  vertex_data_byte_sizes,
+                      std::vector<VertexLayout> const& vertex_descriptor,
+                      PackedIndexData const&           index_data,
+                      GLenum const                     primitive_type,
+                      GLenum const                     usage,
+                      NamePool*                        buffer_pool,
+                      NamePool*                        vertex_array_pool)
+        : m_va_handle(0),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
+          m_ibo(GL_ELEMENT_ARRAY_BUFFER, index_data.index_data, usage, buffer_pool),
+          m_vertex_descriptor(vertex_descriptor),
+          m_indices_cnt(0),
+          m_index_type(index_data.index_type),
+          m_base_vertex(index_data.base_vertex),
+          m_index_range(index_data.index_range), // already known, no need to scan the indices again
+          m_index_range_valid(true),
+          m_index_range_hint(false),
+          m_primitive_type(primitive_type),
+          m_usage(usage)
+    {
+        if (vertex_data.size() != vertex_data_byte_sizes.size() || vertex_data.size() != vertex_descriptor.size())
+        {
+            throw std::invalid_argument("Mesh::Mesh - Vector parameters of different size!");
+        }
+
+        for (unsigned int i = 0; i < vertex_data.size(); ++i)
+        {
+            m_vbos.emplace_back(GL_ARRAY_BUFFER, vertex_data[i], vertex_data_byte_sizes[i], usage, buffer_pool);
+            extendBounds(i, vertex_data[i], static_cast<GLsizeiptr>(vertex_data_byte_sizes[i]), 0);
+        }
+
+        createVertexArray();
+        setIndicesCount(static_cast<GLuint>(index_data.index_data.size()));
 
         checkError();
     }
 
+    inline Mesh::Mesh(std::vector<void const*> const&  vertex_data,
+                      std::vector<std::size_t> const&  vertex_data_byte_sizes,
+                      std::vector<VertexLayout> const& vertex_descriptor,
+                      LodChain const&                  lod_chain,
+                      GLenum const                     usage,
+                      NamePool*                        buffer_pool,
+                      NamePool*                        vertex_array_pool)
+        : Mesh(vertex_data,
+               vertex_data_byte_sizes,
+               vertex_descriptor,
+               packIndexData(lod_chain.index_data, GL_UNSIGNED_INT),
+               GL_TRIANGLES,
+               usage,
+               buffer_pool,
+               vertex_array_pool)
+    {
+        m_lod_levels = lod_chain.levels;
+    }
+
+    inline Mesh::Mesh(std::vector<VertexLayout> const& vertex_descriptor,
+                      GLuint const                     vertex_capacity,
+                      GLuint const                     index_capacity,
+                      GLenum const                     index_type,
+                      GLenum const                     primitive_type,
+                      GLenum const                     usage,
+                      NamePool*                        buffer_pool,
+                      NamePool*                        vertex_array_pool)
+        : m_va_handle(0),
+          m_va_pool(vertex_array_pool),
+          m_buffer_pool(buffer_pool),
+          m_va_cache(nullptr),
+          m_ibo(GL_ELEMENT_ARRAY_BUFFER, nullptr, 0, usage, buffer_pool),
+          m_vertex_descriptor(vertex_descriptor),
+          m_indices_cnt(0),
+          m_index_type(index_type),
+          m_base_vertex(0),
+          m_index_range(),
+          m_index_range_valid(true),
+          m_index_range_hint(false),
+          m_primitive_type(primitive_type),
+          m_usage(usage)
+    {
+        if (index_type != GL_UNSIGNED_BYTE && index_type != GL_UNSIGNED_SHORT && index_type != GL_UNSIGNED_INT)
+        {
+            throw MeshException("Mesh::Mesh - Invalid index type");
+        }
+
+        for (auto const& vertex_layout : vertex_descriptor)
+        {
+            m_vbos.emplace_back(GL_ARRAY_BUFFER, nullptr, 0, usage, buffer_pool);
+            m_vbos.back().reserve(static_cast<GLsizeiptr>(vertex_capacity) * vertex_layout.stride);
+        }
+        m_ibo.reserve(static_cast<GLsizeiptr>(index_capacity * computeByteSize(index_type)));
+
+        createVertexArray();
+
+        checkError();
+    }
+
+    inline Mesh::Mesh(Mesh&& other) noexcept
+        : m_va_handle(std::exchange(other.m_va_handle, 0)),
+          m_va_pool(other.m_va_pool),
+          m_buffer_pool(other.m_buffer_pool),
+          m_va_cache(std::exchange(other.m_va_cache, nullptr)),
+          m_vbos(std::move(other.m_vbos)),
+          m_ibo(std::move(other.m_ibo)),
+          m_vertex_descriptor(std::move(other.m_vertex_descriptor)),
+          m_indices_cnt(std::exchange(other.m_indices_cnt, 0)),
+          m_index_type(other.m_index_type),
+          m_base_vertex(other.m_base_vertex),
+          m_index_range(std::exchange(other.m_index_range, IndexRange())),
+          m_index_range_valid(std::exchange(other.m_index_range_valid, true)),
+          m_index_range_hint(other.m_index_range_hint),
+          m_primitive_type(other.m_primitive_type),
+          m_usage(other.m_usage),
+          m_lod_levels(std::move(other.m_lod_levels)),
+          m_bounds(std::exchange(other.m_bounds, Bounds()))
+    {
+    }
+
+    inline Mesh& Mesh::operator=(Mesh&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseVertexArray();
+            m_va_handle = std::exchange(rhs.m_va_handle, 0);
+            m_va_pool = rhs.m_va_pool;
+            m_buffer_pool = rhs.m_buffer_pool;
+            m_va_cache = std::exchange(rhs.m_va_cache, nullptr);
+            m_vbos = std::move(rhs.m_vbos);
+            m_ibo = std::move(rhs.m_ibo);
+            m_vertex_descriptor = std::move(rhs.m_vertex_descriptor);
+            m_indices_cnt = std::exchange(rhs.m_indices_cnt, 0);
+            m_index_type = rhs.m_index_type;
+            m_base_vertex = rhs.m_base_vertex;
+            m_index_range = std::exchange(rhs.m_index_range, IndexRange());
+            m_index_range_valid = std::exchange(rhs.m_index_range_valid, true);
+            m_index_range_hint = rhs.m_index_range_hint;
+            m_primitive_type = rhs.m_primitive_type;
+            m_usage = rhs.m_usage;
+            m_lod_levels = std::move(rhs.m_lod_levels);
+            m_bounds = std::exchange(rhs.m_bounds, Bounds());
+        }
+        return *this;
+    }
+
     template<typename VertexDataType>
     inline void Mesh::bufferVertexSubData(std::size_t                        vbo_idx,
                                           std::vector<VertexDataType> const& vertices,
                                           GLsizeiptr                         byte_offset)
     {
-        if (vbo_idx >= m_vbos.size())
-        {
-            throw MeshException("Mesh::bufferVertexSubData - vertex buffer index out of range");
-        }
-        m_vbos[vbo_idx]->bufferSubData<std::vector<VertexDataType>>(vertices, byte_offset);
+        bufferVertexSubData(vbo_idx,
+                            vertices.data(),
+                            static_cast<GLsizeiptr>(vertices.size() * sizeof(VertexDataType)),
+                            byte_offset);
     }
 
     inline void Mesh::bufferVertexSubData(std::size_t   vbo_idx,
@@ -364,74 +927,361 @@ namespace glowl
         {
             throw MeshException("Mesh::bufferVertexSubData - vertex buffer index out of range");
         }
-        m_vbos[vbo_idx]->bufferSubData(data, byte_size, byte_offset);
+        m_vbos[vbo_idx].bufferSubData(data, byte_size, byte_offset);
+        extendBounds(vbo_idx, data, byte_size, byte_offset);
     }
 
     template<typename IndexDataType>
     inline void Mesh::bufferIndexSubData(std::vector<IndexDataType> const& indices, GLsizeiptr byte_offset)
     {
-        m_ibo.bufferSubData<std::vector<IndexDataType>>(indices, byte_offset);
+        bufferIndexSubData(indices.data(),
+                           static_cast<GLsizeiptr>(indices.size() * sizeof(IndexDataType)),
+                           byte_offset);
     }
 
     inline void Mesh::bufferIndexSubData(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset)
     {
         m_ibo.bufferSubData(data, byte_size, byte_offset);
+        extendIndexRange(data, byte_size);
     }
 
-    inline void Mesh::createVertexArray()
+    template<typename VertexDataType>
+    inline void Mesh::rebufferVertexData(std::size_t vbo_idx, std::vector<VertexDataType> const& vertices)
     {
-        glCreateVertexArrays(1, &m_va_handle);
+        rebufferVertexData(vbo_idx, vertices.data(), static_cast<GLsizeiptr>(vertices.size() * sizeof(VertexDataType)));
+    }
 
-        GLuint attrib_idx = 0;
+    inline void Mesh::rebufferVertexData(std::size_t vbo_idx, GLvoid const* data, GLsizeiptr byte_size)
+    {
+        if (vbo_idx >= m_vbos.size())
+        {
+            throw MeshException("Mesh::rebufferVertexData - vertex buffer index out of range");
+        }
+        m_vbos[vbo_idx].rebuffer(data, byte_size);
 
-        for (std::size_t vertex_layout_idx = 0; vertex_layout_idx < m_vertex_descriptor.size(); ++vertex_layout_idx)
+        if (vbo_idx == findPositionLayout(m_vertex_descriptor))
         {
-            glVertexArrayVertexBuffer(m_va_handle,
-                                      static_cast<GLuint>(vertex_layout_idx),
-                                      m_vbos[vertex_layout_idx]->getName(),
-                                      0, // offset not really needed since we just created a new vbo
-                                      m_vertex_descriptor[vertex_layout_idx].stride);
+            m_bounds = Bounds();
+            extendBounds(vbo_idx, data, byte_size, 0);
+        }
+    }
 
-            for (std::size_t local_attrib_idx = 0;
-                 local_attrib_idx < m_vertex_descriptor[vertex_layout_idx].attributes.size();
-                 ++local_attrib_idx)
+    template<typename IndexDataType>
+    inline void Mesh::rebufferIndexData(std::vector<IndexDataType> const& indices)
+    {
+        rebufferIndexData(indices.data(), static_cast<GLsizeiptr>(indices.size() * sizeof(IndexDataType)));
+    }
+
+    inline void Mesh::rebufferIndexData(GLvoid const* data, GLsizeiptr byte_size)
+    {
+        m_ibo.rebuffer(data, byte_size);
+        setIndicesCount(static_cast<GLuint>(byte_size));
+        m_index_range = IndexRange();
+        m_index_range_valid = true;
+        extendIndexRange(data, byte_size);
+        m_lod_levels.clear();
+    }
+
+    inline void Mesh::rebufferIndexData(PackedIndexData const& index_data)
+    {
+        m_index_type = index_data.index_type;
+        m_base_vertex = index_data.base_vertex;
+        rebufferIndexData(index_data.index_data.data(), static_cast<GLsizeiptr>(index_data.index_data.size()));
+    }
+
+    inline std::size_t Mesh::addInstanceBuffer(VertexLayout const& instance_layout,
+                                               GLsizeiptr          byte_capacity,
+                                               GLenum              usage)
+    {
+        if (instance_layout.divisor == 0 || instance_layout.stride <= 0)
+        {
+            throw MeshException("Mesh::addInstanceBuffer - instance layout requires a divisor > 0 and a stride > 0");
+        }
+
+        m_vertex_descriptor.push_back(instance_layout);
+        m_vbos.emplace_back(GL_ARRAY_BUFFER, nullptr, 0, usage, m_buffer_pool);
+        m_vbos.back().reserve(byte_capacity);
+
+        if (m_va_cache != nullptr)
+        {
+            // the extended layouts select a different shared vertex array
+            releaseVertexArray();
+            m_va_handle = m_va_cache->acquire(m_vertex_descriptor);
+        }
+        else
+        {
+            setVertexArrayFormat(m_va_handle, m_vertex_descriptor);
+            updateVertexArrayBuffers();
+        }
+        checkError();
+
+        return m_vbos.size() - 1;
+    }
+
+    template<typename InstanceDataType>
+    inline void Mesh::streamInstanceData(std::size_t vbo_idx, std::vector<InstanceDataType> const& instances)
+    {
+        streamInstanceData(vbo_idx,
+                           instances.data(),
+                           static_cast<GLsizeiptr>(instances.size() * sizeof(InstanceDataType)));
+    }
+
+    inline void Mesh::streamInstanceData(std::size_t vbo_idx, GLvoid const* data, GLsizeiptr byte_size)
+    {
+        if (vbo_idx >= m_vbos.size() || m_vertex_descriptor[vbo_idx].divisor == 0)
+        {
+            throw MeshException("Mesh::streamInstanceData - no instance buffer at index " + std::to_string(vbo_idx));
+        }
+
+        // rebuffer keeps the buffer name, so the vertex array stays valid, and invalidates the previous content
+        m_vbos[vbo_idx].rebuffer(data, byte_size);
+    }
+
+    inline GLuint Mesh::appendVertexData(std::vector<void const*> const& vertex_data,
+                                         std::vector<std::size_t> const& vertex_data_byte_sizes)
+    {
+        std::vector<std::size_t> vbo_indices;
+        for (std::size_t i = 0; i < m_vbos.size(); ++i)
+        {
+            if (m_vertex_descriptor[i].divisor == 0)
             {
-                auto const& attribute = m_vertex_descriptor[vertex_layout_idx].attributes[local_attrib_idx];
+                vbo_indices.push_back(i);
+            }
+        }
+        if (vertex_data.size() != vbo_indices.size() || vertex_data_byte_sizes.size() != vbo_indices.size())
+        {
+            throw MeshException("Mesh::appendVertexData - expected data for each per-vertex buffer");
+        }
 
-                glEnableVertexArrayAttrib(m_va_handle, attrib_idx);
-                switch (attribute.shader_input_type)
-                {
-                case GL_FLOAT:
-                    glVertexArrayAttribFormat(m_va_handle,
-                                              attrib_idx,
-                                              attribute.size,
-                                              attribute.type,
-                                              attribute.normalized,
-                                              attribute.offset);
-                    break;
-                case GL_INT:
-                    glVertexArrayAttribIFormat(m_va_handle,
-                                               attrib_idx,
-                                               attribute.size,
-                                               attribute.type,
-                                               attribute.offset);
-                    break;
-                case GL_DOUBLE:
-                    glVertexArrayAttribLFormat(m_va_handle,
-                                               attrib_idx,
-                                               attribute.size,
-                                               attribute.type,
-                                               attribute.offset);
-                    break;
-                default:
-                    throw MeshException(
-                        "Mesh::createVertexArray - invalid vertex shader input type given (use float, double or int)");
-                    break;
-                }
-                glVertexArrayAttribBinding(m_va_handle, attrib_idx, static_cast<GLuint>(vertex_layout_idx));
+        GLuint      first_vertex = getVertexCount();
+        std::size_t vertex_cnt =
+            vbo_indices.empty() ? 0 : vertex_data_byte_sizes.front() / m_vertex_descriptor[vbo_indices.front()].stride;
+        for (std::size_t i = 0; i < vbo_indices.size(); ++i)
+        {
+            std::size_t stride = m_vertex_descriptor[vbo_indices[i]].stride;
+            if (static_cast<std::size_t>(m_vbos[vbo_indices[i]].getByteSize()) != first_vertex * stride ||
+                vertex_data_byte_sizes[i] != vertex_cnt * stride)
+            {
+                throw MeshException("Mesh::appendVertexData - vertex counts of the vertex buffers differ");
+            }
+        }
+
+        std::vector<GLuint> names = getBufferNames();
+        for (std::size_t i = 0; i < vbo_indices.size(); ++i)
+        {
+            GLsizeiptr byte_offset = m_vbos[vbo_indices[i]].append(vertex_data[i],
+                                                                   static_cast<GLsizeiptr>(vertex_data_byte_sizes[i]));
+            extendBounds(vbo_indices[i],
+                         vertex_data[i],
+                         static_cast<GLsizeiptr>(vertex_data_byte_sizes[i]),
+                         byte_offset);
+        }
+        updateVertexArrayIfReallocated(names);
+
+        return first_vertex;
+    }
+
+    template<typename VertexDataType>
+    inline GLuint Mesh::appendVertexData(std::vector<std::vector<VertexDataType>> const& vertex_data)
+    {
+        std::vector<void const*> data_pointers;
+        std::vector<std::size_t> byte_sizes;
+        for (auto const& data : vertex_data)
+        {
+            data_pointers.push_back(data.data());
+            byte_sizes.push_back(data.size() * sizeof(VertexDataType));
+        }
+        return appendVertexData(data_pointers, byte_sizes);
+    }
+
+    inline GLuint Mesh::appendIndexData(GLvoid const* data, GLsizeiptr byte_size)
+    {
+        GLuint first_index = m_indices_cnt;
+
+        std::vector<GLuint> names = getBufferNames();
+        m_ibo.append(data, byte_size);
+        updateVertexArrayIfReallocated(names);
+
+        setIndicesCount(static_cast<GLuint>(m_ibo.getByteSize()));
+        extendIndexRange(data, byte_size);
+        m_lod_levels.clear();
+
+        return first_index;
+    }
+
+    template<typename IndexDataType>
+    inline GLuint Mesh::appendIndexData(std::vector<IndexDataType> const& indices)
+    {
+        return appendIndexData(indices.data(), static_cast<GLsizeiptr>(indices.size() * sizeof(IndexDataType)));
+    }
+
+    inline GLuint Mesh::removeVertexRange(GLuint first_vertex, GLuint vertex_cnt)
+    {
+        if (static_cast<std::size_t>(first_vertex) + vertex_cnt > getVertexCount())
+        {
+            throw MeshException("Mesh::removeVertexRange - vertex range out of bounds");
+        }
 
-                ++attrib_idx;
+        GLsizeiptr moved_vertex_cnt = 0;
+        for (std::size_t i = 0; i < m_vbos.size(); ++i)
+        {
+            if (m_vertex_descriptor[i].divisor != 0)
+            {
+                continue;
             }
+            GLsizeiptr stride = m_vertex_descriptor[i].stride;
+            moved_vertex_cnt = swapRemove(m_vbos[i], first_vertex * stride, vertex_cnt * stride) / stride;
+        }
+        checkError();
+
+        return static_cast<GLuint>(moved_vertex_cnt);
+    }
+
+    inline GLuint Mesh::removeIndexRange(GLuint first_index, GLuint index_cnt)
+    {
+        if (static_cast<std::size_t>(first_index) + index_cnt > m_indices_cnt)
+        {
+            throw MeshException("Mesh::removeIndexRange - index range out of bounds");
+        }
+
+        if (m_index_type != GL_UNSIGNED_BYTE && m_index_type != GL_UNSIGNED_SHORT && m_index_type != GL_UNSIGNED_INT)
+        {
+            throw MeshException("Mesh::removeIndexRange - Invalid index type");
+        }
+
+        // the index range stays valid as a (possibly loose) bound of the remaining indices
+        GLsizeiptr index_byte_size = static_cast<GLsizeiptr>(computeByteSize(m_index_type));
+        GLsizeiptr moved_byte_size = swapRemove(m_ibo, first_index * index_byte_size, index_cnt * index_byte_size);
+        setIndicesCount(static_cast<GLuint>(m_ibo.getByteSize()));
+        m_lod_levels.clear();
+        checkError();
+
+        return static_cast<GLuint>(moved_byte_size / index_byte_size);
+    }
+
+    inline void Mesh::setLodLevels(std::vector<LodLevel> const& lod_levels)
+    {
+        for (auto const& level : lod_levels)
+        {
+            if (static_cast<std::uint64_t>(level.first_index) + level.index_cnt > m_indices_cnt)
+            {
+                throw MeshException("Mesh::setLodLevels - level of detail exceeds the index count");
+            }
+        }
+        m_lod_levels = lod_levels;
+    }
+
+    inline void Mesh::drawLod(std::size_t level, GLsizei instance_cnt)
+    {
+        if (level >= m_lod_levels.size())
+        {
+            if (level == 0)
+            {
+                draw(instance_cnt);
+                return;
+            }
+            throw MeshException("Mesh::drawLod - level of detail out of range");
+        }
+        drawElements(m_lod_levels[level].first_index, m_lod_levels[level].index_cnt, instance_cnt);
+    }
+
+    inline void Mesh::reserveVertexBuffer(std::size_t vbo_idx, GLsizeiptr byte_capacity)
+    {
+        if (vbo_idx >= m_vbos.size())
+        {
+            throw MeshException("Mesh::reserveVertexBuffer - vertex buffer index out of range");
+        }
+
+        GLuint name = m_vbos[vbo_idx].getName();
+        m_vbos[vbo_idx].reserve(byte_capacity);
+        if (name != m_vbos[vbo_idx].getName())
+        {
+            updateVertexArrayBuffers();
+        }
+    }
+
+    inline void Mesh::reserveIndexBuffer(GLsizeiptr byte_capacity)
+    {
+        GLuint name = m_ibo.getName();
+        m_ibo.reserve(byte_capacity);
+        if (name != m_ibo.getName())
+        {
+            updateVertexArrayBuffers();
+        }
+    }
+
+    inline void Mesh::shrinkToFit()
+    {
+        std::vector<GLuint> names = getBufferNames();
+        for (auto& vbo : m_vbos)
+        {
+            vbo.shrinkToFit();
+        }
+        m_ibo.shrinkToFit();
+
+        updateVertexArrayIfReallocated(names);
+    }
+
+    inline void Mesh::setVertexArrayCache(VertexArrayCache* vertex_array_cache)
+    {
+        if (vertex_array_cache == m_va_cache)
+        {
+            return;
+        }
+
+        releaseVertexArray();
+        m_va_cache = vertex_array_cache;
+        if (m_va_cache != nullptr)
+        {
+            m_va_handle = m_va_cache->acquire(m_vertex_descriptor);
+        }
+        else
+        {
+            createVertexArray();
+        }
+
+        checkError();
+    }
+
+    inline void Mesh::createVertexArray()
+    {
+        m_va_handle = acquireName(m_va_pool, NamePool::Type::VertexArray);
+
+        setVertexArrayFormat(m_va_handle, m_vertex_descriptor);
+
+        updateVertexArrayBuffers();
+    }
+
+    inline void Mesh::releaseVertexArray()
+    {
+        if (m_va_cache != nullptr)
+        {
+            // the shared vertex array might reference buffers that are about to be deleted
+            m_va_cache->invalidate(m_va_handle);
+        }
+        else
+        {
+            releaseName(m_va_pool, NamePool::Type::VertexArray, m_va_handle, false);
+        }
+        m_va_handle = 0;
+    }
+
+    inline void Mesh::updateVertexArrayBuffers()
+    {
+        if (m_va_cache != nullptr)
+        {
+            // buffers are attached lazily by bindVertexArray()
+            m_va_cache->invalidate(m_va_handle);
+            return;
+        }
+
+        for (std::size_t vertex_layout_idx = 0; vertex_layout_idx < m_vertex_descriptor.size(); ++vertex_layout_idx)
+        {
+            glVertexArrayVertexBuffer(m_va_handle,
+                                      static_cast<GLuint>(vertex_layout_idx),
+                                      m_vbos[vertex_layout_idx].getName(),
+                                      0, // offset not really needed since each vbo is exclusive to this mesh
+                                      m_vertex_descriptor[vertex_layout_idx].stride);
         }
 
         glVertexArrayElementBuffer(m_va_handle, m_ibo.getName());
@@ -453,6 +1303,126 @@ namespace glowl
         }
     }
 
+    inline void Mesh::extendIndexRange(GLvoid const* index_data, GLsizeiptr index_data_byte_size)
+    {
+        if (m_index_range_valid && index_data != nullptr)
+        {
+            if (m_index_type != GL_UNSIGNED_BYTE && m_index_type != GL_UNSIGNED_SHORT &&
+                m_index_type != GL_UNSIGNED_INT)
+            {
+                throw MeshException("Mesh::extendIndexRange - Invalid index type");
+            }
+
+            std::size_t index_cnt = static_cast<std::size_t>(index_data_byte_size) / computeByteSize(m_index_type);
+            m_index_range.extend(computeIndexRange(index_data, index_cnt, m_index_type));
+        }
+    }
+
+    inline void Mesh::drawElements(GLuint first_index, GLuint index_cnt, GLsizei instance_cnt)
+    {
+        GLvoid const* offset = reinterpret_cast<GLvoid const*>(first_index * computeByteSize(m_index_type));
+
+        bindVertexArray();
+        // the index range of the whole buffer is a valid (if loose) hint for any part of it
+        if (m_index_range_hint && m_index_range_valid && instance_cnt == 1 && !m_index_range.empty())
+        {
+            glDrawRangeElementsBaseVertex(m_primitive_type,
+                                          m_index_range.min_index,
+                                          m_index_range.max_index,
+                                          static_cast<GLsizei>(index_cnt),
+                                          m_index_type,
+                                          offset,
+                                          m_base_vertex);
+        }
+        else
+        {
+            glDrawElementsInstancedBaseVertex(m_primitive_type,
+                                              static_cast<GLsizei>(index_cnt),
+                                              m_index_type,
+                                              offset,
+                                              instance_cnt,
+                                              m_base_vertex);
+        }
+        if (m_va_cache == nullptr || !m_va_cache->isBatchActive())
+        {
+            glBindVertexArray(0);
+        }
+    }
+
+    inline void Mesh::updateVertexArrayIfReallocated(std::vector<GLuint> const& previous_names)
+    {
+        if (previous_names != getBufferNames())
+        {
+            updateVertexArrayBuffers();
+        }
+    }
+
+    inline void Mesh::extendBounds(std::size_t   vbo_idx,
+                                   GLvoid const* data,
+                                   GLsizeiptr    byte_size,
+                                   GLsizeiptr    byte_offset)
+    {
+        if (data == nullptr || vbo_idx != findPositionLayout(m_vertex_descriptor))
+        {
+            return;
+        }
+
+        // only positions that lie completely within the written range, others keep their (bounded) value
+        VertexLayout::Attribute position = m_vertex_descriptor[vbo_idx].attributes.front();
+        GLsizeiptr              stride = m_vertex_descriptor[vbo_idx].stride;
+        GLsizeiptr              position_offset = position.offset;
+        GLsizeiptr              position_byte_size = static_cast<GLsizeiptr>(3 * computeByteSize(position.type));
+        if (stride <= 0 || position_offset < 0 || position_offset + position_byte_size > stride ||
+            byte_offset + byte_size < position_offset + position_byte_size)
+        {
+            return;
+        }
+
+        GLsizeiptr first_vertex = byte_offset > position_offset ? (byte_offset - position_offset + stride - 1) / stride
+                                                                : 0;
+        GLsizeiptr end_vertex = (byte_offset + byte_size - position_offset - position_byte_size) / stride + 1;
+        if (end_vertex <= first_vertex)
+        {
+            return;
+        }
+
+        position.offset = 0;
+        Bounds bounds = computeBounds(static_cast<GLubyte const*>(data) + first_vertex * stride + position_offset -
+                                          byte_offset,
+                                      static_cast<std::size_t>(end_vertex - first_vertex),
+                                      static_cast<std::size_t>(stride),
+                                      position);
+        m_bounds.box.extend(bounds.box);
+        m_bounds.sphere.extend(bounds.sphere);
+    }
+
+    inline std::vector<GLuint> Mesh::getBufferNames() const
+    {
+        std::vector<GLuint> retval;
+        retval.reserve(m_vbos.size() + 1);
+        for (auto const& vbo : m_vbos)
+        {
+            retval.push_back(vbo.getName());
+        }
+        retval.push_back(m_ibo.getName());
+        return retval;
+    }
+
+    inline GLsizeiptr Mesh::swapRemove(BufferObject& buffer, GLsizeiptr byte_offset, GLsizeiptr byte_size)
+    {
+        // the tail (or the part of it behind the gap) never overlaps the gap
+        GLsizeiptr total_byte_size = buffer.getByteSize();
+        GLsizeiptr moved_byte_size = std::min(byte_size, total_byte_size - (byte_offset + byte_size));
+        if (moved_byte_size > 0)
+        {
+            glCopyNamedBufferSubData(
+                buffer.getName(), buffer.getName(), total_byte_size - moved_byte_size, byte_offset, moved_byte_size);
+        }
+        buffer.resize(total_byte_size - byte_size);
+
+        return moved_byte_size;
+    }
+
     inline void Mesh::checkError()
     {
         auto err = glGetError();
@@ -0,0 +1,362 @@
+/*
+ * MeshArena.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHARENA_HPP
+#define GLOWL_MESHARENA_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BufferArena.hpp"
+#include "Exceptions.hpp"
+#include "Mesh.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class MeshArena
+     *
+     * \brief Packs many small meshes with identical vertex layouts into shared vertex and index buffers.
+     *
+     * Instead of a vertex array and dedicated buffers per mesh, each mesh is a pair of sub-allocations in a vertex
+     * and an index BufferArena. Vertices and indices of a mesh always reside in blocks of the same index, so that
+     * one vertex array per block suffices. The DrawElementsCommand returned by getDrawCommand() addresses the shared
+     * storage via first_idx and base_vertex, e.g. for use with glMultiDrawElementsIndirect.
+     *
+     * \author Michael Becher
+     */
+    class MeshArena
+    {
+    public:
+        struct MeshAllocation
+        {
+            BufferArena::Allocation vertices;
+            BufferArena::Allocation indices;
+        };
+
+        /**
+         * \brief MeshArena constructor.
+         *
+         * \param vertex_descriptor Vertex layouts shared by all meshes of the arena, one vertex buffer per layout
+         * \param block_vertex_cnt Number of vertices per block
+         * \param block_index_cnt Number of indices per block
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        MeshArena(std::vector<VertexLayout> const& vertex_descriptor,
+                  GLenum const                     index_type = GL_UNSIGNED_INT,
+                  GLenum const                     primitive_type = GL_TRIANGLES,
+                  GLuint const                     block_vertex_cnt = 1 << 20,
+                  GLuint const                     block_index_cnt = 1 << 22);
+
+        ~MeshArena();
+
+        MeshArena(const MeshArena&) = delete;
+        MeshArena(MeshArena&& other) noexcept;
+        MeshArena& operator=(MeshArena&& rhs) noexcept;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        /**
+         * \brief Allocate and upload a mesh.
+         *
+         * \param vertex_data One data pointer per vertex layout, each containing vertex_cnt vertices
+         * \param index_data Pointer to index_cnt indices of the arena's index type
+         */
+        MeshAllocation allocate(std::vector<void const*> const& vertex_data,
+                                GLuint                          vertex_cnt,
+                                void const*                     index_data,
+                                GLuint                          index_cnt);
+
+        void free(MeshAllocation const& allocation);
+
+        DrawElementsCommand getDrawCommand(MeshAllocation const& allocation,
+                                           GLuint                instance_cnt = 1,
+                                           GLuint                base_instance = 0) const;
+
+        void bindVertexArray(GLuint block) const;
+
+        GLuint getVertexArray(GLuint block) const;
+
+        /**
+         * Draw a single mesh of the arena for your convenience.
+         * Prefer batching the draw commands of a block into a single indirect draw call.
+         */
+        void draw(MeshAllocation const& allocation, GLsizei instance_cnt = 1) const;
+
+        std::vector<VertexLayout> const& getVertexLayouts() const;
+
+        GLenum getIndexType() const;
+
+        GLenum getPrimitiveType() const;
+
+        GLuint getBlockCount() const;
+
+        BufferArena const& getVertexArena() const;
+
+        BufferArena const& getIndexArena() const;
+
+    private:
+        static std::vector<GLsizeiptr> computeStrides(std::vector<VertexLayout> const& vertex_descriptor);
+
+        static GLsizeiptr computeIndexByteSize(GLenum index_type);
+
+        void addBlock();
+
+        std::vector<VertexLayout> m_vertex_descriptor;
+        GLenum                    m_index_type;
+        GLenum                    m_primitive_type;
+
+        BufferArena         m_vertex_arena;
+        BufferArena         m_index_arena;
+        std::vector<GLuint> m_va_handles;
+    };
+
+    inline MeshArena::MeshArena(std::vector<VertexLayout> const& vertex_descriptor,
+                                GLenum const                     index_type,
+                                GLenum const                     primitive_type,
+                                GLuint const                     block_vertex_cnt,
+                                GLuint const                     block_index_cnt)
+        : m_vertex_descriptor(vertex_descriptor),
+          m_index_type(index_type),
+          m_primitive_type(primitive_type),
+          m_vertex_arena(computeStrides(vertex_descriptor), block_vertex_cnt),
+          m_index_arena({computeIndexByteSize(index_type)}, block_index_cnt),
+          m_va_handles()
+    {
+        // both arenas start with a single block
+        addBlock();
+    }
+
+    inline MeshArena::~MeshArena()
+    {
+        glDeleteVertexArrays(static_cast<GLsizei>(m_va_handles.size()), m_va_handles.data());
+    }
+
+    inline MeshArena::MeshArena(MeshArena&& other) noexcept
+        : m_vertex_descriptor(std::move(other.m_vertex_descriptor)),
+          m_index_type(other.m_index_type),
+          m_primitive_type(other.m_primitive_type),
+          m_vertex_arena(std::move(other.m_vertex_arena)),
+          m_index_arena(std::move(other.m_index_arena)),
+          m_va_handles(std::exchange(other.m_va_handles, {}))
+    {
+    }
+
+    inline MeshArena& MeshArena::operator=(MeshArena&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            glDeleteVertexArrays(static_cast<GLsizei>(m_va_handles.size()), m_va_handles.data());
+            m_vertex_descriptor = std::move(rhs.m_vertex_descriptor);
+            m_index_type = rhs.m_index_type;
+            m_primitive_type = rhs.m_primitive_type;
+            m_vertex_arena = std::move(rhs.m_vertex_arena);
+            m_index_arena = std::move(rhs.m_index_arena);
+            m_va_handles = std::exchange(rhs.m_va_handles, {});
+        }
+        return *this;
+    }
+
+    inline MeshArena::MeshAllocation MeshArena::allocate(std::vector<void const*> const& vertex_data,
+                                                         GLuint                          vertex_cnt,
+                                                         void const*                     index_data,
+                                                         GLuint                          index_cnt)
+    {
+        if (vertex_data.size() != m_vertex_descriptor.size())
+        {
+            throw MeshException("MeshArena::allocate - vertex data does not match vertex layouts");
+        }
+        if (vertex_cnt == 0 || index_cnt == 0)
+        {
+            throw MeshException("MeshArena::allocate - empty mesh");
+        }
+        if (vertex_cnt > m_vertex_arena.getBlockElementCount() || index_cnt > m_index_arena.getBlockElementCount())
+        {
+            throw MeshException("MeshArena::allocate - mesh exceeds block size");
+        }
+
+        GLuint block = 0;
+        for (;; ++block)
+        {
+            bool new_block = false;
+            if (block == m_va_handles.size())
+            {
+                addBlock();
+                new_block = true;
+            }
+
+            auto vertices = m_vertex_arena.allocate(vertex_cnt, block);
+            if (!vertices.has_value())
+            {
+                if (new_block)
+                {
+                    throw MeshException("MeshArena::allocate - failed to allocate vertices in a new block");
+                }
+                continue;
+            }
+
+            auto indices = m_index_arena.allocate(index_cnt, block);
+            if (!indices.has_value())
+            {
+                m_vertex_arena.free(vertices.value());
+                if (new_block)
+                {
+                    throw MeshException("MeshArena::allocate - failed to allocate indices in a new block");
+                }
+                continue;
+            }
+
+            MeshAllocation allocation{vertices.value(), indices.value()};
+
+            for (std::size_t i = 0; i < vertex_data.size(); ++i)
+            {
+                m_vertex_arena.bufferSubData(allocation.vertices,
+                                             i,
+                                             vertex_data[i],
+                                             vertex_cnt * m_vertex_arena.getElementByteSize(i));
+            }
+            m_index_arena.bufferSubData(allocation.indices,
+                                        0,
+                                        index_data,
+                                        index_cnt * m_index_arena.getElementByteSize(0));
+
+            return allocation;
+        }
+    }
+
+    inline void MeshArena::free(MeshAllocation const& allocation)
+    {
+        m_vertex_arena.free(allocation.vertices);
+        m_index_arena.free(allocation.indices);
+    }
+
+    inline DrawElementsCommand MeshArena::getDrawCommand(MeshAllocation const& allocation,
+                                                         GLuint                instance_cnt,
+                                                         GLuint                base_instance) const
+    {
+        return {allocation.indices.count,
+                instance_cnt,
+                allocation.indices.first,
+                allocation.vertices.first,
+                base_instance};
+    }
+
+    inline void MeshArena::bindVertexArray(GLuint block) const
+    {
+        glBindVertexArray(m_va_handles[block]);
+    }
+
+    inline GLuint MeshArena::getVertexArray(GLuint block) const
+    {
+        return m_va_handles[block];
+    }
+
+    inline void MeshArena::draw(MeshAllocation const& allocation, GLsizei instance_cnt) const
+    {
+        glBindVertexArray(m_va_handles[allocation.vertices.block]);
+        glDrawElementsInstancedBaseVertex(m_primitive_type,
+                                          static_cast<GLsizei>(allocation.indices.count),
+                                          m_index_type,
+                                          reinterpret_cast<GLvoid const*>(
+                                              m_index_arena.getByteOffset(allocation.indices, 0)),
+                                          instance_cnt,
+                                          static_cast<GLint>(allocation.vertices.first));
+        glBindVertexArray(0);
+    }
+
+    inline std::vector<VertexLayout> const& MeshArena::getVertexLayouts() const
+    {
+        return m_vertex_descriptor;
+    }
+
+    inline GLenum MeshArena::getIndexType() const
+    {
+        return m_index_type;
+    }
+
+    inline GLenum MeshArena::getPrimitiveType() const
+    {
+        return m_primitive_type;
+    }
+
+    inline GLuint MeshArena::getBlockCount() const
+    {
+        return static_cast<GLuint>(m_va_handles.size());
+    }
+
+    inline BufferArena const& MeshArena::getVertexArena() const
+    {
+        return m_vertex_arena;
+    }
+
+    inline BufferArena const& MeshArena::getIndexArena() const
+    {
+        return m_index_arena;
+    }
+
+    inline std::vector<GLsizeiptr> MeshArena::computeStrides(std::vector<VertexLayout> const& vertex_descriptor)
+    {
+        std::vector<GLsizeiptr> retval;
+        for (auto const& layout : vertex_descriptor)
+        {
+            retval.push_back(layout.stride);
+        }
+        return retval;
+    }
+
+    inline GLsizeiptr MeshArena::computeIndexByteSize(GLenum index_type)
+    {
+        if (index_type != GL_UNSIGNED_INT && index_type != GL_UNSIGNED_SHORT && index_type != GL_UNSIGNED_BYTE)
+        {
+            throw MeshException("MeshArena::MeshArena - invalid index type");
+        }
+        return static_cast<GLsizeiptr>(computeByteSize(index_type));
+    }
+
+    inline void MeshArena::addBlock()
+    {
+        GLuint block = static_cast<GLuint>(m_va_handles.size());
+
+        // the arenas create their first block on construction
+        if (block >= m_vertex_arena.getBlockCount())
+        {
+            m_vertex_arena.addBlock();
+            m_index_arena.addBlock();
+        }
+
+        GLuint va_handle = 0;
+        glCreateVertexArrays(1, &va_handle);
+        m_va_handles.push_back(va_handle);
+
+        setVertexArrayFormat(va_handle, m_vertex_descriptor);
+
+        for (std::size_t vertex_layout_idx = 0; vertex_layout_idx < m_vertex_descriptor.size(); ++vertex_layout_idx)
+        {
+            glVertexArrayVertexBuffer(va_handle,
+                                      static_cast<GLuint>(vertex_layout_idx),
+                                      m_vertex_arena.getBuffer(block, vertex_layout_idx).getName(),
+                                      0,
+                                      m_vertex_descriptor[vertex_layout_idx].stride);
+        }
+
+        glVertexArrayElementBuffer(va_handle, m_index_arena.getBuffer(block, 0).getName());
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw MeshException("MeshArena::addBlock - OpenGL error " + std::to_string(err));
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHARENA_HPP
@@ -0,0 +1,436 @@
+/*
+ * MeshBatch.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHBATCH_HPP
+#define GLOWL_MESHBATCH_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "Mesh.hpp"
+#include "MeshArena.hpp"
+#include "ShadowedBufferObject.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class MeshBatch
+     *
+     * \brief Batch of meshes with identical vertex layouts and index type that is drawn with multi-draw-indirect.
+     *
+     * Meshes are packed into the shared buffers of a MeshArena. For each arena block, the batch keeps a tightly
+     * packed array of DrawElementsCommands on the CPU and in an indirect buffer. Adding a mesh appends a command,
+     * removing one moves the last command of the block into the gap, so only the changed commands are uploaded on
+     * the next draw. draw() issues a single glMultiDrawElementsIndirect per block (i.e. a single one unless the batch
+     * outgrows the first block).
+     *
+     * Each mesh is identified by a stable draw ID that is stored as base_instance of its command. In the vertex
+     * shader, the draw ID is available as gl_BaseInstance (GL 4.6 or ARB_shader_draw_parameters) or, without
+     * extensions, as uint vertex attribute at getDrawIdAttribIndex(), e.g. for indexing per-draw data in a buffer.
+     *
+     * \author Michael Becher
+     */
+    class MeshBatch
+    {
+    public:
+        using DrawId = GLuint;
+
+        /**
+         * \brief MeshBatch constructor, see MeshArena for the parameters.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        MeshBatch(std::vector<VertexLayout> const& vertex_descriptor,
+                  GLenum const                     index_type = GL_UNSIGNED_INT,
+                  GLenum const                     primitive_type = GL_TRIANGLES,
+                  GLuint const                     block_vertex_cnt = 1 << 20,
+                  GLuint const                     block_index_cnt = 1 << 22);
+
+        MeshBatch(const MeshBatch&) = delete;
+        MeshBatch(MeshBatch&&) noexcept = default;
+        MeshBatch& operator=(MeshBatch&&) noexcept = default;
+        MeshBatch& operator=(const MeshBatch&) = delete;
+
+        /**
+         * \brief Add a mesh to the batch.
+         *
+         * \param vertex_data One data pointer per vertex layout, each containing vertex_cnt vertices
+         * \param index_data Pointer to index_cnt indices of the batch's index type
+         *
+         * \return Returns the draw ID of the mesh.
+         */
+        DrawId add(std::vector<void const*> const& vertex_data,
+                   GLuint                          vertex_cnt,
+                   void const*                     index_data,
+                   GLuint                          index_cnt,
+                   GLuint                          instance_cnt = 1);
+
+        template<typename VertexDataType, typename IndexDataType>
+        DrawId add(std::vector<std::vector<VertexDataType>> const& vertex_data,
+                   std::vector<IndexDataType> const&               index_data,
+                   GLuint                                          instance_cnt = 1);
+
+        /**
+         * \brief Remove a mesh from the batch. Its draw ID may be reused by subsequently added meshes.
+         */
+        void remove(DrawId draw_id);
+
+        void setInstanceCount(DrawId draw_id, GLuint instance_cnt);
+
+        bool contains(DrawId draw_id) const;
+
+        /**
+         * \brief Upload changed draw commands and draw all meshes of the batch.
+         */
+        void draw();
+
+        /**
+         * \brief Upload changed draw commands, e.g. before consuming the command buffers in custom draw calls.
+         */
+        void flush();
+
+        /**
+         * \brief Returns the draw command of a mesh as currently stored in its block's command buffer.
+         */
+        DrawElementsCommand const& getDrawCommand(DrawId draw_id) const;
+
+        /**
+         * \brief Returns the number of meshes in the batch.
+         */
+        GLuint getDrawCount() const;
+
+        /**
+         * \brief Returns the number of draw commands in the given arena block.
+         */
+        GLuint getDrawCount(GLuint block) const;
+
+        /**
+         * \brief Returns the indirect buffer with the draw commands of the given arena block.
+         */
+        BufferObject const& getCommandBuffer(GLuint block) const;
+
+        /**
+         * \brief Returns the vertex attribute index of the draw ID attribute, following all layout attributes.
+         */
+        GLuint getDrawIdAttribIndex() const;
+
+        MeshArena const& getMeshArena() const;
+
+    private:
+        struct Draw
+        {
+            MeshArena::MeshAllocation allocation;
+            GLuint                    command_idx;
+            bool                      valid;
+        };
+
+        struct Block
+        {
+            std::vector<DrawElementsCommand> commands;
+            std::vector<DrawId>              draw_ids; ///< draw ID per command
+            BufferObject                     command_buffer;
+            DirtyRangeSet                    dirty_commands;
+        };
+
+        /**
+         * \brief Create command buffers and draw ID bindings for arena blocks added since the last call.
+         */
+        void addBlocks();
+
+        /**
+         * \brief Make sure the draw ID buffer contains IDs up to at least draw_id.
+         */
+        void reserveDrawIds(DrawId draw_id);
+
+        void setDrawIdBinding(GLuint block);
+
+        MeshArena           m_arena;
+        std::vector<Draw>   m_draws;
+        std::vector<DrawId> m_free_draw_ids;
+        std::vector<Block>  m_blocks;
+        GLuint              m_draw_cnt;
+
+        BufferObject m_draw_id_buffer; ///< Contains 0,1,2,... for the draw ID vertex attribute
+        GLuint       m_draw_id_binding;
+        GLuint       m_draw_id_attrib_idx;
+    };
+
+    inline MeshBatch::MeshBatch(std::vector<VertexLayout> const& vertex_descriptor,
+                                GLenum const                     index_type,
+                                GLenum const                     primitive_type,
+                                GLuint const                     block_vertex_cnt,
+                                GLuint const                     block_index_cnt)
+        : m_arena(vertex_descriptor, index_type, primitive_type, block_vertex_cnt, block_index_cnt),
+          m_draws(),
+          m_free_draw_ids(),
+          m_blocks(),
+          m_draw_cnt(0),
+          m_draw_id_buffer(GL_ARRAY_BUFFER, static_cast<GLvoid const*>(nullptr), 0),
+          m_draw_id_binding(static_cast<GLuint>(vertex_descriptor.size())),
+          m_draw_id_attrib_idx(0)
+    {
+        for (auto const& layout : vertex_descriptor)
+        {
+            m_draw_id_attrib_idx += static_cast<GLuint>(layout.attributes.size());
+        }
+
+        reserveDrawIds(0);
+        addBlocks();
+    }
+
+    inline MeshBatch::DrawId MeshBatch::add(std::vector<void const*> const& vertex_data,
+                                            GLuint                          vertex_cnt,
+                                            void const*                     index_data,
+                                            GLuint                          index_cnt,
+                                            GLuint                          instance_cnt)
+    {
+        auto allocation = m_arena.allocate(vertex_data, vertex_cnt, index_data, index_cnt);
+        addBlocks();
+
+        DrawId draw_id = static_cast<DrawId>(m_draws.size());
+        if (!m_free_draw_ids.empty())
+        {
+            draw_id = m_free_draw_ids.back();
+            m_free_draw_ids.pop_back();
+        }
+        else
+        {
+            m_draws.push_back(Draw());
+            reserveDrawIds(draw_id);
+        }
+
+        Block& block = m_blocks[allocation.vertices.block];
+        GLuint command_idx = static_cast<GLuint>(block.commands.size());
+        block.commands.push_back(m_arena.getDrawCommand(allocation, instance_cnt, draw_id));
+        block.draw_ids.push_back(draw_id);
+        block.dirty_commands.add(command_idx * sizeof(DrawElementsCommand), sizeof(DrawElementsCommand));
+
+        m_draws[draw_id] = {allocation, command_idx, true};
+        ++m_draw_cnt;
+
+        return draw_id;
+    }
+
+    template<typename VertexDataType, typename IndexDataType>
+    inline MeshBatch::DrawId MeshBatch::add(std::vector<std::vector<VertexDataType>> const& vertex_data,
+                                            std::vector<IndexDataType> const&               index_data,
+                                            GLuint                                          instance_cnt)
+    {
+        auto const& vertex_descriptor = m_arena.getVertexLayouts();
+        if (vertex_data.size() != vertex_descriptor.size() || vertex_descriptor.empty())
+        {
+            throw MeshException("MeshBatch::add - vertex data does not match vertex layouts");
+        }
+
+        std::vector<void const*> vertex_data_ptrs;
+        for (auto const& data : vertex_data)
+        {
+            vertex_data_ptrs.push_back(data.data());
+        }
+
+        GLuint vertex_cnt = static_cast<GLuint>(vertex_data[0].size() * sizeof(VertexDataType) /
+                                                static_cast<std::size_t>(vertex_descriptor[0].stride));
+        GLuint index_cnt = static_cast<GLuint>(index_data.size() * sizeof(IndexDataType) /
+                                               computeByteSize(m_arena.getIndexType()));
+
+        return add(vertex_data_ptrs, vertex_cnt, index_data.data(), index_cnt, instance_cnt);
+    }
+
+    inline void MeshBatch::remove(DrawId draw_id)
+    {
+        if (!contains(draw_id))
+        {
+            throw MeshException("MeshBatch::remove - invalid draw ID");
+        }
+
+        Draw&  draw = m_draws[draw_id];
+        Block& block = m_blocks[draw.allocation.vertices.block];
+
+        // move the last command of the block into the gap
+        GLuint last_idx = static_cast<GLuint>(block.commands.size() - 1);
+        if (draw.command_idx != last_idx)
+        {
+            block.commands[draw.command_idx] = block.commands[last_idx];
+            block.draw_ids[draw.command_idx] = block.draw_ids[last_idx];
+            m_draws[block.draw_ids[draw.command_idx]].command_idx = draw.command_idx;
+            block.dirty_commands.add(draw.command_idx * sizeof(DrawElementsCommand), sizeof(DrawElementsCommand));
+        }
+        block.commands.pop_back();
+        block.draw_ids.pop_back();
+
+        m_arena.free(draw.allocation);
+        draw.valid = false;
+        m_free_draw_ids.push_back(draw_id);
+        --m_draw_cnt;
+    }
+
+    inline void MeshBatch::setInstanceCount(DrawId draw_id, GLuint instance_cnt)
+    {
+        if (!contains(draw_id))
+        {
+            throw MeshException("MeshBatch::setInstanceCount - invalid draw ID");
+        }
+
+        Draw const& draw = m_draws[draw_id];
+        Block&      block = m_blocks[draw.allocation.vertices.block];
+
+        block.commands[draw.command_idx].instance_cnt = instance_cnt;
+        block.dirty_commands.add(draw.command_idx * sizeof(DrawElementsCommand), sizeof(DrawElementsCommand));
+    }
+
+    inline bool MeshBatch::contains(DrawId draw_id) const
+    {
+        return draw_id < m_draws.size() && m_draws[draw_id].valid;
+    }
+
+    inline void MeshBatch::draw()
+    {
+        flush();
+
+        for (GLuint block_idx = 0; block_idx < m_blocks.size(); ++block_idx)
+        {
+            Block const& block = m_blocks[block_idx];
+            if (block.commands.empty())
+            {
+                continue;
+            }
+
+            m_arena.bindVertexArray(block_idx);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, block.command_buffer.getName());
+            glMultiDrawElementsIndirect(m_arena.getPrimitiveType(),
+                                        m_arena.getIndexType(),
+                                        nullptr,
+                                        static_cast<GLsizei>(block.commands.size()),
+                                        0);
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    inline void MeshBatch::flush()
+    {
+        for (auto& block : m_blocks)
+        {
+            GLsizeiptr byte_size = static_cast<GLsizeiptr>(block.commands.size() * sizeof(DrawElementsCommand));
+            block.command_buffer.resize(byte_size);
+
+            for (auto const& range : block.dirty_commands.coalesce(0))
+            {
+                // commands beyond the current end were removed again before the upload
+                GLintptr end = std::min(static_cast<GLintptr>(byte_size), range.end);
+                if (range.begin < end)
+                {
+                    block.command_buffer.bufferSubData(reinterpret_cast<GLubyte const*>(block.commands.data()) +
+                                                           range.begin,
+                                                       end - range.begin,
+                                                       range.begin);
+                }
+            }
+            block.dirty_commands.clear();
+        }
+    }
+
+    inline DrawElementsCommand const& MeshBatch::getDrawCommand(DrawId draw_id) const
+    {
+        if (!contains(draw_id))
+        {
+            throw MeshException("MeshBatch::getDrawCommand - invalid draw ID");
+        }
+
+        Draw const& draw = m_draws[draw_id];
+        return m_blocks[draw.allocation.vertices.block].commands[draw.command_idx];
+    }
+
+    inline GLuint MeshBatch::getDrawCount() const
+    {
+        return m_draw_cnt;
+    }
+
+    inline GLuint MeshBatch::getDrawCount(GLuint block) const
+    {
+        return static_cast<GLuint>(m_blocks[block].commands.size());
+    }
+
+    inline BufferObject const& MeshBatch::getCommandBuffer(GLuint block) const
+    {
+        return m_blocks[block].command_buffer;
+    }
+
+    inline GLuint MeshBatch::getDrawIdAttribIndex() const
+    {
+        return m_draw_id_attrib_idx;
+    }
+
+    inline MeshArena const& MeshBatch::getMeshArena() const
+    {
+        return m_arena;
+    }
+
+    inline void MeshBatch::addBlocks()
+    {
+        while (m_blocks.size() < m_arena.getBlockCount())
+        {
+            m_blocks.push_back(Block{{},
+                                     {},
+                                     BufferObject(GL_DRAW_INDIRECT_BUFFER, static_cast<GLvoid const*>(nullptr), 0),
+                                     DirtyRangeSet()});
+            setDrawIdBinding(static_cast<GLuint>(m_blocks.size() - 1));
+        }
+    }
+
+    inline void MeshBatch::reserveDrawIds(DrawId draw_id)
+    {
+        GLsizeiptr required_byte_size = static_cast<GLsizeiptr>((draw_id + 1) * sizeof(GLuint));
+        if (required_byte_size <= m_draw_id_buffer.getByteSize())
+        {
+            return;
+        }
+
+        // grow geometrically, the IDs are simply 0,1,2,...
+        GLuint draw_id_cnt = static_cast<GLuint>(m_draw_id_buffer.getByteSize() / sizeof(GLuint));
+        draw_id_cnt = std::max({draw_id + 1, 2 * draw_id_cnt, 256u});
+
+        std::vector<GLuint> draw_ids(draw_id_cnt);
+        for (GLuint i = 0; i < draw_id_cnt; ++i)
+        {
+            draw_ids[i] = i;
+        }
+        m_draw_id_buffer.rebuffer(draw_ids);
+
+        // the name is kept by rebuffer, so existing bindings stay valid
+    }
+
+    inline void MeshBatch::setDrawIdBinding(GLuint block)
+    {
+        GLuint va_handle = m_arena.getVertexArray(block);
+
+        glEnableVertexArrayAttrib(va_handle, m_draw_id_attrib_idx);
+        glVertexArrayAttribIFormat(va_handle, m_draw_id_attrib_idx, 1, GL_UNSIGNED_INT, 0);
+        glVertexArrayAttribBinding(va_handle, m_draw_id_attrib_idx, m_draw_id_binding);
+        glVertexArrayVertexBuffer(va_handle, m_draw_id_binding, m_draw_id_buffer.getName(), 0, sizeof(GLuint));
+
+        // with a divisor exceeding any instance count, all instances fetch the element at base_instance
+        glVertexArrayBindingDivisor(va_handle, m_draw_id_binding, 1u << 30);
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw MeshException("MeshBatch::setDrawIdBinding - OpenGL error " + std::to_string(err));
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHBATCH_HPP
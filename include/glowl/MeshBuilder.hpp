@@ -0,0 +1,367 @@
+/*
+ * MeshBuilder.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHBUILDER_HPP
+#define GLOWL_MESHBUILDER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "IndexPacking.hpp"
+#include "Mesh.hpp"
+#include "NamePool.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class MeshBuilder
+     *
+     * \brief Collects and prepares mesh data without an OpenGL context, e.g. on loader threads, so that only the
+     * creation of buffers and vertex array remains for the GL thread.
+     *
+     * prepare() validates vertex layouts and byte sizes, checks indices against the vertex count and narrows the
+     * indices (see packIndexData()). It requires no OpenGL context and may run on any thread, but a single builder
+     * must not be used by several threads at once. finalize() creates the Mesh and requires an active context.
+     *
+     * \author Michael Becher
+     */
+    class MeshBuilder
+    {
+    public:
+        /**
+         * \brief MeshBuilder constructor. No OpenGL context required.
+         */
+        explicit MeshBuilder(GLenum primitive_type = GL_TRIANGLES, GLenum usage = GL_STATIC_DRAW);
+
+        MeshBuilder(const MeshBuilder&) = delete;
+        MeshBuilder(MeshBuilder&&) = default;
+        MeshBuilder& operator=(MeshBuilder&&) = default;
+        MeshBuilder& operator=(const MeshBuilder&) = delete;
+
+        /**
+         * \brief Add a vertex buffer described by the given layout. The data is copied.
+         */
+        void addVertexData(void const* data, std::size_t byte_size, VertexLayout const& vertex_layout);
+
+        template<typename VertexDataType>
+        void addVertexData(std::vector<VertexDataType> const& data, VertexLayout const& vertex_layout);
+
+        /**
+         * \brief Add a vertex buffer described by the given layout, taking over the data without a copy.
+         */
+        void addVertexData(std::vector<GLubyte>&& data, VertexLayout const& vertex_layout);
+
+        /**
+         * \brief Set the index data. The data is copied.
+         *
+         * \param narrow Convert the indices to the narrowest index type that fits during prepare()
+         */
+        void setIndexData(void const* data, std::size_t byte_size, GLenum index_type, bool narrow = true);
+
+        template<typename IndexDataType>
+        void setIndexData(std::vector<IndexDataType> const& data, GLenum index_type, bool narrow = true);
+
+        /**
+         * \brief Validate and narrow the data. No OpenGL context required. Called by finalize() if necessary.
+         * Throws a MeshException on invalid data.
+         */
+        void prepare();
+
+        /**
+         * \brief Create the mesh, preparing the data first if necessary. The builder is empty afterwards.
+         *
+         * Note: Active OpenGL context required.
+         */
+        std::unique_ptr<Mesh> finalize(NamePool* buffer_pool = nullptr, NamePool* vertex_array_pool = nullptr);
+
+        /**
+         * \brief Create the meshes of all builders.
+         *
+         * All builders are prepared before the first mesh is created, so invalid data fails without creating any
+         * OpenGL objects. If name pools are given, names for all buffers and vertex arrays are reserved up front,
+         * i.e. created with (at most) one glCreateBuffers and one glCreateVertexArrays call for the whole batch.
+         *
+         * Note: Active OpenGL context required.
+         */
+        static std::vector<std::unique_ptr<Mesh>> finalize(std::vector<MeshBuilder>& builders,
+                                                           NamePool*                 buffer_pool = nullptr,
+                                                           NamePool*                 vertex_array_pool = nullptr);
+
+        bool isPrepared() const
+        {
+            return m_prepared;
+        }
+
+        GLuint getVertexCount() const
+        {
+            return m_vertex_cnt;
+        }
+
+        /**
+         * \brief Returns the number of indices, valid after prepare().
+         */
+        GLuint getIndexCount() const
+        {
+            return static_cast<GLuint>(m_index_data.getIndexCount());
+        }
+
+        /**
+         * \brief Returns the index type, i.e. the narrowed index type after prepare().
+         */
+        GLenum getIndexType() const
+        {
+            return m_index_data.index_type;
+        }
+
+        /**
+         * \brief Returns the byte size of all vertex and index data that finalize() uploads.
+         */
+        std::size_t getByteSize() const;
+
+        std::vector<VertexLayout> const& getVertexLayouts() const
+        {
+            return m_vertex_descriptor;
+        }
+
+    private:
+        std::vector<std::vector<GLubyte>> m_vertex_data;
+        std::vector<VertexLayout>         m_vertex_descriptor;
+        PackedIndexData                   m_index_data;
+        bool                              m_narrow_indices;
+        GLenum                            m_primitive_type;
+        GLenum                            m_usage;
+        GLuint                            m_vertex_cnt;
+        bool                              m_prepared;
+    };
+
+    inline MeshBuilder::MeshBuilder(GLenum primitive_type, GLenum usage)
+        : m_vertex_data(),
+          m_vertex_descriptor(),
+          m_index_data(),
+          m_narrow_indices(true),
+          m_primitive_type(primitive_type),
+          m_usage(usage),
+          m_vertex_cnt(0),
+          m_prepared(false)
+    {
+    }
+
+    inline void MeshBuilder::addVertexData(void const* data, std::size_t byte_size, VertexLayout const& vertex_layout)
+    {
+        GLubyte const* bytes = static_cast<GLubyte const*>(data);
+        addVertexData(std::vector<GLubyte>(bytes, bytes + byte_size), vertex_layout);
+    }
+
+    template<typename VertexDataType>
+    inline void MeshBuilder::addVertexData(std::vector<VertexDataType> const& data, VertexLayout const& vertex_layout)
+    {
+        addVertexData(data.data(), data.size() * sizeof(VertexDataType), vertex_layout);
+    }
+
+    inline void MeshBuilder::addVertexData(std::vector<GLubyte>&& data, VertexLayout const& vertex_layout)
+    {
+        m_vertex_data.push_back(std::move(data));
+        m_vertex_descriptor.push_back(vertex_layout);
+        m_prepared = false;
+    }
+
+    inline void MeshBuilder::setIndexData(void const* data, std::size_t byte_size, GLenum index_type, bool narrow)
+    {
+        GLubyte const* bytes = static_cast<GLubyte const*>(data);
+        m_index_data = PackedIndexData();
+        m_index_data.index_data.assign(bytes, bytes + byte_size);
+        m_index_data.index_type = index_type;
+        m_index_data.unpacked_byte_size = byte_size;
+        m_narrow_indices = narrow;
+        m_prepared = false;
+    }
+
+    template<typename IndexDataType>
+    inline void MeshBuilder::setIndexData(std::vector<IndexDataType> const& data, GLenum index_type, bool narrow)
+    {
+        setIndexData(data.data(), data.size() * sizeof(IndexDataType), index_type, narrow);
+    }
+
+    inline void MeshBuilder::prepare()
+    {
+        if (m_prepared)
+        {
+            return;
+        }
+
+        // vertex layouts and buffer sizes
+        m_vertex_cnt = 0;
+        bool has_vertex_cnt = false;
+        for (std::size_t i = 0; i < m_vertex_descriptor.size(); ++i)
+        {
+            VertexLayout const& vertex_layout = m_vertex_descriptor[i];
+            if (vertex_layout.stride <= 0)
+            {
+                throw MeshException("MeshBuilder::prepare - Vertex layout " + std::to_string(i) +
+                                    " requires a stride > 0");
+            }
+
+            for (auto const& attribute : vertex_layout.attributes)
+            {
+                bool        valid_size = (attribute.size >= 1 && attribute.size <= 4) || attribute.size == GL_BGRA;
+                std::size_t attribute_byte_size = valid_size ? computeAttributeByteSize(attribute) : 0;
+                if (attribute_byte_size == 0 || attribute.offset < 0 ||
+                    static_cast<std::size_t>(attribute.offset) + attribute_byte_size >
+                        static_cast<std::size_t>(vertex_layout.stride))
+                {
+                    throw MeshException("MeshBuilder::prepare - Invalid attribute in vertex layout " +
+                                        std::to_string(i));
+                }
+            }
+
+            // per-instance buffers (divisor > 0) are independent of the vertex count
+            std::size_t stride = static_cast<std::size_t>(vertex_layout.stride);
+            std::size_t vertex_cnt = m_vertex_data[i].size() / stride;
+            if (m_vertex_data[i].size() % stride != 0 ||
+                (vertex_layout.divisor == 0 && has_vertex_cnt && vertex_cnt != m_vertex_cnt))
+            {
+                throw MeshException("MeshBuilder::prepare - Byte size of vertex buffer " + std::to_string(i) +
+                                    " does not match the vertex count");
+            }
+            if (vertex_layout.divisor == 0)
+            {
+                m_vertex_cnt = static_cast<GLuint>(vertex_cnt);
+                has_vertex_cnt = true;
+            }
+        }
+
+        // indices
+        GLenum index_type = m_index_data.index_type;
+        if (index_type != GL_UNSIGNED_BYTE && index_type != GL_UNSIGNED_SHORT && index_type != GL_UNSIGNED_INT)
+        {
+            throw MeshException("MeshBuilder::prepare - Invalid index type");
+        }
+
+        std::size_t index_byte_size = computeByteSize(index_type);
+        if (m_index_data.index_data.size() % index_byte_size != 0)
+        {
+            throw MeshException("MeshBuilder::prepare - Index data byte size is not a multiple of the index size");
+        }
+
+        std::size_t index_cnt = m_index_data.index_data.size() / index_byte_size;
+        if ((m_primitive_type == GL_TRIANGLES && index_cnt % 3 != 0) ||
+            (m_primitive_type == GL_LINES && index_cnt % 2 != 0))
+        {
+            throw MeshException("MeshBuilder::prepare - Index count does not match the primitive type");
+        }
+
+        // work on a copy, the set index data stays untouched if validation fails
+        PackedIndexData index_data;
+        if (m_narrow_indices)
+        {
+            // indices may already be rebased by an earlier prepare(), keep their base vertex
+            index_data = packIndexData(m_index_data.index_data.data(),
+                                       m_index_data.index_data.size(),
+                                       m_index_data.index_type);
+            index_data.base_vertex += m_index_data.base_vertex;
+            index_data.unpacked_byte_size = m_index_data.unpacked_byte_size;
+        }
+        else
+        {
+            index_data = m_index_data;
+            index_data.index_range = computeIndexRange(index_data.index_data.data(), index_cnt, index_data.index_type);
+        }
+
+        if (has_vertex_cnt && !index_data.index_range.empty() &&
+            static_cast<std::size_t>(index_data.index_range.max_index) + index_data.base_vertex >= m_vertex_cnt)
+        {
+            throw MeshException("MeshBuilder::prepare - Index out of range");
+        }
+
+        m_index_data = std::move(index_data);
+        m_prepared = true;
+    }
+
+    inline std::unique_ptr<Mesh> MeshBuilder::finalize(NamePool* buffer_pool, NamePool* vertex_array_pool)
+    {
+        prepare();
+
+        std::vector<void const*> vertex_data_pointers;
+        std::vector<std::size_t> vertex_data_byte_sizes;
+        for (auto const& vertex_data : m_vertex_data)
+        {
+            vertex_data_pointers.push_back(vertex_data.data());
+            vertex_data_byte_sizes.push_back(vertex_data.size());
+        }
+
+        std::unique_ptr<Mesh> retval(new Mesh(vertex_data_pointers,
+                                              vertex_data_byte_sizes,
+                                              m_vertex_descriptor,
+                                              m_index_data,
+                                              m_primitive_type,
+                                              m_usage,
+                                              buffer_pool,
+                                              vertex_array_pool));
+
+        // the data lives on the GPU now
+        m_vertex_data = std::vector<std::vector<GLubyte>>();
+        m_vertex_descriptor.clear();
+        m_index_data = PackedIndexData();
+        m_vertex_cnt = 0;
+        m_prepared = false;
+
+        return retval;
+    }
+
+    inline std::vector<std::unique_ptr<Mesh>> MeshBuilder::finalize(std::vector<MeshBuilder>& builders,
+                                                                    NamePool*                 buffer_pool,
+                                                                    NamePool*                 vertex_array_pool)
+    {
+        for (auto& builder : builders)
+        {
+            builder.prepare();
+        }
+
+        if (buffer_pool != nullptr)
+        {
+            std::size_t buffer_cnt = 0;
+            for (auto const& builder : builders)
+            {
+                buffer_cnt += builder.m_vertex_data.size() + 1;
+            }
+            buffer_pool->reserve(static_cast<GLsizei>(buffer_cnt));
+        }
+        if (vertex_array_pool != nullptr)
+        {
+            vertex_array_pool->reserve(static_cast<GLsizei>(builders.size()));
+        }
+
+        std::vector<std::unique_ptr<Mesh>> retval;
+        retval.reserve(builders.size());
+        for (auto& builder : builders)
+        {
+            retval.push_back(builder.finalize(buffer_pool, vertex_array_pool));
+        }
+
+        return retval;
+    }
+
+    inline std::size_t MeshBuilder::getByteSize() const
+    {
+        std::size_t retval = m_index_data.index_data.size();
+        for (auto const& vertex_data : m_vertex_data)
+        {
+            retval += vertex_data.size();
+        }
+        return retval;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHBUILDER_HPP
@@ -0,0 +1,573 @@
+/*
+ * MeshCache.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHCACHE_HPP
+#define GLOWL_MESHCACHE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "BoundingVolumes.hpp"
+#include "Exceptions.hpp"
+#include "Mesh.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    namespace detail
+    {
+        /*
+         * File layout (native byte order): header, one MeshCacheLayout per vertex buffer, the attributes of all
+         * layouts in order, one MeshCacheLod per level of detail, then the vertex buffer payloads and the index
+         * payload, each starting at a multiple of the alignment given to the writer.
+         */
+        struct MeshCacheHeader
+        {
+            char          magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t index_type;
+            std::uint32_t primitive_type;
+            std::int32_t  base_vertex;
+            std::uint32_t layout_cnt;
+            float         bounds_min[3];
+            float         bounds_max[3];
+            std::uint32_t lod_cnt;
+            std::uint64_t index_data_offset;
+            std::uint64_t index_data_byte_size;
+        };
+
+        struct MeshCacheLayout
+        {
+            std::uint32_t stride;
+            std::uint32_t attribute_cnt;
+            std::uint32_t divisor;
+            std::uint32_t reserved;
+            std::uint64_t data_offset;
+            std::uint64_t data_byte_size;
+        };
+
+        struct MeshCacheAttribute
+        {
+            std::int32_t  size;
+            std::uint32_t type;
+            std::uint32_t normalized;
+            std::int32_t  offset;
+            std::uint32_t shader_input_type;
+        };
+
+        struct MeshCacheLod
+        {
+            std::uint32_t first_index;
+            std::uint32_t index_cnt;
+            float         error;
+        };
+
+        constexpr char          mesh_cache_magic[8] = {'G', 'L', 'O', 'W', 'L', 'M', 'C', '\0'};
+        constexpr std::uint32_t mesh_cache_version = 3;
+        constexpr std::uint32_t mesh_cache_byte_order = 0x01020304u;
+    } // namespace detail
+
+    /**
+     * \brief Write vertex and index data in the glowl binary mesh cache format, see MeshCacheFile.
+     *
+     * \param alignment Byte alignment of the payloads within the file, the default matches common page sizes so that
+     * mapped payloads start on a page boundary
+     */
+    inline void writeMeshCache(std::string const&               path,
+                               std::vector<void const*> const&  vertex_data,
+                               std::vector<std::size_t> const&  vertex_data_byte_sizes,
+                               std::vector<VertexLayout> const& vertex_descriptor,
+                               void const*                      index_data,
+                               std::size_t                      index_data_byte_size,
+                               GLenum                           index_type,
+                               GLenum                           primitive_type,
+                               GLint                            base_vertex = 0,
+                               BoundingBox const&               bounds = BoundingBox(),
+                               std::vector<LodLevel> const&     lod_levels = {},
+                               std::size_t                      alignment = 4096)
+    {
+        if (vertex_data.size() != vertex_data_byte_sizes.size() || vertex_data.size() != vertex_descriptor.size())
+        {
+            throw MeshException("writeMeshCache - Vector parameters of different size!");
+        }
+        if (alignment == 0)
+        {
+            throw MeshException("writeMeshCache - Invalid alignment");
+        }
+
+        auto align = [alignment](std::uint64_t offset) {
+            return (offset + alignment - 1) / alignment * alignment;
+        };
+
+        detail::MeshCacheHeader header = {};
+        std::memcpy(header.magic, detail::mesh_cache_magic, sizeof(header.magic));
+        header.version = detail::mesh_cache_version;
+        header.byte_order = detail::mesh_cache_byte_order;
+        header.index_type = index_type;
+        header.primitive_type = primitive_type;
+        header.base_vertex = base_vertex;
+        header.layout_cnt = static_cast<std::uint32_t>(vertex_descriptor.size());
+        std::copy(bounds.min, bounds.min + 3, header.bounds_min);
+        std::copy(bounds.max, bounds.max + 3, header.bounds_max);
+        header.lod_cnt = static_cast<std::uint32_t>(lod_levels.size());
+
+        std::vector<detail::MeshCacheLayout>    layouts;
+        std::vector<detail::MeshCacheAttribute> attributes;
+        for (auto const& vertex_layout : vertex_descriptor)
+        {
+            layouts.push_back(detail::MeshCacheLayout{static_cast<std::uint32_t>(vertex_layout.stride),
+                                                      static_cast<std::uint32_t>(vertex_layout.attributes.size()),
+                                                      vertex_layout.divisor,
+                                                      0,
+                                                      0,
+                                                      0});
+            for (auto const& attribute : vertex_layout.attributes)
+            {
+                attributes.push_back(detail::MeshCacheAttribute{attribute.size,
+                                                                attribute.type,
+                                                                attribute.normalized,
+                                                                attribute.offset,
+                                                                attribute.shader_input_type});
+            }
+        }
+
+        std::vector<detail::MeshCacheLod> lods;
+        for (auto const& level : lod_levels)
+        {
+            lods.push_back(detail::MeshCacheLod{level.first_index, level.index_cnt, level.error});
+        }
+
+        std::uint64_t offset = sizeof(detail::MeshCacheHeader) + layouts.size() * sizeof(detail::MeshCacheLayout) +
+                               attributes.size() * sizeof(detail::MeshCacheAttribute) +
+                               lods.size() * sizeof(detail::MeshCacheLod);
+        for (std::size_t i = 0; i < layouts.size(); ++i)
+        {
+            offset = align(offset);
+            layouts[i].data_offset = offset;
+            layouts[i].data_byte_size = vertex_data_byte_sizes[i];
+            offset += vertex_data_byte_sizes[i];
+        }
+        header.index_data_offset = align(offset);
+        header.index_data_byte_size = index_data_byte_size;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw MeshException("writeMeshCache - Could not open " + path);
+        }
+
+        std::uint64_t written = 0;
+        auto          write = [&file, &written](void const* data, std::uint64_t byte_size) {
+            file.write(static_cast<char const*>(data), static_cast<std::streamsize>(byte_size));
+            written += byte_size;
+        };
+        auto pad = [&write, &written](std::uint64_t target) {
+            std::vector<char> zeros(static_cast<std::size_t>(target - written), 0);
+            write(zeros.data(), zeros.size());
+        };
+
+        write(&header, sizeof(header));
+        write(layouts.data(), layouts.size() * sizeof(detail::MeshCacheLayout));
+        write(attributes.data(), attributes.size() * sizeof(detail::MeshCacheAttribute));
+        write(lods.data(), lods.size() * sizeof(detail::MeshCacheLod));
+        for (std::size_t i = 0; i < layouts.size(); ++i)
+        {
+            pad(layouts[i].data_offset);
+            write(vertex_data[i], layouts[i].data_byte_size);
+        }
+        pad(header.index_data_offset);
+        write(index_data, index_data_byte_size);
+
+        if (!file)
+        {
+            throw MeshException("writeMeshCache - Could not write " + path);
+        }
+    }
+
+    /**
+     * \brief Write a mesh in the glowl binary mesh cache format, reading its buffers back from the GPU.
+     *
+     * The bounds and levels of detail are taken from the mesh, see Mesh::getBoundingBox() and Mesh::getLodLevels().
+     *
+     * Note: Active OpenGL context required.
+     */
+    inline void writeMeshCache(std::string const& path, Mesh const& mesh, std::size_t alignment = 4096)
+    {
+        std::vector<VertexLayout>         vertex_descriptor = mesh.getVertexLayouts();
+        std::vector<std::vector<GLubyte>> vertex_data(mesh.getVbos().size());
+        std::vector<void const*>          vertex_data_pointers;
+        std::vector<std::size_t>          vertex_data_byte_sizes;
+        for (std::size_t i = 0; i < mesh.getVbos().size(); ++i)
+        {
+            auto const& vbo = mesh.getVbos()[i];
+            vertex_data[i].resize(static_cast<std::size_t>(vbo.getByteSize()));
+            glGetNamedBufferSubData(vbo.getName(), 0, vbo.getByteSize(), vertex_data[i].data());
+            vertex_data_pointers.push_back(vertex_data[i].data());
+            vertex_data_byte_sizes.push_back(vertex_data[i].size());
+        }
+
+        std::vector<GLubyte> index_data(static_cast<std::size_t>(mesh.getIbo().getByteSize()));
+        glGetNamedBufferSubData(mesh.getIbo().getName(), 0, mesh.getIbo().getByteSize(), index_data.data());
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw MeshException("writeMeshCache - OpenGL error " + std::to_string(err));
+        }
+
+        writeMeshCache(path,
+                       vertex_data_pointers,
+                       vertex_data_byte_sizes,
+                       vertex_descriptor,
+                       index_data.data(),
+                       index_data.size(),
+                       mesh.getIndexType(),
+                       mesh.getPrimitiveType(),
+                       mesh.getBaseVertex(),
+                       mesh.getBoundingBox(),
+                       mesh.getLodLevels(),
+                       alignment);
+    }
+
+    /**
+     * \class MeshCacheFile
+     *
+     * \brief Read-only memory mapping of a glowl binary mesh cache file (see writeMeshCache()).
+     *
+     * Opening and validating the file requires no OpenGL context. The payload pointers reference the mapping
+     * directly and stay valid for the lifetime of the object, so mesh creation uploads straight from the page cache
+     * without intermediate copies.
+     *
+     * \author Michael Becher
+     */
+    class MeshCacheFile
+    {
+    public:
+        explicit MeshCacheFile(std::string const& path);
+        ~MeshCacheFile();
+
+        MeshCacheFile(const MeshCacheFile&) = delete;
+        MeshCacheFile(MeshCacheFile&&) = delete;
+        MeshCacheFile& operator=(const MeshCacheFile&) = delete;
+        MeshCacheFile& operator=(MeshCacheFile&&) = delete;
+
+        /**
+         * \brief Create a mesh from the mapped payloads.
+         *
+         * Note: Active OpenGL context required.
+         */
+        std::unique_ptr<Mesh> createMesh(GLenum    usage = GL_STATIC_DRAW,
+                                         NamePool* buffer_pool = nullptr,
+                                         NamePool* vertex_array_pool = nullptr) const;
+
+        /**
+         * \brief Returns pointers into the mapping, suitable for the Mesh constructor.
+         */
+        Mesh::VertexPtrDataList const& getVertexData() const
+        {
+            return m_vertex_data;
+        }
+
+        void const* getIndexData() const
+        {
+            return m_data + m_header.index_data_offset;
+        }
+
+        std::size_t getIndexDataByteSize() const
+        {
+            return static_cast<std::size_t>(m_header.index_data_byte_size);
+        }
+
+        GLenum getIndexType() const
+        {
+            return m_header.index_type;
+        }
+
+        GLenum getPrimitiveType() const
+        {
+            return m_header.primitive_type;
+        }
+
+        GLint getBaseVertex() const
+        {
+            return m_header.base_vertex;
+        }
+
+        BoundingBox getBounds() const
+        {
+            BoundingBox retval;
+            std::copy(m_header.bounds_min, m_header.bounds_min + 3, retval.min);
+            std::copy(m_header.bounds_max, m_header.bounds_max + 3, retval.max);
+            return retval;
+        }
+
+        std::vector<LodLevel> const& getLodLevels() const
+        {
+            return m_lod_levels;
+        }
+
+    private:
+        void map(std::string const& path);
+        void unmap();
+        void parse(std::string const& path);
+
+        GLubyte const*          m_data;
+        std::size_t             m_byte_size;
+        detail::MeshCacheHeader m_header;
+        Mesh::VertexPtrDataList m_vertex_data;
+        std::vector<LodLevel>   m_lod_levels;
+
+#if defined(_WIN32)
+        HANDLE m_file;
+        HANDLE m_mapping;
+#endif
+    };
+
+    inline MeshCacheFile::MeshCacheFile(std::string const& path)
+        : m_data(nullptr),
+          m_byte_size(0),
+          m_header(),
+          m_vertex_data(),
+          m_lod_levels()
+#if defined(_WIN32)
+          ,
+          m_file(INVALID_HANDLE_VALUE),
+          m_mapping(nullptr)
+#endif
+    {
+        map(path);
+        try
+        {
+            parse(path);
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    inline MeshCacheFile::~MeshCacheFile()
+    {
+        unmap();
+    }
+
+    inline std::unique_ptr<Mesh> MeshCacheFile::createMesh(GLenum    usage,
+                                                           NamePool* buffer_pool,
+                                                           NamePool* vertex_array_pool) const
+    {
+        std::unique_ptr<Mesh> retval(new Mesh(m_vertex_data,
+                                              getIndexData(),
+                                              getIndexDataByteSize(),
+                                              getIndexType(),
+                                              getPrimitiveType(),
+                                              usage,
+                                              buffer_pool,
+                                              vertex_array_pool));
+        retval->setBaseVertex(getBaseVertex());
+        retval->setLodLevels(m_lod_levels);
+        return retval;
+    }
+
+    inline void MeshCacheFile::map(std::string const& path)
+    {
+#if defined(_WIN32)
+        m_file = CreateFileA(path.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                             nullptr);
+        LARGE_INTEGER file_size;
+        if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &file_size))
+        {
+            unmap();
+            throw MeshException("MeshCacheFile::map - Could not open " + path);
+        }
+        m_byte_size = static_cast<std::size_t>(file_size.QuadPart);
+        if (m_byte_size < sizeof(detail::MeshCacheHeader))
+        {
+            unmap();
+            throw MeshException("MeshCacheFile::map - File too small " + path);
+        }
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data = m_mapping != nullptr ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (data == nullptr)
+        {
+            unmap();
+            throw MeshException("MeshCacheFile::map - Could not map " + path);
+        }
+        m_data = static_cast<GLubyte const*>(data);
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file == -1)
+        {
+            throw MeshException("MeshCacheFile::map - Could not open " + path);
+        }
+
+        struct stat file_stat;
+        if (fstat(file, &file_stat) != 0 ||
+            static_cast<std::size_t>(file_stat.st_size) < sizeof(detail::MeshCacheHeader))
+        {
+            close(file);
+            throw MeshException("MeshCacheFile::map - File too small " + path);
+        }
+        m_byte_size = static_cast<std::size_t>(file_stat.st_size);
+
+        // the mapping stays valid after closing the descriptor
+        void* data = mmap(nullptr, m_byte_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            throw MeshException("MeshCacheFile::map - Could not map " + path);
+        }
+        madvise(data, m_byte_size, MADV_SEQUENTIAL);
+        m_data = static_cast<GLubyte const*>(data);
+#endif
+    }
+
+    inline void MeshCacheFile::unmap()
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<GLubyte*>(m_data), m_byte_size);
+        }
+#endif
+        m_data = nullptr;
+    }
+
+    inline void MeshCacheFile::parse(std::string const& path)
+    {
+        std::memcpy(&m_header, m_data, sizeof(m_header));
+        if (std::memcmp(m_header.magic, detail::mesh_cache_magic, sizeof(m_header.magic)) != 0)
+        {
+            throw MeshException("MeshCacheFile::parse - Not a mesh cache file " + path);
+        }
+        if (m_header.version != detail::mesh_cache_version || m_header.byte_order != detail::mesh_cache_byte_order)
+        {
+            throw MeshException("MeshCacheFile::parse - Unsupported version or byte order " + path);
+        }
+
+        auto inFile = [this](std::uint64_t offset, std::uint64_t byte_size) {
+            return offset <= m_byte_size && byte_size <= m_byte_size - offset;
+        };
+
+        std::uint64_t layout_offset = sizeof(detail::MeshCacheHeader);
+        std::uint64_t attribute_offset =
+            layout_offset + std::uint64_t(m_header.layout_cnt) * sizeof(detail::MeshCacheLayout);
+        if (!inFile(layout_offset, attribute_offset - layout_offset) ||
+            !inFile(m_header.index_data_offset, m_header.index_data_byte_size))
+        {
+            throw MeshException("MeshCacheFile::parse - Truncated file " + path);
+        }
+
+        for (std::uint32_t i = 0; i < m_header.layout_cnt; ++i)
+        {
+            detail::MeshCacheLayout layout;
+            std::memcpy(&layout, m_data + layout_offset + i * sizeof(detail::MeshCacheLayout), sizeof(layout));
+            if (!inFile(attribute_offset, std::uint64_t(layout.attribute_cnt) * sizeof(detail::MeshCacheAttribute)) ||
+                !inFile(layout.data_offset, layout.data_byte_size))
+            {
+                throw MeshException("MeshCacheFile::parse - Truncated file " + path);
+            }
+
+            VertexLayout vertex_layout(static_cast<GLsizei>(layout.stride), {}, layout.divisor);
+            for (std::uint32_t j = 0; j < layout.attribute_cnt; ++j)
+            {
+                detail::MeshCacheAttribute attribute;
+                std::memcpy(&attribute, m_data + attribute_offset, sizeof(attribute));
+                attribute_offset += sizeof(detail::MeshCacheAttribute);
+                vertex_layout.attributes.emplace_back(attribute.size,
+                                                      attribute.type,
+                                                      static_cast<GLboolean>(attribute.normalized),
+                                                      attribute.offset,
+                                                      attribute.shader_input_type);
+            }
+
+            m_vertex_data.emplace_back(m_data + layout.data_offset,
+                                       static_cast<std::size_t>(layout.data_byte_size),
+                                       vertex_layout);
+        }
+
+        // levels of detail follow the attributes of the last layout
+        if (!inFile(attribute_offset, std::uint64_t(m_header.lod_cnt) * sizeof(detail::MeshCacheLod)))
+        {
+            throw MeshException("MeshCacheFile::parse - Truncated file " + path);
+        }
+
+        std::size_t   index_byte_size = computeByteSize(m_header.index_type);
+        std::uint64_t index_cnt = index_byte_size > 0 ? m_header.index_data_byte_size / index_byte_size : 0;
+        for (std::uint32_t i = 0; i < m_header.lod_cnt; ++i)
+        {
+            detail::MeshCacheLod lod;
+            std::memcpy(&lod, m_data + attribute_offset + i * sizeof(detail::MeshCacheLod), sizeof(lod));
+            if (std::uint64_t(lod.first_index) + lod.index_cnt > index_cnt)
+            {
+                throw MeshException("MeshCacheFile::parse - Level of detail exceeds the index data " + path);
+            }
+            m_lod_levels.push_back(LodLevel{lod.first_index, lod.index_cnt, lod.error});
+        }
+    }
+
+    /**
+     * \brief Map a glowl binary mesh cache file and create a mesh from it, see MeshCacheFile.
+     *
+     * Note: Active OpenGL context required.
+     */
+    inline std::unique_ptr<Mesh> loadMeshCache(std::string const& path,
+                                               GLenum             usage = GL_STATIC_DRAW,
+                                               NamePool*          buffer_pool = nullptr,
+                                               NamePool*          vertex_array_pool = nullptr)
+    {
+        return MeshCacheFile(path).createMesh(usage, buffer_pool, vertex_array_pool);
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHCACHE_HPP
@@ -0,0 +1,518 @@
+/*
+ * MeshLod.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHLOD_HPP
+#define GLOWL_MESHLOD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \struct LodLevel
+     *
+     * \brief Index range of a level of detail within a shared index buffer and its geometric error in object space.
+     */
+    struct LodLevel
+    {
+        GLuint  first_index;
+        GLuint  index_cnt;
+        GLfloat error;
+    };
+
+    /**
+     * \struct LodChain
+     *
+     * \brief Result of buildLodChain(). All levels reference the original vertices, their indices are concatenated
+     * starting with the full resolution level 0.
+     */
+    struct LodChain
+    {
+        std::vector<GLuint>   index_data;
+        std::vector<LodLevel> levels;
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief Symmetric 4x4 error quadric (Garland and Heckbert 1997), upper triangle stored row by row.
+         */
+        struct Quadric
+        {
+            double a[10] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            void addPlane(double nx, double ny, double nz, double d, double weight)
+            {
+                double p[4] = {nx, ny, nz, d};
+                int    k = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    for (int j = i; j < 4; ++j)
+                    {
+                        a[k++] += weight * p[i] * p[j];
+                    }
+                }
+            }
+
+            Quadric& operator+=(Quadric const& rhs)
+            {
+                for (int k = 0; k < 10; ++k)
+                {
+                    a[k] += rhs.a[k];
+                }
+                return *this;
+            }
+
+            double evaluate(GLfloat const* position) const
+            {
+                double p[4] = {position[0], position[1], position[2], 1.0};
+                double retval = 0.0;
+                int    k = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    for (int j = i; j < 4; ++j)
+                    {
+                        retval += (i == j ? 1.0 : 2.0) * a[k++] * p[i] * p[j];
+                    }
+                }
+                return retval;
+            }
+        };
+
+        inline void computeTriangleNormal(GLfloat const* p0, GLfloat const* p1, GLfloat const* p2, double* normal)
+        {
+            double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+    } // namespace detail
+
+    /**
+     * \brief Simplify a triangle list by quadric error edge collapses onto existing vertices.
+     *
+     * Vertices on borders and on non-manifold edges (including attribute seams, i.e. split vertices) are kept, so
+     * that adjacent meshes stay crack-free. Collapses that would flip triangles are rejected, therefore the target
+     * might not be reached.
+     *
+     * \param target_index_cnt Stop once the number of indices is at most this
+     * \param result_error Optional output of the geometric error, i.e. the root of the largest area weighted mean
+     * squared distance of a collapse
+     *
+     * \return Indices of the simplified mesh referencing the original vertices
+     */
+    template<typename IndexType>
+    inline std::vector<GLuint> simplifyMesh(std::vector<IndexType> const& indices,
+                                            void const*                   position_data,
+                                            std::size_t                   position_stride,
+                                            std::size_t                   vertex_cnt,
+                                            std::size_t                   target_index_cnt,
+                                            GLfloat*                      result_error = nullptr)
+    {
+        if (indices.size() % 3 != 0)
+        {
+            throw MeshException("simplifyMesh - Index count is not a multiple of 3");
+        }
+
+        auto position = [position_data, position_stride](std::size_t v) {
+            return reinterpret_cast<GLfloat const*>(static_cast<GLubyte const*>(position_data) + v * position_stride);
+        };
+
+        std::size_t         triangle_cnt = indices.size() / 3;
+        std::vector<GLuint> triangles(indices.size());
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            if (static_cast<std::size_t>(indices[i]) >= vertex_cnt)
+            {
+                throw MeshException("simplifyMesh - Index out of range");
+            }
+            triangles[i] = static_cast<GLuint>(indices[i]);
+        }
+
+        // lock vertices of edges that are not shared by exactly two triangles
+        std::vector<bool>          locked(vertex_cnt, false);
+        std::vector<std::uint64_t> edges;
+        edges.reserve(indices.size());
+        for (std::size_t t = 0; t < triangle_cnt; ++t)
+        {
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                std::uint64_t a = triangles[t * 3 + corner];
+                std::uint64_t b = triangles[t * 3 + (corner + 1) % 3];
+                edges.push_back(a < b ? (a << 32 | b) : (b << 32 | a));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        for (std::size_t begin = 0, end = 0; begin < edges.size(); begin = end)
+        {
+            while (end < edges.size() && edges[end] == edges[begin])
+            {
+                ++end;
+            }
+            if (end - begin != 2)
+            {
+                locked[static_cast<std::size_t>(edges[begin] >> 32)] = true;
+                locked[static_cast<std::size_t>(edges[begin] & 0xFFFFFFFFu)] = true;
+            }
+        }
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        // area weighted plane quadrics and vertex-triangle adjacency
+        std::vector<detail::Quadric>     quadrics(vertex_cnt);
+        std::vector<double>              weights(vertex_cnt, 0.0);
+        std::vector<std::vector<GLuint>> vertex_triangles(vertex_cnt);
+        for (std::size_t t = 0; t < triangle_cnt; ++t)
+        {
+            GLfloat const* p0 = position(triangles[t * 3 + 0]);
+            double         normal[3];
+            detail::computeTriangleNormal(p0, position(triangles[t * 3 + 1]), position(triangles[t * 3 + 2]), normal);
+            double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                GLuint v = triangles[t * 3 + corner];
+                vertex_triangles[v].push_back(static_cast<GLuint>(t));
+                if (length > 0.0)
+                {
+                    double nx = normal[0] / length;
+                    double ny = normal[1] / length;
+                    double nz = normal[2] / length;
+                    quadrics[v].addPlane(nx, ny, nz, -(nx * p0[0] + ny * p0[1] + nz * p0[2]), 0.5 * length);
+                    weights[v] += 0.5 * length;
+                }
+            }
+        }
+
+        // compact entries, the queue is the hot spot
+        struct Collapse
+        {
+            float  cost;
+            GLuint source;
+            GLuint target;
+
+            bool operator>(Collapse const& rhs) const
+            {
+                return cost > rhs.cost;
+            }
+        };
+
+        auto collapseCost = [&](GLuint source, GLuint target) {
+            detail::Quadric quadric = quadrics[source];
+            quadric += quadrics[target];
+            double weight = weights[source] + weights[target];
+            double error = std::max(quadric.evaluate(position(target)), 0.0);
+            return static_cast<float>(error / (weight > 0.0 ? weight : 1.0));
+        };
+
+        // seed the queue with both directions of each unique edge, heapified at once
+        std::vector<Collapse> candidates;
+        candidates.reserve(edges.size() * 2);
+        for (std::uint64_t edge : edges)
+        {
+            GLuint a = static_cast<GLuint>(edge >> 32);
+            GLuint b = static_cast<GLuint>(edge & 0xFFFFFFFFu);
+            if (!locked[a])
+            {
+                candidates.push_back(Collapse{collapseCost(a, b), a, b});
+            }
+            if (!locked[b])
+            {
+                candidates.push_back(Collapse{collapseCost(b, a), b, a});
+            }
+        }
+        edges.clear();
+        edges.shrink_to_fit();
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue(std::greater<Collapse>(),
+                                                                                           std::move(candidates));
+
+        std::vector<bool>   triangle_alive(triangle_cnt, true);
+        std::vector<bool>   vertex_removed(vertex_cnt, false);
+        std::vector<GLuint> neighbours;
+        std::size_t         alive_cnt = triangle_cnt;
+        float               max_cost = 0.0f;
+
+        while (alive_cnt * 3 > target_index_cnt && !queue.empty())
+        {
+            Collapse collapse = queue.top();
+            queue.pop();
+
+            GLuint source = collapse.source;
+            GLuint target = collapse.target;
+            if (vertex_removed[source] || vertex_removed[target])
+            {
+                continue;
+            }
+
+            // costs change as quadrics accumulate, re-queue outdated entries
+            float cost = collapseCost(source, target);
+            if (cost > collapse.cost)
+            {
+                queue.push(Collapse{cost, source, target});
+                continue;
+            }
+
+            // check that the edge still exists and that no remaining triangle flips
+            bool edge_exists = false;
+            bool flips = false;
+            for (GLuint t : vertex_triangles[source])
+            {
+                if (!triangle_alive[t])
+                {
+                    continue;
+                }
+
+                GLuint const* triangle = triangles.data() + t * 3;
+                if (triangle[0] == target || triangle[1] == target || triangle[2] == target)
+                {
+                    edge_exists = true;
+                    continue;
+                }
+
+                GLfloat const* p[3];
+                GLfloat const* q[3];
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    p[corner] = position(triangle[corner]);
+                    q[corner] = triangle[corner] == source ? position(target) : p[corner];
+                }
+                double before[3];
+                double after[3];
+                detail::computeTriangleNormal(p[0], p[1], p[2], before);
+                detail::computeTriangleNormal(q[0], q[1], q[2], after);
+                if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+                {
+                    flips = true;
+                    break;
+                }
+            }
+            if (!edge_exists || flips)
+            {
+                continue;
+            }
+
+            // collapse source onto target
+            vertex_removed[source] = true;
+            quadrics[target] += quadrics[source];
+            weights[target] += weights[source];
+            max_cost = std::max(max_cost, cost);
+
+            for (GLuint t : vertex_triangles[source])
+            {
+                if (!triangle_alive[t])
+                {
+                    continue;
+                }
+
+                GLuint* triangle = triangles.data() + t * 3;
+                if (triangle[0] == target || triangle[1] == target || triangle[2] == target)
+                {
+                    triangle_alive[t] = false;
+                    --alive_cnt;
+                    continue;
+                }
+
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    triangle[corner] = triangle[corner] == source ? target : triangle[corner];
+                }
+                vertex_triangles[target].push_back(t);
+            }
+            vertex_triangles[source].clear();
+            vertex_triangles[source].shrink_to_fit();
+
+            auto& target_triangles = vertex_triangles[target];
+            target_triangles.erase(std::remove_if(target_triangles.begin(),
+                                                  target_triangles.end(),
+                                                  [&triangle_alive](GLuint t) { return !triangle_alive[t]; }),
+                                   target_triangles.end());
+
+            // only collapses from or onto the target have changed costs
+            neighbours.clear();
+            for (GLuint t : target_triangles)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    GLuint v = triangles[t * 3 + corner];
+                    if (v != target)
+                    {
+                        neighbours.push_back(v);
+                    }
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+            for (GLuint v : neighbours)
+            {
+                if (!locked[target])
+                {
+                    queue.push(Collapse{collapseCost(target, v), target, v});
+                }
+                if (!locked[v])
+                {
+                    queue.push(Collapse{collapseCost(v, target), v, target});
+                }
+            }
+        }
+
+        std::vector<GLuint> retval;
+        retval.reserve(alive_cnt * 3);
+        for (std::size_t t = 0; t < triangle_cnt; ++t)
+        {
+            if (triangle_alive[t])
+            {
+                retval.insert(retval.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+            }
+        }
+
+        if (result_error != nullptr)
+        {
+            *result_error = static_cast<GLfloat>(std::sqrt(max_cost));
+        }
+
+        return retval;
+    }
+
+    /**
+     * \brief Build a chain of levels of detail by simplifying the mesh to the given triangle ratios.
+     *
+     * Each level is simplified from the full resolution mesh on its own worker thread. Level errors are made
+     * monotonic, so that a coarser level never reports a smaller error than a finer one.
+     *
+     * \param target_ratios Target triangle ratio per additional level, e.g. {0.5, 0.25, 0.125}
+     * \param thread_cnt Number of worker threads, 0 uses the hardware concurrency
+     */
+    template<typename IndexType>
+    inline LodChain buildLodChain(std::vector<IndexType> const& indices,
+                                  void const*                   position_data,
+                                  std::size_t                   position_stride,
+                                  std::size_t                   vertex_cnt,
+                                  std::vector<GLfloat> const&   target_ratios,
+                                  unsigned int                  thread_cnt = 0)
+    {
+        std::size_t                      level_cnt = target_ratios.size();
+        std::vector<std::vector<GLuint>> level_indices(level_cnt);
+        std::vector<GLfloat>             level_errors(level_cnt, 0.0f);
+        std::vector<std::exception_ptr>  exceptions(level_cnt);
+
+        std::atomic<std::size_t> next_level(0);
+        auto                     work = [&]() {
+            for (std::size_t level = next_level++; level < level_cnt; level = next_level++)
+            {
+                try
+                {
+                    std::size_t target = static_cast<std::size_t>(static_cast<double>(indices.size() / 3) *
+                                                                  static_cast<double>(target_ratios[level])) *
+                                         3;
+                    level_indices[level] = simplifyMesh(indices,
+                                                        position_data,
+                                                        position_stride,
+                                                        vertex_cnt,
+                                                        target,
+                                                        &level_errors[level]);
+                }
+                catch (...)
+                {
+                    exceptions[level] = std::current_exception();
+                }
+            }
+        };
+
+        unsigned int worker_cnt = thread_cnt != 0 ? thread_cnt : std::max(std::thread::hardware_concurrency(), 1u);
+        std::vector<std::thread> workers;
+        for (std::size_t worker = 1; worker < std::min<std::size_t>(worker_cnt, level_cnt); ++worker)
+        {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        for (auto const& exception : exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        LodChain retval;
+        retval.index_data.reserve(indices.size() * 2);
+        for (IndexType index : indices)
+        {
+            retval.index_data.push_back(static_cast<GLuint>(index));
+        }
+        retval.levels.push_back(LodLevel{0, static_cast<GLuint>(indices.size()), 0.0f});
+
+        for (std::size_t level = 0; level < level_cnt; ++level)
+        {
+            GLfloat error = std::max(level_errors[level], retval.levels.back().error);
+            retval.levels.push_back(LodLevel{static_cast<GLuint>(retval.index_data.size()),
+                                             static_cast<GLuint>(level_indices[level].size()),
+                                             error});
+            retval.index_data.insert(retval.index_data.end(), level_indices[level].begin(), level_indices[level].end());
+        }
+
+        return retval;
+    }
+
+    /**
+     * \brief Returns the factor that converts an object space error at distance 1 to pixels.
+     *
+     * \param vertical_fov Vertical field of view in radians
+     * \param viewport_height Viewport height in pixels
+     */
+    inline GLfloat computeLodProjectionScale(GLfloat vertical_fov, GLfloat viewport_height)
+    {
+        return viewport_height / (2.0f * std::tan(0.5f * vertical_fov));
+    }
+
+    /**
+     * \brief Select the coarsest level whose projected error stays within max_screen_error pixels.
+     *
+     * \param distance Distance between camera and the (closest point of the) object
+     * \param projection_scale See computeLodProjectionScale()
+     */
+    inline std::size_t selectLodLevel(std::vector<LodLevel> const& levels,
+                                      GLfloat                      distance,
+                                      GLfloat                      projection_scale,
+                                      GLfloat                      max_screen_error = 1.0f)
+    {
+        std::size_t retval = 0;
+        if (distance <= 0.0f)
+        {
+            return retval;
+        }
+
+        for (std::size_t level = 1; level < levels.size(); ++level)
+        {
+            if (levels[level].error * projection_scale / distance <= max_screen_error)
+            {
+                retval = level;
+            }
+        }
+
+        return retval;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHLOD_HPP
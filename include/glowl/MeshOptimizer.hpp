@@ -0,0 +1,758 @@
+/*
+ * MeshOptimizer.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHOPTIMIZER_HPP
+#define GLOWL_MESHOPTIMIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \struct VertexCacheStatistics
+     *
+     * \brief Post-transform vertex cache efficiency of an index buffer for a FIFO cache.
+     */
+    struct VertexCacheStatistics
+    {
+        std::size_t triangle_cnt = 0;
+        std::size_t vertex_cnt = 0;             ///< Number of distinct referenced vertices
+        std::size_t transformed_vertex_cnt = 0; ///< Number of cache misses
+        float       acmr = 0.0f;                ///< Average cache miss ratio, transformed vertices per triangle
+        float       atvr = 0.0f;                ///< Average transform to vertex ratio, 1.0 is optimal
+    };
+
+    /**
+     * \struct MeshOptimizationReport
+     *
+     * \brief Vertex cache statistics before and after MeshOptimizer::optimize().
+     */
+    struct MeshOptimizationReport
+    {
+        VertexCacheStatistics before;
+        VertexCacheStatistics after;
+    };
+
+    /**
+     * \class MeshOptimizer
+     *
+     * \brief CPU side reordering of triangle meshes (GL_TRIANGLES) before upload.
+     *
+     * - optimizeVertexCache() reorders triangles for post-transform vertex cache hits (Tipsify, Sander et al. 2007).
+     * - optimizeOverdraw() splits the triangle order into clusters at cache flushes and sorts the clusters front to
+     *   back from the mesh's point of view, i.e. outward facing clusters far from the center are drawn first.
+     * - optimizeVertexFetch() renumbers vertices in order of first use and permutes every vertex stream accordingly.
+     *
+     * Index buffers larger than a chunk are split into independent chunks that are processed in parallel, at the cost
+     * of a few additional cache misses at the chunk borders. Vertex data is given per VertexLayout as in Mesh.
+     * No OpenGL context is required.
+     *
+     * \author Michael Becher
+     */
+    class MeshOptimizer
+    {
+    public:
+        /**
+         * \brief MeshOptimizer constructor.
+         *
+         * \param cache_size Size of the simulated FIFO vertex cache
+         * \param thread_cnt Number of threads, 0 uses the hardware concurrency
+         * \param chunk_triangle_cnt Number of triangles per independently optimized chunk
+         */
+        MeshOptimizer(unsigned int cache_size = 16,
+                      unsigned int thread_cnt = 0,
+                      std::size_t  chunk_triangle_cnt = 65536);
+
+        /**
+         * \brief Simulate a FIFO vertex cache of the configured size for the given triangle list.
+         */
+        template<typename IndexType>
+        VertexCacheStatistics analyzeVertexCache(std::vector<IndexType> const& indices, std::size_t vertex_cnt) const;
+
+        template<typename IndexType>
+        void optimizeVertexCache(std::vector<IndexType>& indices, std::size_t vertex_cnt) const;
+
+        /**
+         * \brief Reorder triangle clusters to reduce overdraw. Run after optimizeVertexCache().
+         *
+         * \param position_data Pointer to the first vertex position (3 floats)
+         * \param position_stride Byte stride between vertex positions
+         * \param threshold Clusters may only end where their ACMR is below threshold times the ACMR of the mesh
+         */
+        template<typename IndexType>
+        void optimizeOverdraw(std::vector<IndexType>& indices,
+                              void const*             position_data,
+                              std::size_t             position_stride,
+                              std::size_t             vertex_cnt,
+                              float                   threshold = 1.05f) const;
+
+        /**
+         * \brief Renumber vertices in order of first use and permute all vertex streams. Unreferenced vertices are
+         * moved to the end.
+         *
+         * \return Mapping from old to new vertex index
+         */
+        template<typename IndexType, typename VertexDataType>
+        std::vector<GLuint> optimizeVertexFetch(std::vector<IndexType>&                   indices,
+                                                std::vector<std::vector<VertexDataType>>& vertex_data,
+                                                std::vector<VertexLayout> const&          vertex_descriptor) const;
+
+        /**
+         * \brief Run vertex cache, (optionally) overdraw and vertex fetch optimization.
+         *
+         * For overdraw optimization, the first attribute of the first vertex layout is used as position and has to be
+         * of type GL_FLOAT with at least 3 components.
+         */
+        template<typename IndexType, typename VertexDataType>
+        MeshOptimizationReport optimize(std::vector<IndexType>&                   indices,
+                                        std::vector<std::vector<VertexDataType>>& vertex_data,
+                                        std::vector<VertexLayout> const&          vertex_descriptor,
+                                        bool                                      optimize_overdraw = false,
+                                        float                                     overdraw_threshold = 1.05f) const;
+
+        unsigned int getCacheSize() const;
+
+        unsigned int getThreadCount() const;
+
+    private:
+        /**
+         * \brief Run task(task_idx, worker_idx) for all tasks on up to thread_cnt threads.
+         */
+        template<typename Task>
+        void parallelFor(std::size_t task_cnt, Task const& task) const;
+
+        /**
+         * \brief Returns the triangles in breadth first order over shared vertices.
+         */
+        template<typename IndexType>
+        std::vector<IndexType> computeLocalityOrder(std::vector<IndexType> const& indices,
+                                                    std::size_t                   vertex_cnt) const;
+
+        template<typename IndexType>
+        void checkIndices(std::vector<IndexType> const& indices, std::size_t vertex_cnt, char const* caller) const;
+
+        template<typename IndexType, typename VertexDataType>
+        std::size_t computeVertexCount(std::vector<IndexType> const&                   indices,
+                                       std::vector<std::vector<VertexDataType>> const& vertex_data,
+                                       std::vector<VertexLayout> const&                vertex_descriptor,
+                                       char const*                                     caller) const;
+
+        unsigned int m_cache_size;
+        unsigned int m_thread_cnt;
+        std::size_t  m_chunk_triangle_cnt;
+    };
+
+    inline MeshOptimizer::MeshOptimizer(unsigned int cache_size,
+                                        unsigned int thread_cnt,
+                                        std::size_t  chunk_triangle_cnt)
+        : m_cache_size(std::max(cache_size, 3u)),
+          m_thread_cnt(thread_cnt != 0 ? thread_cnt : std::max(std::thread::hardware_concurrency(), 1u)),
+          m_chunk_triangle_cnt(std::max(chunk_triangle_cnt, std::size_t(1)))
+    {
+    }
+
+    template<typename IndexType>
+    inline VertexCacheStatistics MeshOptimizer::analyzeVertexCache(std::vector<IndexType> const& indices,
+                                                                   std::size_t                   vertex_cnt) const
+    {
+        checkIndices(indices, vertex_cnt, "MeshOptimizer::analyzeVertexCache");
+
+        VertexCacheStatistics retval;
+        retval.triangle_cnt = indices.size() / 3;
+
+        // a vertex is cached if fewer than cache_size misses happened since it was last transformed
+        std::vector<std::size_t> cache_time(vertex_cnt, 0);
+        std::vector<bool>        referenced(vertex_cnt, false);
+        std::size_t              time = m_cache_size + 1;
+        for (std::size_t i = 0; i < retval.triangle_cnt * 3; ++i)
+        {
+            std::size_t v = static_cast<std::size_t>(indices[i]);
+            if (time - cache_time[v] > m_cache_size)
+            {
+                cache_time[v] = time++;
+                ++retval.transformed_vertex_cnt;
+            }
+            if (!referenced[v])
+            {
+                referenced[v] = true;
+                ++retval.vertex_cnt;
+            }
+        }
+
+        if (retval.triangle_cnt > 0)
+        {
+            retval.acmr = static_cast<float>(retval.transformed_vertex_cnt) / static_cast<float>(retval.triangle_cnt);
+            retval.atvr = static_cast<float>(retval.transformed_vertex_cnt) / static_cast<float>(retval.vertex_cnt);
+        }
+
+        return retval;
+    }
+
+    template<typename IndexType>
+    inline void MeshOptimizer::optimizeVertexCache(std::vector<IndexType>& indices, std::size_t vertex_cnt) const
+    {
+        checkIndices(indices, vertex_cnt, "MeshOptimizer::optimizeVertexCache");
+
+        std::size_t triangle_cnt = indices.size() / 3;
+        std::size_t chunk_cnt = (triangle_cnt + m_chunk_triangle_cnt - 1) / m_chunk_triangle_cnt;
+
+        constexpr GLuint invalid = std::numeric_limits<GLuint>::max();
+
+        // chunks have to be connected regions of the mesh, order the triangles by a breadth first traversal first
+        std::vector<IndexType> source;
+        if (chunk_cnt > 1)
+        {
+            source = computeLocalityOrder(indices, vertex_cnt);
+        }
+        std::vector<IndexType> const& chunk_source = chunk_cnt > 1 ? source : indices;
+
+        // per worker mapping from global to chunk local vertex indices, reset after each chunk
+        std::vector<std::vector<GLuint>> local_ids(std::min<std::size_t>(m_thread_cnt, chunk_cnt));
+
+        parallelFor(chunk_cnt, [&](std::size_t chunk, std::size_t worker) {
+            std::vector<GLuint>& local_id = local_ids[worker];
+            if (local_id.empty())
+            {
+                local_id.assign(vertex_cnt, invalid);
+            }
+
+            std::size_t first_triangle = chunk * m_chunk_triangle_cnt;
+            std::size_t first_index = first_triangle * 3;
+            std::size_t chunk_triangle_cnt = std::min(m_chunk_triangle_cnt, triangle_cnt - first_triangle);
+
+            std::vector<IndexType> global_ids;
+            std::vector<GLuint>    local_indices(chunk_triangle_cnt * 3);
+            for (std::size_t i = 0; i < local_indices.size(); ++i)
+            {
+                IndexType v = chunk_source[first_index + i];
+                if (local_id[v] == invalid)
+                {
+                    local_id[v] = static_cast<GLuint>(global_ids.size());
+                    global_ids.push_back(v);
+                }
+                local_indices[i] = local_id[v];
+            }
+            for (IndexType v : global_ids)
+            {
+                local_id[v] = invalid;
+            }
+
+            // vertex-triangle adjacency
+            std::size_t         local_vertex_cnt = global_ids.size();
+            std::vector<GLuint> live_cnt(local_vertex_cnt, 0);
+            for (GLuint v : local_indices)
+            {
+                ++live_cnt[v];
+            }
+            std::vector<GLuint> adjacency_offsets(local_vertex_cnt + 1, 0);
+            std::partial_sum(live_cnt.begin(), live_cnt.end(), adjacency_offsets.begin() + 1);
+            std::vector<GLuint> adjacency(local_indices.size());
+            std::vector<GLuint> fill_cnt(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+            for (std::size_t i = 0; i < local_indices.size(); ++i)
+            {
+                adjacency[fill_cnt[local_indices[i]]++] = static_cast<GLuint>(i / 3);
+            }
+
+            std::vector<std::size_t> cache_time(local_vertex_cnt, 0);
+            std::size_t              time = m_cache_size + 1;
+            std::vector<bool>        emitted(chunk_triangle_cnt, false);
+            std::vector<GLuint>      dead_end_stack;
+            std::vector<GLuint>      candidates;
+            std::vector<IndexType>   output;
+            output.reserve(local_indices.size());
+            GLuint cursor = 0;
+            GLuint fanning_vertex = local_vertex_cnt > 0 ? 0 : invalid;
+
+            while (fanning_vertex != invalid)
+            {
+                // emit all remaining triangles around the fanning vertex
+                candidates.clear();
+                for (GLuint a = adjacency_offsets[fanning_vertex]; a < adjacency_offsets[fanning_vertex + 1]; ++a)
+                {
+                    GLuint triangle = adjacency[a];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+                    emitted[triangle] = true;
+
+                    for (std::size_t corner = 0; corner < 3; ++corner)
+                    {
+                        GLuint v = local_indices[triangle * 3 + corner];
+                        output.push_back(global_ids[v]);
+                        dead_end_stack.push_back(v);
+                        candidates.push_back(v);
+                        --live_cnt[v];
+                        if (time - cache_time[v] > m_cache_size)
+                        {
+                            cache_time[v] = time++;
+                        }
+                    }
+                }
+
+                // continue with the candidate that stays in the cache the longest while its fan is emitted
+                fanning_vertex = invalid;
+                std::size_t best_priority = 0;
+                for (GLuint v : candidates)
+                {
+                    if (live_cnt[v] == 0)
+                    {
+                        continue;
+                    }
+                    std::size_t priority = 1;
+                    if (time - cache_time[v] + 2 * live_cnt[v] <= m_cache_size)
+                    {
+                        priority += time - cache_time[v];
+                    }
+                    if (priority > best_priority)
+                    {
+                        best_priority = priority;
+                        fanning_vertex = v;
+                    }
+                }
+
+                // dead end, fall back to recently used vertices and finally to the next vertex in input order
+                while (fanning_vertex == invalid && !dead_end_stack.empty())
+                {
+                    GLuint v = dead_end_stack.back();
+                    dead_end_stack.pop_back();
+                    if (live_cnt[v] > 0)
+                    {
+                        fanning_vertex = v;
+                    }
+                }
+                while (fanning_vertex == invalid && cursor < local_vertex_cnt)
+                {
+                    if (live_cnt[cursor] > 0)
+                    {
+                        fanning_vertex = cursor;
+                    }
+                    ++cursor;
+                }
+            }
+
+            std::copy(output.begin(), output.end(), indices.begin() + first_index);
+        });
+    }
+
+    template<typename IndexType>
+    inline void MeshOptimizer::optimizeOverdraw(std::vector<IndexType>& indices,
+                                                void const*             position_data,
+                                                std::size_t             position_stride,
+                                                std::size_t             vertex_cnt,
+                                                float                   threshold) const
+    {
+        checkIndices(indices, vertex_cnt, "MeshOptimizer::optimizeOverdraw");
+
+        std::size_t triangle_cnt = indices.size() / 3;
+        if (triangle_cnt == 0)
+        {
+            return;
+        }
+
+        auto position = [position_data, position_stride](IndexType v) {
+            return reinterpret_cast<float const*>(static_cast<GLubyte const*>(position_data) +
+                                                  static_cast<std::size_t>(v) * position_stride);
+        };
+
+        // split into clusters at triangles that miss the cache completely, as long as the cluster is efficient enough
+        float const              max_cluster_acmr = threshold * analyzeVertexCache(indices, vertex_cnt).acmr;
+        std::vector<std::size_t> cluster_offsets{0};
+        std::vector<std::size_t> cache_time(vertex_cnt, 0);
+        std::size_t              time = m_cache_size + 1;
+        std::size_t              cluster_misses = 0;
+        for (std::size_t t = 0; t < triangle_cnt; ++t)
+        {
+            std::size_t misses = 0;
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                std::size_t v = static_cast<std::size_t>(indices[t * 3 + corner]);
+                if (time - cache_time[v] > m_cache_size)
+                {
+                    cache_time[v] = time++;
+                    ++misses;
+                }
+            }
+
+            std::size_t cluster_triangle_cnt = t - cluster_offsets.back();
+            if (misses == 3 && cluster_triangle_cnt > 0 &&
+                static_cast<float>(cluster_misses) <= max_cluster_acmr * static_cast<float>(cluster_triangle_cnt))
+            {
+                cluster_offsets.push_back(t);
+                cluster_misses = 0;
+            }
+            cluster_misses += misses;
+        }
+        cluster_offsets.push_back(triangle_cnt);
+        std::size_t cluster_cnt = cluster_offsets.size() - 1;
+
+        // area weighted centroid and normal per cluster
+        std::vector<std::array<double, 7>> cluster_data(cluster_cnt);
+        parallelFor(cluster_cnt, [&](std::size_t cluster, std::size_t) {
+            std::array<double, 7> data{};
+            for (std::size_t t = cluster_offsets[cluster]; t < cluster_offsets[cluster + 1]; ++t)
+            {
+                float const* p0 = position(indices[t * 3 + 0]);
+                float const* p1 = position(indices[t * 3 + 1]);
+                float const* p2 = position(indices[t * 3 + 2]);
+
+                double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                double n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                               e1[2] * e2[0] - e1[0] * e2[2],
+                               e1[0] * e2[1] - e1[1] * e2[0]};
+                double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    data[c] += area * (p0[c] + p1[c] + p2[c]) / 3.0;
+                    data[3 + c] += n[c];
+                }
+                data[6] += area;
+            }
+            cluster_data[cluster] = data;
+        });
+
+        double mesh_area = 0.0;
+        double mesh_centroid[3] = {0.0, 0.0, 0.0};
+        for (auto const& data : cluster_data)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                mesh_centroid[c] += data[c];
+            }
+            mesh_area += data[6];
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            mesh_centroid[c] = mesh_area > 0.0 ? mesh_centroid[c] / mesh_area : 0.0;
+        }
+
+        std::vector<double> sort_keys(cluster_cnt, 0.0);
+        for (std::size_t cluster = 0; cluster < cluster_cnt; ++cluster)
+        {
+            auto const& data = cluster_data[cluster];
+            double      normal_length = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+            if (data[6] > 0.0 && normal_length > 0.0)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    sort_keys[cluster] += (data[c] / data[6] - mesh_centroid[c]) * data[3 + c] / normal_length;
+                }
+            }
+        }
+
+        std::vector<std::size_t> cluster_order(cluster_cnt);
+        std::iota(cluster_order.begin(), cluster_order.end(), std::size_t(0));
+        std::stable_sort(cluster_order.begin(), cluster_order.end(), [&sort_keys](std::size_t lhs, std::size_t rhs) {
+            return sort_keys[lhs] > sort_keys[rhs];
+        });
+
+        std::vector<IndexType> reordered;
+        reordered.reserve(indices.size());
+        for (std::size_t cluster : cluster_order)
+        {
+            reordered.insert(reordered.end(),
+                             indices.begin() + cluster_offsets[cluster] * 3,
+                             indices.begin() + cluster_offsets[cluster + 1] * 3);
+        }
+        std::copy(reordered.begin(), reordered.end(), indices.begin());
+    }
+
+    template<typename IndexType, typename VertexDataType>
+    inline std::vector<GLuint> MeshOptimizer::optimizeVertexFetch(
+        std::vector<IndexType>&                   indices,
+        std::vector<std::vector<VertexDataType>>& vertex_data,
+        std::vector<VertexLayout> const&          vertex_descriptor) const
+    {
+        std::size_t vertex_cnt =
+            computeVertexCount(indices, vertex_data, vertex_descriptor, "MeshOptimizer::optimizeVertexFetch");
+
+        constexpr GLuint invalid = std::numeric_limits<GLuint>::max();
+
+        std::vector<GLuint> remap(vertex_cnt, invalid);
+        GLuint              next_vertex = 0;
+        for (IndexType v : indices)
+        {
+            if (remap[v] == invalid)
+            {
+                remap[v] = next_vertex++;
+            }
+        }
+        for (GLuint& new_vertex : remap)
+        {
+            if (new_vertex == invalid)
+            {
+                new_vertex = next_vertex++;
+            }
+        }
+
+        std::vector<GLuint> inverse_remap(vertex_cnt);
+        for (std::size_t v = 0; v < vertex_cnt; ++v)
+        {
+            inverse_remap[remap[v]] = static_cast<GLuint>(v);
+        }
+
+        // rewrite indices and vertex streams in chunks, streams are processed one after another
+        std::size_t const index_chunk_size = m_chunk_triangle_cnt * 3;
+        parallelFor((indices.size() + index_chunk_size - 1) / index_chunk_size, [&](std::size_t chunk, std::size_t) {
+            std::size_t end = std::min(indices.size(), (chunk + 1) * index_chunk_size);
+            for (std::size_t i = chunk * index_chunk_size; i < end; ++i)
+            {
+                indices[i] = static_cast<IndexType>(remap[indices[i]]);
+            }
+        });
+
+        for (std::size_t layout_idx = 0; layout_idx < vertex_descriptor.size(); ++layout_idx)
+        {
+            std::size_t    stride = static_cast<std::size_t>(vertex_descriptor[layout_idx].stride);
+            GLubyte const* src = reinterpret_cast<GLubyte const*>(vertex_data[layout_idx].data());
+
+            std::vector<VertexDataType> permuted(vertex_data[layout_idx]);
+            GLubyte*                    dst = reinterpret_cast<GLubyte*>(permuted.data());
+
+            std::size_t const vertex_chunk_size = m_chunk_triangle_cnt;
+            parallelFor((vertex_cnt + vertex_chunk_size - 1) / vertex_chunk_size, [&](std::size_t chunk, std::size_t) {
+                std::size_t end = std::min(vertex_cnt, (chunk + 1) * vertex_chunk_size);
+                for (std::size_t v = chunk * vertex_chunk_size; v < end; ++v)
+                {
+                    std::memcpy(dst + v * stride, src + static_cast<std::size_t>(inverse_remap[v]) * stride, stride);
+                }
+            });
+
+            vertex_data[layout_idx] = std::move(permuted);
+        }
+
+        return remap;
+    }
+
+    template<typename IndexType, typename VertexDataType>
+    inline MeshOptimizationReport MeshOptimizer::optimize(std::vector<IndexType>&                   indices,
+                                                          std::vector<std::vector<VertexDataType>>& vertex_data,
+                                                          std::vector<VertexLayout> const&          vertex_descriptor,
+                                                          bool                                      optimize_overdraw,
+                                                          float overdraw_threshold) const
+    {
+        std::size_t vertex_cnt = computeVertexCount(indices, vertex_data, vertex_descriptor, "MeshOptimizer::optimize");
+
+        MeshOptimizationReport retval;
+        retval.before = analyzeVertexCache(indices, vertex_cnt);
+
+        optimizeVertexCache(indices, vertex_cnt);
+
+        if (optimize_overdraw)
+        {
+            if (vertex_descriptor.front().attributes.empty() ||
+                vertex_descriptor.front().attributes.front().type != GL_FLOAT ||
+                vertex_descriptor.front().attributes.front().size < 3)
+            {
+                throw MeshException("MeshOptimizer::optimize - Overdraw optimization requires float positions as first "
+                                    "attribute");
+            }
+
+            GLubyte const* position_data = reinterpret_cast<GLubyte const*>(vertex_data.front().data()) +
+                                           vertex_descriptor.front().attributes.front().offset;
+            optimizeOverdraw(indices,
+                             position_data,
+                             static_cast<std::size_t>(vertex_descriptor.front().stride),
+                             vertex_cnt,
+                             overdraw_threshold);
+        }
+
+        optimizeVertexFetch(indices, vertex_data, vertex_descriptor);
+
+        retval.after = analyzeVertexCache(indices, vertex_cnt);
+
+        return retval;
+    }
+
+    inline unsigned int MeshOptimizer::getCacheSize() const
+    {
+        return m_cache_size;
+    }
+
+    inline unsigned int MeshOptimizer::getThreadCount() const
+    {
+        return m_thread_cnt;
+    }
+
+    template<typename Task>
+    inline void MeshOptimizer::parallelFor(std::size_t task_cnt, Task const& task) const
+    {
+        std::size_t worker_cnt = std::min<std::size_t>(m_thread_cnt, task_cnt);
+        if (worker_cnt <= 1)
+        {
+            for (std::size_t i = 0; i < task_cnt; ++i)
+            {
+                task(i, 0);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next_task(0);
+        auto                     work = [&](std::size_t worker) {
+            for (std::size_t i = next_task++; i < task_cnt; i = next_task++)
+            {
+                task(i, worker);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t worker = 1; worker < worker_cnt; ++worker)
+        {
+            workers.emplace_back(work, worker);
+        }
+        work(0);
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    template<typename IndexType>
+    inline std::vector<IndexType> MeshOptimizer::computeLocalityOrder(std::vector<IndexType> const& indices,
+                                                                      std::size_t                   vertex_cnt) const
+    {
+        std::size_t triangle_cnt = indices.size() / 3;
+
+        std::vector<GLuint> adjacency_offsets(vertex_cnt + 1, 0);
+        for (IndexType v : indices)
+        {
+            ++adjacency_offsets[static_cast<std::size_t>(v) + 1];
+        }
+        std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+        std::vector<GLuint> adjacency(indices.size());
+        std::vector<GLuint> fill_cnt(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[fill_cnt[indices[i]]++] = static_cast<GLuint>(i / 3);
+        }
+
+        std::vector<IndexType> retval;
+        retval.reserve(indices.size());
+        std::vector<bool>   emitted(triangle_cnt, false);
+        std::vector<bool>   visited(vertex_cnt, false);
+        std::vector<GLuint> queue;
+        queue.reserve(vertex_cnt);
+        for (std::size_t seed = 0; seed < triangle_cnt; ++seed)
+        {
+            if (emitted[seed])
+            {
+                continue;
+            }
+
+            // start a new connected component
+            std::size_t queue_front = queue.size();
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                GLuint v = static_cast<GLuint>(indices[seed * 3 + corner]);
+                if (!visited[v])
+                {
+                    visited[v] = true;
+                    queue.push_back(v);
+                }
+            }
+
+            for (; queue_front < queue.size(); ++queue_front)
+            {
+                GLuint v = queue[queue_front];
+                for (GLuint a = adjacency_offsets[v]; a < adjacency_offsets[v + 1]; ++a)
+                {
+                    GLuint triangle = adjacency[a];
+                    if (emitted[triangle])
+                    {
+                        continue;
+                    }
+                    emitted[triangle] = true;
+
+                    for (std::size_t corner = 0; corner < 3; ++corner)
+                    {
+                        IndexType w = indices[triangle * 3 + corner];
+                        retval.push_back(w);
+                        if (!visited[w])
+                        {
+                            visited[w] = true;
+                            queue.push_back(static_cast<GLuint>(w));
+                        }
+                    }
+                }
+            }
+        }
+
+        return retval;
+    }
+
+    template<typename IndexType>
+    inline void MeshOptimizer::checkIndices(std::vector<IndexType> const& indices,
+                                            std::size_t                   vertex_cnt,
+                                            char const*                   caller) const
+    {
+        if (indices.size() % 3 != 0)
+        {
+            throw MeshException(std::string(caller) + " - Index count is not a multiple of 3");
+        }
+        for (IndexType v : indices)
+        {
+            if (static_cast<std::size_t>(v) >= vertex_cnt)
+            {
+                throw MeshException(std::string(caller) + " - Index out of range");
+            }
+        }
+    }
+
+    template<typename IndexType, typename VertexDataType>
+    inline std::size_t MeshOptimizer::computeVertexCount(std::vector<IndexType> const&                   indices,
+                                                         std::vector<std::vector<VertexDataType>> const& vertex_data,
+                                                         std::vector<VertexLayout> const& vertex_descriptor,
+                                                         char const*                      caller) const
+    {
+        if (vertex_data.empty() || vertex_data.size() != vertex_descriptor.size())
+        {
+            throw MeshException(std::string(caller) + " - Vector parameters of different size!");
+        }
+
+        std::size_t vertex_cnt = 0;
+        for (std::size_t layout_idx = 0; layout_idx < vertex_descriptor.size(); ++layout_idx)
+        {
+            if (vertex_descriptor[layout_idx].stride <= 0)
+            {
+                throw MeshException(std::string(caller) + " - Vertex layout requires an explicit stride");
+            }
+
+            std::size_t layout_vertex_cnt = vertex_data[layout_idx].size() * sizeof(VertexDataType) /
+                                            static_cast<std::size_t>(vertex_descriptor[layout_idx].stride);
+            if (layout_idx > 0 && layout_vertex_cnt != vertex_cnt)
+            {
+                throw MeshException(std::string(caller) + " - Vertex count differs between vertex layouts");
+            }
+            vertex_cnt = layout_vertex_cnt;
+        }
+
+        checkIndices(indices, vertex_cnt, caller);
+
+        return vertex_cnt;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHOPTIMIZER_HPP
@@ -0,0 +1,368 @@
+/*
+ * Meshlets.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_MESHLETS_HPP
+#define GLOWL_MESHLETS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "NamePool.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \struct Meshlet
+     *
+     * \brief Meshlet descriptor, laid out for use in a std430 shader storage buffer.
+     *
+     * The meshlet's vertices are vertex_indices[vertex_offset ... vertex_offset + vertex_cnt - 1] of MeshletData,
+     * its triangles are given by 3 local (byte sized) indices each, starting at byte 3 * triangle_offset of
+     * local_indices.
+     */
+    struct Meshlet
+    {
+        GLuint  vertex_offset;
+        GLuint  triangle_offset;
+        GLuint  vertex_cnt;
+        GLuint  triangle_cnt;
+        GLfloat bounding_sphere[4]; ///< Center and radius
+        GLfloat normal_cone[4];     ///< Axis and cutoff (sine of the cone's half angle), see isMeshletBackfacing()
+    };
+
+    /**
+     * \struct MeshletData
+     *
+     * \brief Result of buildMeshlets().
+     */
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<GLuint>  vertex_indices;
+        std::vector<GLubyte> local_indices; ///< Padded to a multiple of 4 bytes for upload as uint array
+        GLuint               max_vertices = 0;
+        GLuint               max_triangles = 0;
+    };
+
+    /**
+     * \brief GLSL functions for reading local indices and for meshlet culling in task shaders. Expects the local
+     * indices as uint array named meshlet_local_indices.
+     */
+    constexpr char const* meshlet_glsl =
+        "uint getMeshletLocalIndex(uint triangle_offset, uint local_index)\n"
+        "{\n"
+        "    uint byte_idx = 3u * triangle_offset + local_index;\n"
+        "    return (meshlet_local_indices[byte_idx / 4u] >> (8u * (byte_idx % 4u))) & 0xFFu;\n"
+        "}\n"
+        "bool isMeshletBackfacing(vec4 bounding_sphere, vec4 normal_cone, vec3 camera_position)\n"
+        "{\n"
+        "    vec3 view = bounding_sphere.xyz - camera_position;\n"
+        "    return dot(view, normal_cone.xyz) >= normal_cone.w * length(view) + bounding_sphere.w;\n"
+        "}\n";
+
+    /**
+     * \brief Returns true if all triangles of the meshlet face away from the camera. Same test as in meshlet_glsl.
+     */
+    inline bool isMeshletBackfacing(Meshlet const& meshlet, GLfloat const* camera_position)
+    {
+        GLfloat view[3];
+        GLfloat view_dot_axis = 0.0f;
+        GLfloat view_length = 0.0f;
+        for (int c = 0; c < 3; ++c)
+        {
+            view[c] = meshlet.bounding_sphere[c] - camera_position[c];
+            view_dot_axis += view[c] * meshlet.normal_cone[c];
+            view_length += view[c] * view[c];
+        }
+
+        return view_dot_axis >= meshlet.normal_cone[3] * std::sqrt(view_length) + meshlet.bounding_sphere[3];
+    }
+
+    /**
+     * \brief Split a triangle list into meshlets with at most max_vertices vertices and max_triangles triangles.
+     *
+     * Triangles are assigned greedily in input order, so the index buffer should be optimized for vertex cache
+     * locality first (see MeshOptimizer). Bounding spheres and normal cones are computed from the vertex positions
+     * (3 floats each). Meshlets whose normals span more than a hemisphere get a cone that never culls.
+     *
+     * \param max_vertices Vertex limit per meshlet, at most 256 (local indices are bytes). NVIDIA recommends 64.
+     * \param max_triangles Triangle limit per meshlet. NVIDIA recommends 124 (126 minus padding).
+     */
+    template<typename IndexType>
+    inline MeshletData buildMeshlets(std::vector<IndexType> const& indices,
+                                     void const*                   position_data,
+                                     std::size_t                   position_stride,
+                                     std::size_t                   vertex_cnt,
+                                     GLuint                        max_vertices = 64,
+                                     GLuint                        max_triangles = 124)
+    {
+        if (max_vertices < 3 || max_vertices > 256 || max_triangles < 1)
+        {
+            throw MeshException("buildMeshlets - Invalid meshlet limits");
+        }
+        if (indices.size() % 3 != 0)
+        {
+            throw MeshException("buildMeshlets - Index count is not a multiple of 3");
+        }
+
+        auto position = [position_data, position_stride](std::size_t v) {
+            return reinterpret_cast<GLfloat const*>(static_cast<GLubyte const*>(position_data) + v * position_stride);
+        };
+
+        MeshletData retval;
+        retval.max_vertices = max_vertices;
+        retval.max_triangles = max_triangles;
+        retval.meshlets.reserve(indices.size() / 3 / max_triangles + 1);
+        retval.vertex_indices.reserve(indices.size() / 2);
+        retval.local_indices.reserve(indices.size());
+
+        constexpr GLuint    invalid = std::numeric_limits<GLuint>::max();
+        std::vector<GLuint> local_ids(vertex_cnt, invalid);
+
+        auto finishMeshlet = [&](Meshlet& meshlet) {
+            GLuint const*  vertices = retval.vertex_indices.data() + meshlet.vertex_offset;
+            GLubyte const* local = retval.local_indices.data() + 3 * static_cast<std::size_t>(meshlet.triangle_offset);
+
+            // bounding sphere around the center of the bounding box
+            GLfloat box_min[3] = {std::numeric_limits<GLfloat>::max(),
+                                  std::numeric_limits<GLfloat>::max(),
+                                  std::numeric_limits<GLfloat>::max()};
+            GLfloat box_max[3] = {std::numeric_limits<GLfloat>::lowest(),
+                                  std::numeric_limits<GLfloat>::lowest(),
+                                  std::numeric_limits<GLfloat>::lowest()};
+            for (GLuint v = 0; v < meshlet.vertex_cnt; ++v)
+            {
+                GLfloat const* p = position(vertices[v]);
+                for (int c = 0; c < 3; ++c)
+                {
+                    box_min[c] = std::min(box_min[c], p[c]);
+                    box_max[c] = std::max(box_max[c], p[c]);
+                }
+            }
+
+            GLfloat radius_squared = 0.0f;
+            for (int c = 0; c < 3; ++c)
+            {
+                meshlet.bounding_sphere[c] = 0.5f * (box_min[c] + box_max[c]);
+            }
+            for (GLuint v = 0; v < meshlet.vertex_cnt; ++v)
+            {
+                GLfloat const* p = position(vertices[v]);
+                GLfloat        distance_squared = 0.0f;
+                for (int c = 0; c < 3; ++c)
+                {
+                    distance_squared += (p[c] - meshlet.bounding_sphere[c]) * (p[c] - meshlet.bounding_sphere[c]);
+                }
+                radius_squared = std::max(radius_squared, distance_squared);
+            }
+            meshlet.bounding_sphere[3] = std::sqrt(radius_squared);
+
+            // normal cone around the average triangle normal
+            std::vector<GLfloat> normals;
+            normals.reserve(meshlet.triangle_cnt * 3);
+            GLfloat axis[3] = {0.0f, 0.0f, 0.0f};
+            for (GLuint t = 0; t < meshlet.triangle_cnt; ++t)
+            {
+                GLfloat const* p0 = position(vertices[local[3 * t + 0]]);
+                GLfloat const* p1 = position(vertices[local[3 * t + 1]]);
+                GLfloat const* p2 = position(vertices[local[3 * t + 2]]);
+
+                GLfloat e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                GLfloat e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                GLfloat n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                                e1[2] * e2[0] - e1[0] * e2[2],
+                                e1[0] * e2[1] - e1[1] * e2[0]};
+                GLfloat length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length == 0.0f)
+                {
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c)
+                {
+                    normals.push_back(n[c] / length);
+                    axis[c] += n[c] / length;
+                }
+            }
+
+            GLfloat axis_length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+            GLfloat min_dot = axis_length > 0.0f ? 1.0f : -1.0f;
+            for (std::size_t n = 0; n < normals.size() && axis_length > 0.0f; n += 3)
+            {
+                GLfloat dot = normals[n] * axis[0] + normals[n + 1] * axis[1] + normals[n + 2] * axis[2];
+                min_dot = std::min(min_dot, dot / axis_length);
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                meshlet.normal_cone[c] = axis_length > 0.0f ? axis[c] / axis_length : 0.0f;
+            }
+            // cull if the view direction is within 90 degrees minus the cone angle of the axis, never if min_dot <= 0
+            meshlet.normal_cone[3] = min_dot > 0.0f ? std::sqrt(1.0f - std::min(min_dot * min_dot, 1.0f)) : 1.0f;
+
+            for (GLuint v = 0; v < meshlet.vertex_cnt; ++v)
+            {
+                local_ids[vertices[v]] = invalid;
+            }
+        };
+
+        Meshlet meshlet = {};
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::size_t a = static_cast<std::size_t>(indices[i + 0]);
+            std::size_t b = static_cast<std::size_t>(indices[i + 1]);
+            std::size_t c = static_cast<std::size_t>(indices[i + 2]);
+            if (a >= vertex_cnt || b >= vertex_cnt || c >= vertex_cnt)
+            {
+                throw MeshException("buildMeshlets - Index out of range");
+            }
+
+            GLuint new_vertex_cnt = (local_ids[a] == invalid ? 1 : 0) + (local_ids[b] == invalid && b != a ? 1 : 0) +
+                                    (local_ids[c] == invalid && c != a && c != b ? 1 : 0);
+
+            if (meshlet.vertex_cnt + new_vertex_cnt > max_vertices || meshlet.triangle_cnt == max_triangles)
+            {
+                finishMeshlet(meshlet);
+                retval.meshlets.push_back(meshlet);
+
+                meshlet = Meshlet{};
+                meshlet.vertex_offset = static_cast<GLuint>(retval.vertex_indices.size());
+                meshlet.triangle_offset = static_cast<GLuint>(retval.local_indices.size() / 3);
+            }
+
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                GLuint v = static_cast<GLuint>(indices[i + corner]);
+                if (local_ids[v] == invalid)
+                {
+                    local_ids[v] = meshlet.vertex_cnt++;
+                    retval.vertex_indices.push_back(v);
+                }
+                retval.local_indices.push_back(static_cast<GLubyte>(local_ids[v]));
+            }
+            ++meshlet.triangle_cnt;
+        }
+
+        if (meshlet.triangle_cnt > 0)
+        {
+            finishMeshlet(meshlet);
+            retval.meshlets.push_back(meshlet);
+        }
+
+        retval.local_indices.resize((retval.local_indices.size() + 3) & ~std::size_t(3), 0);
+
+        return retval;
+    }
+
+    /**
+     * \class MeshletBuffers
+     *
+     * \brief Meshlet descriptors, vertex indices and local indices in shader storage buffers.
+     *
+     * Vertex data is not part of the meshlet buffers, bind the vertex buffers of the corresponding Mesh as shader
+     * storage buffers for fetching vertices in the mesh shader.
+     *
+     * \author Michael Becher
+     */
+    class MeshletBuffers
+    {
+    public:
+        /**
+         * \brief MeshletBuffers constructor.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        MeshletBuffers(MeshletData const& meshlet_data,
+                       GLenum             usage = GL_STATIC_DRAW,
+                       NamePool*          buffer_pool = nullptr);
+
+        /**
+         * \brief Bind meshlet descriptors, vertex indices and local indices to the given storage buffer bindings.
+         */
+        void bind(GLuint meshlet_binding, GLuint vertex_index_binding, GLuint local_index_binding) const;
+
+#ifdef GLOWL_USE_NV_MESH_SHADER
+        /**
+         * \brief Launch one task shader workgroup per meshlets_per_task meshlets (or one mesh shader workgroup per
+         * meshlet without task shader). Buffers and program have to be bound by the caller.
+         */
+        void drawMeshTasks(GLuint meshlets_per_task = 1) const;
+#endif
+
+        GLuint getMeshletCount() const;
+
+        BufferObject const& getMeshletBuffer() const;
+
+        BufferObject const& getVertexIndexBuffer() const;
+
+        BufferObject const& getLocalIndexBuffer() const;
+
+    private:
+        GLuint       m_meshlet_cnt;
+        BufferObject m_meshlets;
+        BufferObject m_vertex_indices;
+        BufferObject m_local_indices;
+    };
+
+    inline MeshletBuffers::MeshletBuffers(MeshletData const& meshlet_data, GLenum usage, NamePool* buffer_pool)
+        : m_meshlet_cnt(static_cast<GLuint>(meshlet_data.meshlets.size())),
+          m_meshlets(GL_SHADER_STORAGE_BUFFER, meshlet_data.meshlets, usage, buffer_pool),
+          m_vertex_indices(GL_SHADER_STORAGE_BUFFER, meshlet_data.vertex_indices, usage, buffer_pool),
+          m_local_indices(GL_SHADER_STORAGE_BUFFER, meshlet_data.local_indices, usage, buffer_pool)
+    {
+    }
+
+    inline void MeshletBuffers::bind(GLuint meshlet_binding,
+                                     GLuint vertex_index_binding,
+                                     GLuint local_index_binding) const
+    {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, meshlet_binding, m_meshlets.getName());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, vertex_index_binding, m_vertex_indices.getName());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, local_index_binding, m_local_indices.getName());
+    }
+
+#ifdef GLOWL_USE_NV_MESH_SHADER
+    inline void MeshletBuffers::drawMeshTasks(GLuint meshlets_per_task) const
+    {
+        GLuint task_cnt = (m_meshlet_cnt + meshlets_per_task - 1) / meshlets_per_task;
+        if (task_cnt > 0)
+        {
+            glDrawMeshTasksNV(0, task_cnt);
+        }
+    }
+#endif
+
+    inline GLuint MeshletBuffers::getMeshletCount() const
+    {
+        return m_meshlet_cnt;
+    }
+
+    inline BufferObject const& MeshletBuffers::getMeshletBuffer() const
+    {
+        return m_meshlets;
+    }
+
+    inline BufferObject const& MeshletBuffers::getVertexIndexBuffer() const
+    {
+        return m_vertex_indices;
+    }
+
+    inline BufferObject const& MeshletBuffers::getLocalIndexBuffer() const
+    {
+        return m_local_indices;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_MESHLETS_HPP
@@ -0,0 +1,445 @@
+/*
+ * NamePool.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_NAMEPOOL_HPP
+#define GLOWL_NAMEPOOL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class NamePool
+     *
+     * \brief Pool of OpenGL object names of a single type that are created in batches.
+     *
+     * Instead of one glCreate* call per object, names are created batch_size at a time and handed out on request.
+     * Released names are deleted by default. Buffer pools can opt into recycling names of buffers with mutable
+     * storage. Names of objects with immutable storage (textures, immutable buffers) or with state that is not fully
+     * respecified on construction (samplers, vertex arrays) are always deleted on release.
+     *
+     * Unlike glDeleteBuffers, recycling does not detach a buffer from vertex arrays or (indexed) binding points, so
+     * any such reference would alias the next owner of the name. Only enable recycling if released buffers are
+     * guaranteed to be unreferenced, e.g. because their vertex arrays are deleted first and binding points are
+     * rebound before use.
+     *
+     * The pool is injected into the constructors of glowl objects as an optional pointer and has to outlive all
+     * objects that were constructed with it. It is not thread-safe.
+     *
+     * \author Michael Becher
+     */
+    class NamePool
+    {
+    public:
+        enum class Type
+        {
+            Buffer,
+            Texture,
+            Sampler,
+            VertexArray
+        };
+
+        /**
+         * \brief NamePool constructor for buffer, sampler or vertex array names.
+         *
+         * \param recycle Keep released buffer names for reuse, see the class description. Ignored for other types.
+         *
+         * Note: Active OpenGL context required for usage.
+         */
+        explicit NamePool(Type type, GLsizei batch_size = 256, bool recycle = false);
+
+        /**
+         * \brief NamePool constructor for texture names of the given texture target, e.g. GL_TEXTURE_2D.
+         *
+         * Note: Active OpenGL context required for usage.
+         */
+        explicit NamePool(GLenum texture_target, GLsizei batch_size = 256);
+
+        /**
+         * Deletes all names that are currently not in use.
+         */
+        ~NamePool();
+
+        NamePool(const NamePool&) = delete;
+        NamePool(NamePool&&) = delete;
+        NamePool& operator=(NamePool&&) = delete;
+        NamePool& operator=(const NamePool&) = delete;
+
+        /**
+         * \brief Returns a name, creating a new batch of names if the pool is empty.
+         */
+        GLuint acquire();
+
+        /**
+         * \brief Return a name to the pool.
+         *
+         * \param recycle Keep the name for reuse if the pool recycles names. Otherwise the name is deleted.
+         */
+        void release(GLuint name, bool recycle);
+
+        /**
+         * \brief Make sure at least name_cnt names are available without further glCreate* calls.
+         */
+        void reserve(GLsizei name_cnt);
+
+        /**
+         * \brief Delete all names that are currently not in use.
+         */
+        void trim();
+
+        Type getType() const;
+
+        GLenum getTextureTarget() const;
+
+        bool isRecycling() const;
+
+        GLsizei getBatchSize() const;
+
+        void setBatchSize(GLsizei batch_size);
+
+        std::size_t getAvailableCount() const;
+
+        /**
+         * \brief Returns the number of acquired names that were available without a glCreate* call.
+         */
+        std::uint64_t getHitCount() const;
+
+        /**
+         * \brief Returns the number of acquired names that required a new batch to be created.
+         */
+        std::uint64_t getMissCount() const;
+
+        /**
+         * \brief Returns the ratio of hits to all acquired names.
+         */
+        double getHitRate() const;
+
+        /**
+         * \brief Returns the number of released names that were kept for reuse.
+         */
+        std::uint64_t getRecycleCount() const;
+
+        /**
+         * \brief Returns the number of glCreate* calls issued by the pool.
+         */
+        std::uint64_t getBatchCount() const;
+
+        void resetStatistics();
+
+    private:
+        void createNames(GLsizei name_cnt);
+
+        void deleteNames(GLsizei name_cnt, GLuint const* names);
+
+        Type                m_type;
+        GLenum              m_texture_target;
+        GLsizei             m_batch_size;
+        bool                m_recycle;
+        std::vector<GLuint> m_available_names;
+
+        std::uint64_t m_hit_cnt;
+        std::uint64_t m_miss_cnt;
+        std::uint64_t m_recycle_cnt;
+        std::uint64_t m_batch_cnt;
+    };
+
+    /**
+     * \brief Acquire a name from the pool if one is given, otherwise create a single name.
+     * Throws if the pool manages names of a different type or texture target.
+     */
+    inline GLuint acquireName(NamePool* pool, NamePool::Type type, GLenum texture_target = GL_NONE)
+    {
+        GLuint name = 0;
+
+        if (pool != nullptr)
+        {
+            if (pool->getType() != type || pool->getTextureTarget() != texture_target)
+            {
+                throw NamePoolException("acquireName - name pool does not match requested object type");
+            }
+            return pool->acquire();
+        }
+
+        switch (type)
+        {
+        case NamePool::Type::Buffer:
+            glCreateBuffers(1, &name);
+            break;
+        case NamePool::Type::Texture:
+            glCreateTextures(texture_target, 1, &name);
+            break;
+        case NamePool::Type::Sampler:
+            glCreateSamplers(1, &name);
+            break;
+        case NamePool::Type::VertexArray:
+            glCreateVertexArrays(1, &name);
+            break;
+        }
+
+        return name;
+    }
+
+    /**
+     * \brief Release a name to the pool if one is given, otherwise delete it. Name 0 is ignored.
+     */
+    inline void releaseName(NamePool* pool, NamePool::Type type, GLuint name, bool recycle)
+    {
+        if (name == 0)
+        {
+            return;
+        }
+
+        if (pool != nullptr)
+        {
+            pool->release(name, recycle);
+            return;
+        }
+
+        switch (type)
+        {
+        case NamePool::Type::Buffer:
+            glDeleteBuffers(1, &name);
+            break;
+        case NamePool::Type::Texture:
+            glDeleteTextures(1, &name);
+            break;
+        case NamePool::Type::Sampler:
+            glDeleteSamplers(1, &name);
+            break;
+        case NamePool::Type::VertexArray:
+            glDeleteVertexArrays(1, &name);
+            break;
+        }
+    }
+
+    inline NamePool::NamePool(Type type, GLsizei batch_size, bool recycle)
+        : m_type(type),
+          m_texture_target(GL_NONE),
+          m_batch_size(batch_size),
+          m_recycle(recycle && type == Type::Buffer),
+          m_available_names(),
+          m_hit_cnt(0),
+          m_miss_cnt(0),
+          m_recycle_cnt(0),
+          m_batch_cnt(0)
+    {
+        if (type == Type::Texture)
+        {
+            throw NamePoolException("NamePool::NamePool - texture name pools require a texture target");
+        }
+        if (batch_size < 1)
+        {
+            throw NamePoolException("NamePool::NamePool - invalid batch size");
+        }
+    }
+
+    inline NamePool::NamePool(GLenum texture_target, GLsizei batch_size)
+        : m_type(Type::Texture),
+          m_texture_target(texture_target),
+          m_batch_size(batch_size),
+          m_recycle(false),
+          m_available_names(),
+          m_hit_cnt(0),
+          m_miss_cnt(0),
+          m_recycle_cnt(0),
+          m_batch_cnt(0)
+    {
+        if (batch_size < 1)
+        {
+            throw NamePoolException("NamePool::NamePool - invalid batch size");
+        }
+    }
+
+    inline NamePool::~NamePool()
+    {
+        trim();
+    }
+
+    inline GLuint NamePool::acquire()
+    {
+        if (m_available_names.empty())
+        {
+            createNames(m_batch_size);
+            ++m_miss_cnt;
+        }
+        else
+        {
+            ++m_hit_cnt;
+        }
+
+        GLuint name = m_available_names.back();
+        m_available_names.pop_back();
+
+        return name;
+    }
+
+    inline void NamePool::release(GLuint name, bool recycle)
+    {
+        if (name == 0)
+        {
+            return;
+        }
+
+        if (!recycle || !m_recycle)
+        {
+            deleteNames(1, &name);
+            return;
+        }
+
+        // drop the storage, it is respecified by the next owner anyway
+        glNamedBufferData(name, 0, nullptr, GL_STATIC_DRAW);
+
+        m_available_names.push_back(name);
+        ++m_recycle_cnt;
+    }
+
+    inline void NamePool::reserve(GLsizei name_cnt)
+    {
+        if (name_cnt > static_cast<GLsizei>(m_available_names.size()))
+        {
+            createNames(name_cnt - static_cast<GLsizei>(m_available_names.size()));
+        }
+    }
+
+    inline void NamePool::trim()
+    {
+        deleteNames(static_cast<GLsizei>(m_available_names.size()), m_available_names.data());
+        m_available_names.clear();
+    }
+
+    inline NamePool::Type NamePool::getType() const
+    {
+        return m_type;
+    }
+
+    inline GLenum NamePool::getTextureTarget() const
+    {
+        return m_texture_target;
+    }
+
+    inline bool NamePool::isRecycling() const
+    {
+        return m_recycle;
+    }
+
+    inline GLsizei NamePool::getBatchSize() const
+    {
+        return m_batch_size;
+    }
+
+    inline void NamePool::setBatchSize(GLsizei batch_size)
+    {
+        if (batch_size < 1)
+        {
+            throw NamePoolException("NamePool::setBatchSize - invalid batch size");
+        }
+        m_batch_size = batch_size;
+    }
+
+    inline std::size_t NamePool::getAvailableCount() const
+    {
+        return m_available_names.size();
+    }
+
+    inline std::uint64_t NamePool::getHitCount() const
+    {
+        return m_hit_cnt;
+    }
+
+    inline std::uint64_t NamePool::getMissCount() const
+    {
+        return m_miss_cnt;
+    }
+
+    inline double NamePool::getHitRate() const
+    {
+        std::uint64_t acquire_cnt = m_hit_cnt + m_miss_cnt;
+        return acquire_cnt > 0 ? static_cast<double>(m_hit_cnt) / static_cast<double>(acquire_cnt) : 0.0;
+    }
+
+    inline std::uint64_t NamePool::getRecycleCount() const
+    {
+        return m_recycle_cnt;
+    }
+
+    inline std::uint64_t NamePool::getBatchCount() const
+    {
+        return m_batch_cnt;
+    }
+
+    inline void NamePool::resetStatistics()
+    {
+        m_hit_cnt = 0;
+        m_miss_cnt = 0;
+        m_recycle_cnt = 0;
+        m_batch_cnt = 0;
+    }
+
+    inline void NamePool::createNames(GLsizei name_cnt)
+    {
+        std::size_t available_cnt = m_available_names.size();
+        m_available_names.resize(available_cnt + static_cast<std::size_t>(name_cnt));
+        GLuint* names = m_available_names.data() + available_cnt;
+
+        switch (m_type)
+        {
+        case Type::Buffer:
+            glCreateBuffers(name_cnt, names);
+            break;
+        case Type::Texture:
+            glCreateTextures(m_texture_target, name_cnt, names);
+            break;
+        case Type::Sampler:
+            glCreateSamplers(name_cnt, names);
+            break;
+        case Type::VertexArray:
+            glCreateVertexArrays(name_cnt, names);
+            break;
+        }
+        ++m_batch_cnt;
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            m_available_names.resize(available_cnt);
+            throw NamePoolException("NamePool::createNames - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline void NamePool::deleteNames(GLsizei name_cnt, GLuint const* names)
+    {
+        if (name_cnt == 0)
+        {
+            return;
+        }
+
+        switch (m_type)
+        {
+        case Type::Buffer:
+            glDeleteBuffers(name_cnt, names);
+            break;
+        case Type::Texture:
+            glDeleteTextures(name_cnt, names);
+            break;
+        case Type::Sampler:
+            glDeleteSamplers(name_cnt, names);
+            break;
+        case Type::VertexArray:
+            glDeleteVertexArrays(name_cnt, names);
+            break;
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_NAMEPOOL_HPP
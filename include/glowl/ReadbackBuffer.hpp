@@ -0,0 +1,390 @@
+/*
+ * ReadbackBuffer.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_READBACKBUFFER_HPP
+#define GLOWL_READBACKBUFFER_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "ImmutableBufferObject.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class ReadbackBuffer
+     *
+     * \brief Non-blocking GPU to CPU readback of buffer contents.
+     *
+     * A readback copies a buffer range into one of several slots of a persistently mapped readback buffer on the GPU
+     * timeline and fences the copy. The returned Handle can be polled (or waited on) and gives direct access to the
+     * mapped results without additional copies. The slot is released once the Handle is destroyed, so several frames
+     * of results can be in flight at once.
+     *
+     * Usage:
+     *   auto handle = readback_buffer.readback(result_buffer, 0, byte_size);
+     *   ... some frames later ...
+     *   if (handle.isReady()) { float const* results = handle.data<float>(); ... }
+     *
+     * \author Michael Becher
+     */
+    class ReadbackBuffer
+    {
+    public:
+        class Handle
+        {
+        public:
+            Handle() = default;
+            ~Handle();
+
+            Handle(const Handle&) = delete;
+            Handle(Handle&& other) noexcept;
+            Handle& operator=(Handle&& rhs) noexcept;
+            Handle& operator=(const Handle&) = delete;
+
+            bool valid() const;
+
+            /**
+             * \brief Returns true if the copy has finished. Never blocks.
+             */
+            bool isReady() const;
+
+            /**
+             * \brief Blocks until the copy has finished.
+             */
+            void wait() const;
+
+            /**
+             * \brief Returns a pointer to the results. Only valid if isReady() returned true or after wait().
+             */
+            template<typename T>
+            T const* data() const;
+
+            /**
+             * \brief Returns the number of results of type T.
+             */
+            template<typename T>
+            std::size_t size() const;
+
+            GLsizeiptr getByteSize() const;
+
+            /**
+             * \brief Return the slot to the ReadbackBuffer before destruction.
+             */
+            void release();
+
+        private:
+            friend class ReadbackBuffer;
+
+            Handle(ReadbackBuffer* owner, GLuint slot) : m_owner(owner), m_slot(slot) {}
+
+            ReadbackBuffer* m_owner = nullptr;
+            GLuint          m_slot = 0;
+        };
+
+        /**
+         * \brief ReadbackBuffer constructor.
+         *
+         * \param slot_byte_size Maximum byte size of a single readback
+         * \param slot_cnt Maximum number of readbacks in flight
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        ReadbackBuffer(GLsizeiptr slot_byte_size, GLuint slot_cnt = 3);
+
+        /**
+         * Note: All handles have to be released before destruction.
+         */
+        ~ReadbackBuffer();
+
+        ReadbackBuffer(const ReadbackBuffer&) = delete;
+        ReadbackBuffer(ReadbackBuffer&&) = delete;
+        ReadbackBuffer& operator=(ReadbackBuffer&&) = delete;
+        ReadbackBuffer& operator=(const ReadbackBuffer&) = delete;
+
+        /**
+         * \brief Start reading back byte_size bytes at byte_offset of the given buffer.
+         * Throws if no slot is available, see getFreeSlotCount().
+         */
+        Handle readback(GLuint buffer, GLintptr byte_offset, GLsizeiptr byte_size);
+
+        Handle readback(BufferObject const& buffer, GLintptr byte_offset, GLsizeiptr byte_size);
+
+        Handle readback(ImmutableBufferObject const& buffer, GLintptr byte_offset, GLsizeiptr byte_size);
+
+        GLuint getFreeSlotCount() const;
+
+        GLuint getSlotCount() const;
+
+        GLsizeiptr getSlotByteSize() const;
+
+    private:
+        struct Slot
+        {
+            GLsync     fence = nullptr;
+            GLsizeiptr byte_size = 0;
+            bool       in_use = false;
+        };
+
+        bool isReady(GLuint slot);
+        void wait(GLuint slot);
+        void release(GLuint slot);
+
+        ImmutableBufferObject m_buffer;
+        GLubyte const*        m_mapped_data;
+        GLsizeiptr            m_slot_byte_size;
+        std::vector<Slot>     m_slots;
+    };
+
+    inline ReadbackBuffer::Handle::~Handle()
+    {
+        release();
+    }
+
+    inline ReadbackBuffer::Handle::Handle(Handle&& other) noexcept
+        : m_owner(std::exchange(other.m_owner, nullptr)),
+          m_slot(other.m_slot)
+    {
+    }
+
+    inline ReadbackBuffer::Handle& ReadbackBuffer::Handle::operator=(Handle&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            m_owner = std::exchange(rhs.m_owner, nullptr);
+            m_slot = rhs.m_slot;
+        }
+        return *this;
+    }
+
+    inline bool ReadbackBuffer::Handle::valid() const
+    {
+        return m_owner != nullptr;
+    }
+
+    inline bool ReadbackBuffer::Handle::isReady() const
+    {
+        return m_owner != nullptr && m_owner->isReady(m_slot);
+    }
+
+    inline void ReadbackBuffer::Handle::wait() const
+    {
+        if (m_owner != nullptr)
+        {
+            m_owner->wait(m_slot);
+        }
+    }
+
+    template<typename T>
+    inline T const* ReadbackBuffer::Handle::data() const
+    {
+        if (m_owner == nullptr)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<T const*>(m_owner->m_mapped_data + m_slot * m_owner->m_slot_byte_size);
+    }
+
+    template<typename T>
+    inline std::size_t ReadbackBuffer::Handle::size() const
+    {
+        return static_cast<std::size_t>(getByteSize()) / sizeof(T);
+    }
+
+    inline GLsizeiptr ReadbackBuffer::Handle::getByteSize() const
+    {
+        return m_owner != nullptr ? m_owner->m_slots[m_slot].byte_size : 0;
+    }
+
+    inline void ReadbackBuffer::Handle::release()
+    {
+        if (m_owner != nullptr)
+        {
+            m_owner->release(m_slot);
+            m_owner = nullptr;
+        }
+    }
+
+    inline ReadbackBuffer::ReadbackBuffer(GLsizeiptr slot_byte_size, GLuint slot_cnt)
+        : m_buffer(nullptr,
+                   slot_byte_size * slot_cnt,
+                   GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_CLIENT_STORAGE_BIT),
+          m_mapped_data(nullptr),
+          m_slot_byte_size(slot_byte_size),
+          m_slots(slot_cnt)
+    {
+        m_mapped_data = static_cast<GLubyte const*>(glMapNamedBufferRange(m_buffer.getName(),
+                                                                          0,
+                                                                          m_buffer.getByteSize(),
+                                                                          GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT |
+                                                                              GL_MAP_COHERENT_BIT));
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR || m_mapped_data == nullptr)
+        {
+            throw BufferObjectException("ReadbackBuffer::ReadbackBuffer - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline ReadbackBuffer::~ReadbackBuffer()
+    {
+        for (auto& slot : m_slots)
+        {
+            if (slot.fence != nullptr)
+            {
+                glDeleteSync(slot.fence);
+            }
+        }
+
+        glUnmapNamedBuffer(m_buffer.getName());
+    }
+
+    inline ReadbackBuffer::Handle ReadbackBuffer::readback(GLuint buffer, GLintptr byte_offset, GLsizeiptr byte_size)
+    {
+        if (byte_size > m_slot_byte_size)
+        {
+            throw BufferObjectException("ReadbackBuffer::readback - readback of " + std::to_string(byte_size) +
+                                        " bytes exceeds slot size");
+        }
+
+        for (GLuint slot_idx = 0; slot_idx < m_slots.size(); ++slot_idx)
+        {
+            Slot& slot = m_slots[slot_idx];
+            if (!slot.in_use)
+            {
+                glCopyNamedBufferSubData(buffer,
+                                         m_buffer.getName(),
+                                         byte_offset,
+                                         static_cast<GLintptr>(slot_idx) * m_slot_byte_size,
+                                         byte_size);
+                slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                slot.byte_size = byte_size;
+                slot.in_use = true;
+
+                auto err = glGetError();
+                if (err != GL_NO_ERROR)
+                {
+                    release(slot_idx);
+                    throw BufferObjectException("ReadbackBuffer::readback - OpenGL error " + std::to_string(err));
+                }
+
+                return Handle(this, slot_idx);
+            }
+        }
+
+        throw BufferObjectException("ReadbackBuffer::readback - no free readback slot");
+    }
+
+    inline ReadbackBuffer::Handle ReadbackBuffer::readback(BufferObject const& buffer,
+                                                           GLintptr            byte_offset,
+                                                           GLsizeiptr          byte_size)
+    {
+        if ((byte_offset + byte_size) > buffer.getByteSize())
+        {
+            throw BufferObjectException("ReadbackBuffer::readback - source range out of bounds");
+        }
+        return readback(buffer.getName(), byte_offset, byte_size);
+    }
+
+    inline ReadbackBuffer::Handle ReadbackBuffer::readback(ImmutableBufferObject const& buffer,
+                                                           GLintptr                     byte_offset,
+                                                           GLsizeiptr                   byte_size)
+    {
+        if ((byte_offset + byte_size) > buffer.getByteSize())
+        {
+            throw BufferObjectException("ReadbackBuffer::readback - source range out of bounds");
+        }
+        return readback(buffer.getName(), byte_offset, byte_size);
+    }
+
+    inline GLuint ReadbackBuffer::getFreeSlotCount() const
+    {
+        GLuint retval = 0;
+        for (auto const& slot : m_slots)
+        {
+            retval += slot.in_use ? 0 : 1;
+        }
+        return retval;
+    }
+
+    inline GLuint ReadbackBuffer::getSlotCount() const
+    {
+        return static_cast<GLuint>(m_slots.size());
+    }
+
+    inline GLsizeiptr ReadbackBuffer::getSlotByteSize() const
+    {
+        return m_slot_byte_size;
+    }
+
+    inline bool ReadbackBuffer::isReady(GLuint slot)
+    {
+        GLsync& fence = m_slots[slot].fence;
+        if (fence == nullptr)
+        {
+            return true;
+        }
+
+        // flush once so that the fence is guaranteed to be signalled eventually
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+            return true;
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            throw BufferObjectException("ReadbackBuffer::isReady - waiting for fence failed");
+        }
+
+        return false;
+    }
+
+    inline void ReadbackBuffer::wait(GLuint slot)
+    {
+        GLsync& fence = m_slots[slot].fence;
+        if (fence == nullptr)
+        {
+            return;
+        }
+
+        GLenum result = GL_TIMEOUT_EXPIRED;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+
+        if (result == GL_WAIT_FAILED)
+        {
+            throw BufferObjectException("ReadbackBuffer::wait - waiting for fence failed");
+        }
+    }
+
+    inline void ReadbackBuffer::release(GLuint slot)
+    {
+        if (m_slots[slot].fence != nullptr)
+        {
+            glDeleteSync(m_slots[slot].fence);
+        }
+        m_slots[slot] = Slot();
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_READBACKBUFFER_HPP
@@ -10,9 +10,11 @@
 
 #include <array>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Exceptions.hpp"
+#include "NamePool.hpp"
 #include "glinclude.h"
 
 namespace glowl
@@ -85,14 +87,19 @@ namespace glowl
     class Sampler
     {
     public:
-        Sampler(std::string id) : m_id(id)
+        /**
+         * \param name_pool Optional sampler name pool, has to outlive the sampler
+         */
+        Sampler(std::string id, NamePool* name_pool = nullptr) : m_id(id), m_name_pool(name_pool)
         {
-            glCreateSamplers(1, &m_name);
+            m_name = acquireName(m_name_pool, NamePool::Type::Sampler);
         }
 
-        Sampler(std::string id, SamplerLayout const& layout) : m_id(id)
+        Sampler(std::string id, SamplerLayout const& layout, NamePool* name_pool = nullptr)
+            : m_id(id),
+              m_name_pool(name_pool)
         {
-            glCreateSamplers(1, &m_name);
+            m_name = acquireName(m_name_pool, NamePool::Type::Sampler);
 
             for (const auto& p : layout.int_parameters)
             {
@@ -151,9 +158,13 @@ namespace glowl
             }
         }
 
-        Sampler(std::string id, std::vector<std::pair<GLenum, GLint>> const& int_params) : m_id(id)
+        Sampler(std::string                                  id,
+                std::vector<std::pair<GLenum, GLint>> const& int_params,
+                NamePool*                                    name_pool = nullptr)
+            : m_id(id),
+              m_name_pool(name_pool)
         {
-            glCreateSamplers(1, &m_name);
+            m_name = acquireName(m_name_pool, NamePool::Type::Sampler);
 
             for (const auto& p : int_params)
             {
@@ -194,9 +205,13 @@ namespace glowl
             }
         }
 
-        Sampler(std::string id, std::vector<std::pair<GLenum, GLfloat>> const& float_params) : m_id(id)
+        Sampler(std::string                                    id,
+                std::vector<std::pair<GLenum, GLfloat>> const& float_params,
+                NamePool*                                      name_pool = nullptr)
+            : m_id(id),
+              m_name_pool(name_pool)
         {
-            glCreateSamplers(1, &m_name);
+            m_name = acquireName(m_name_pool, NamePool::Type::Sampler);
 
             for (const auto& p : float_params)
             {
@@ -224,13 +239,53 @@ namespace glowl
 
         ~Sampler()
         {
-            glDeleteSamplers(1, &m_name);
+            releaseName(m_name_pool, NamePool::Type::Sampler, m_name, false);
         }
 
         Sampler(const Sampler&) = delete;
-        Sampler(Sampler&& other) = delete;
         Sampler& operator=(const Sampler& rhs) = delete;
-        Sampler& operator=(Sampler&& rhs) = delete;
+
+        /**
+         * \brief Move constructor. Takes over the sampler name, the moved-from sampler is left with name 0.
+         */
+        Sampler(Sampler&& other) noexcept
+            : m_id(std::move(other.m_id)),
+              m_name(std::exchange(other.m_name, 0)),
+              m_name_pool(other.m_name_pool),
+              m_texture_min_filter(other.m_texture_min_filter),
+              m_texture_mag_filter(other.m_texture_mag_filter),
+              m_texture_min_lod(other.m_texture_min_lod),
+              m_texture_max_lod(other.m_texture_max_lod),
+              m_texture_wrap_s(other.m_texture_wrap_s),
+              m_texture_wrap_t(other.m_texture_wrap_t),
+              m_texture_wrap_r(other.m_texture_wrap_r),
+              m_texture_border_color(other.m_texture_border_color),
+              m_texture_compare_mode(other.m_texture_compare_mode),
+              m_texture_compare_func(other.m_texture_compare_func)
+        {
+        }
+
+        Sampler& operator=(Sampler&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                releaseName(m_name_pool, NamePool::Type::Sampler, m_name, false);
+                m_id = std::move(rhs.m_id);
+                m_name = std::exchange(rhs.m_name, 0);
+                m_name_pool = rhs.m_name_pool;
+                m_texture_min_filter = rhs.m_texture_min_filter;
+                m_texture_mag_filter = rhs.m_texture_mag_filter;
+                m_texture_min_lod = rhs.m_texture_min_lod;
+                m_texture_max_lod = rhs.m_texture_max_lod;
+                m_texture_wrap_s = rhs.m_texture_wrap_s;
+                m_texture_wrap_t = rhs.m_texture_wrap_t;
+                m_texture_wrap_r = rhs.m_texture_wrap_r;
+                m_texture_border_color = rhs.m_texture_border_color;
+                m_texture_compare_mode = rhs.m_texture_compare_mode;
+                m_texture_compare_func = rhs.m_texture_compare_func;
+            }
+            return *this;
+        }
 
         void bindSampler(GLuint tex_unit) const
         {
@@ -344,6 +399,8 @@ namespace glowl
 
         GLuint m_name; ///< OpenGL sampler name given by glCreateSampler
 
+        NamePool* m_name_pool; ///< Optional sampler name pool, see NamePool
+
         GLint                  m_texture_min_filter = GL_TEXTURE_MIN_FILTER;
         GLint                  m_texture_mag_filter = GL_LINEAR;
         GLfloat                m_texture_min_lod = -1000;
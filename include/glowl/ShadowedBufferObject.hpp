@@ -0,0 +1,395 @@
+/*
+ * ShadowedBufferObject.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_SHADOWEDBUFFEROBJECT_HPP
+#define GLOWL_SHADOWEDBUFFEROBJECT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class DirtyRangeSet
+     *
+     * \brief Set of disjoint byte ranges. Overlapping and adjacent ranges are merged on insertion.
+     */
+    class DirtyRangeSet
+    {
+    public:
+        struct Range
+        {
+            GLintptr begin;
+            GLintptr end; ///< exclusive
+        };
+
+        void add(GLintptr byte_offset, GLsizeiptr byte_size);
+
+        /**
+         * \brief Returns the ranges in ascending order, additionally merging ranges that are separated by no more
+         * than gap_threshold bytes.
+         */
+        std::vector<Range> coalesce(GLsizeiptr gap_threshold) const;
+
+        /**
+         * \brief Returns the number of bytes covered by the set.
+         */
+        GLsizeiptr getByteSize() const;
+
+        std::size_t getRangeCount() const;
+
+        bool empty() const;
+
+        void clear();
+
+    private:
+        std::map<GLintptr, GLintptr> m_ranges; ///< begin -> end
+        GLsizeiptr                   m_byte_size = 0;
+    };
+
+    /**
+     * \class ShadowedBufferObject
+     *
+     * \brief Buffer object with a CPU-side shadow copy and deferred, coalesced uploads.
+     *
+     * Writes only modify the shadow copy and record the dirty byte range. At an explicit sync point, flush() merges
+     * dirty ranges that are at most the merge gap apart and uploads them with one glNamedBufferSubData call per merged
+     * range, or with a single buffer mapping. Compare getDirtiedByteSize() and getUploadedByteSize() to tune the merge
+     * gap: a larger gap means fewer calls but more redundant bytes.
+     *
+     * \author Michael Becher
+     */
+    class ShadowedBufferObject
+    {
+    public:
+        enum class FlushMode
+        {
+            SubData, ///< One glNamedBufferSubData per merged range
+            Mapped   ///< Map the span of all merged ranges once and flush each range explicitly
+        };
+
+        /**
+         * \brief ShadowedBufferObject constructor that uses std containers as input.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        template<typename Container>
+        ShadowedBufferObject(GLenum           target,
+                             Container const& datastorage,
+                             GLenum           usage = GL_DYNAMIC_DRAW,
+                             GLsizeiptr       merge_gap = 256);
+
+        /**
+         * \brief ShadowedBufferObject constructor that uses data pointer and byte size as input.
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        ShadowedBufferObject(GLenum        target,
+                             GLvoid const* data,
+                             GLsizeiptr    byte_size,
+                             GLenum        usage = GL_DYNAMIC_DRAW,
+                             GLsizeiptr    merge_gap = 256);
+
+        ShadowedBufferObject(const ShadowedBufferObject&) = delete;
+        ShadowedBufferObject(ShadowedBufferObject&&) noexcept = default;
+        ShadowedBufferObject& operator=(ShadowedBufferObject&&) noexcept = default;
+        ShadowedBufferObject& operator=(const ShadowedBufferObject&) = delete;
+
+        /**
+         * \brief Copy data into the shadow copy and mark the range dirty.
+         */
+        void write(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset);
+
+        /**
+         * \brief Returns a pointer to count elements of type T in the shadow copy and marks them dirty.
+         */
+        template<typename T>
+        T* modify(GLsizeiptr byte_offset, std::size_t count = 1);
+
+        /**
+         * \brief Upload all dirty ranges.
+         */
+        void flush(FlushMode mode = FlushMode::SubData);
+
+        void setMergeGap(GLsizeiptr merge_gap);
+
+        GLsizeiptr getMergeGap() const;
+
+        GLubyte const* getShadowData() const;
+
+        BufferObject const& getBuffer() const;
+
+        DirtyRangeSet const& getDirtyRanges() const;
+
+        /**
+         * \brief Returns the accumulated number of dirty bytes over all flushes.
+         */
+        std::uint64_t getDirtiedByteSize() const;
+
+        /**
+         * \brief Returns the accumulated number of uploaded bytes (dirty bytes plus merged gaps) over all flushes.
+         */
+        std::uint64_t getUploadedByteSize() const;
+
+        /**
+         * \brief Returns the accumulated number of upload calls (or flushed mapped ranges) over all flushes.
+         */
+        std::uint64_t getUploadCount() const;
+
+        void resetStatistics();
+
+    private:
+        BufferObject         m_buffer;
+        std::vector<GLubyte> m_shadow;
+        DirtyRangeSet        m_dirty_ranges;
+        GLsizeiptr           m_merge_gap;
+
+        std::uint64_t m_dirtied_byte_size;
+        std::uint64_t m_uploaded_byte_size;
+        std::uint64_t m_upload_cnt;
+    };
+
+    inline void DirtyRangeSet::add(GLintptr byte_offset, GLsizeiptr byte_size)
+    {
+        if (byte_size <= 0)
+        {
+            return;
+        }
+
+        GLintptr begin = byte_offset;
+        GLintptr end = byte_offset + byte_size;
+
+        // start with the last range beginning at or before the new one, if it touches the new range
+        auto it = m_ranges.upper_bound(begin);
+        if (it != m_ranges.begin())
+        {
+            auto prev = std::prev(it);
+            if (prev->second >= begin)
+            {
+                it = prev;
+            }
+        }
+
+        // absorb all touching ranges
+        while (it != m_ranges.end() && it->first <= end)
+        {
+            begin = std::min(begin, it->first);
+            end = std::max(end, it->second);
+            m_byte_size -= it->second - it->first;
+            it = m_ranges.erase(it);
+        }
+
+        m_ranges.emplace(begin, end);
+        m_byte_size += end - begin;
+    }
+
+    inline std::vector<DirtyRangeSet::Range> DirtyRangeSet::coalesce(GLsizeiptr gap_threshold) const
+    {
+        std::vector<Range> retval;
+
+        for (auto const& range : m_ranges)
+        {
+            if (!retval.empty() && (range.first - retval.back().end) <= gap_threshold)
+            {
+                retval.back().end = range.second;
+            }
+            else
+            {
+                retval.push_back({range.first, range.second});
+            }
+        }
+
+        return retval;
+    }
+
+    inline GLsizeiptr DirtyRangeSet::getByteSize() const
+    {
+        return m_byte_size;
+    }
+
+    inline std::size_t DirtyRangeSet::getRangeCount() const
+    {
+        return m_ranges.size();
+    }
+
+    inline bool DirtyRangeSet::empty() const
+    {
+        return m_ranges.empty();
+    }
+
+    inline void DirtyRangeSet::clear()
+    {
+        m_ranges.clear();
+        m_byte_size = 0;
+    }
+
+    template<typename Container>
+    inline ShadowedBufferObject::ShadowedBufferObject(GLenum           target,
+                                                      Container const& datastorage,
+                                                      GLenum           usage,
+                                                      GLsizeiptr       merge_gap)
+        : ShadowedBufferObject(target,
+                               datastorage.data(),
+                               static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type)),
+                               usage,
+                               merge_gap)
+    {
+    }
+
+    inline ShadowedBufferObject::ShadowedBufferObject(GLenum        target,
+                                                      GLvoid const* data,
+                                                      GLsizeiptr    byte_size,
+                                                      GLenum        usage,
+                                                      GLsizeiptr    merge_gap)
+        : m_buffer(target, data, byte_size, usage),
+          m_shadow(static_cast<std::size_t>(byte_size)),
+          m_dirty_ranges(),
+          m_merge_gap(merge_gap),
+          m_dirtied_byte_size(0),
+          m_uploaded_byte_size(0),
+          m_upload_cnt(0)
+    {
+        if (data != nullptr && byte_size > 0)
+        {
+            std::memcpy(m_shadow.data(), data, static_cast<std::size_t>(byte_size));
+        }
+    }
+
+    inline void ShadowedBufferObject::write(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr byte_offset)
+    {
+        if (byte_size < 0 || byte_offset < 0)
+        {
+            throw BufferObjectException("ShadowedBufferObject::write - negative byte size or offset");
+        }
+
+        std::memcpy(modify<GLubyte>(byte_offset, static_cast<std::size_t>(byte_size)),
+                    data,
+                    static_cast<std::size_t>(byte_size));
+    }
+
+    template<typename T>
+    inline T* ShadowedBufferObject::modify(GLsizeiptr byte_offset, std::size_t count)
+    {
+        // compare element counts, count * sizeof(T) might overflow
+        if (byte_offset < 0 || static_cast<std::size_t>(byte_offset) > m_shadow.size() ||
+            count > (m_shadow.size() - static_cast<std::size_t>(byte_offset)) / sizeof(T))
+        {
+            throw BufferObjectException("ShadowedBufferObject::modify - given range out of buffer bounds");
+        }
+
+        GLsizeiptr byte_size = static_cast<GLsizeiptr>(count * sizeof(T));
+
+        m_dirty_ranges.add(byte_offset, byte_size);
+
+        return reinterpret_cast<T*>(m_shadow.data() + byte_offset);
+    }
+
+    inline void ShadowedBufferObject::flush(FlushMode mode)
+    {
+        if (m_dirty_ranges.empty())
+        {
+            return;
+        }
+
+        auto ranges = m_dirty_ranges.coalesce(m_merge_gap);
+
+        m_dirtied_byte_size += m_dirty_ranges.getByteSize();
+        for (auto const& range : ranges)
+        {
+            m_uploaded_byte_size += range.end - range.begin;
+        }
+        m_upload_cnt += ranges.size();
+
+        if (mode == FlushMode::Mapped && ranges.size() > 1)
+        {
+            GLintptr span_begin = ranges.front().begin;
+            GLintptr span_end = ranges.back().end;
+
+            auto mapped = m_buffer.mapRange<GLubyte>(span_begin,
+                                                     span_end - span_begin,
+                                                     GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+            for (auto const& range : ranges)
+            {
+                std::size_t first = static_cast<std::size_t>(range.begin - span_begin);
+                std::size_t count = static_cast<std::size_t>(range.end - range.begin);
+
+                std::memcpy(mapped.data() + first, m_shadow.data() + range.begin, count);
+                mapped.flush(first, count);
+            }
+        }
+        else
+        {
+            for (auto const& range : ranges)
+            {
+                m_buffer.bufferSubData(m_shadow.data() + range.begin, range.end - range.begin, range.begin);
+            }
+        }
+
+        m_dirty_ranges.clear();
+    }
+
+    inline void ShadowedBufferObject::setMergeGap(GLsizeiptr merge_gap)
+    {
+        m_merge_gap = merge_gap;
+    }
+
+    inline GLsizeiptr ShadowedBufferObject::getMergeGap() const
+    {
+        return m_merge_gap;
+    }
+
+    inline GLubyte const* ShadowedBufferObject::getShadowData() const
+    {
+        return m_shadow.data();
+    }
+
+    inline BufferObject const& ShadowedBufferObject::getBuffer() const
+    {
+        return m_buffer;
+    }
+
+    inline DirtyRangeSet const& ShadowedBufferObject::getDirtyRanges() const
+    {
+        return m_dirty_ranges;
+    }
+
+    inline std::uint64_t ShadowedBufferObject::getDirtiedByteSize() const
+    {
+        return m_dirtied_byte_size;
+    }
+
+    inline std::uint64_t ShadowedBufferObject::getUploadedByteSize() const
+    {
+        return m_uploaded_byte_size;
+    }
+
+    inline std::uint64_t ShadowedBufferObject::getUploadCount() const
+    {
+        return m_upload_cnt;
+    }
+
+    inline void ShadowedBufferObject::resetStatistics()
+    {
+        m_dirtied_byte_size = 0;
+        m_uploaded_byte_size = 0;
+        m_upload_cnt = 0;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_SHADOWEDBUFFEROBJECT_HPP
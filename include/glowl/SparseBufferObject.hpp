@@ -0,0 +1,354 @@
+/*
+ * SparseBufferObject.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_SPARSEBUFFEROBJECT_HPP
+#define GLOWL_SPARSEBUFFEROBJECT_HPP
+
+#ifdef GLOWL_USE_ARB_SPARSE_BUFFER
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "NamePool.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class SparseBufferObject
+     *
+     * \brief OpenGL buffer object with sparse storage (ARB_sparse_buffer).
+     *
+     * The buffer reserves a large virtual address range, physical memory is only committed for the pages that are
+     * made resident via commit(). Residency is tracked per page, so committing or decommitting ranges that are
+     * (partially) resident already only issues calls for the pages that actually change.
+     *
+     * Requires GLOWL_USE_ARB_SPARSE_BUFFER to be defined (see CMake option of the same name).
+     *
+     * \author Michael Becher
+     */
+    class SparseBufferObject
+    {
+    public:
+        /**
+         * \brief SparseBufferObject constructor.
+         *
+         * \param virtual_byte_size Size of the virtual address range, rounded up to a multiple of the page size
+         * \param flags Additional storage flags, GL_SPARSE_STORAGE_BIT_ARB is always added.
+         * Uploads via bufferSubData require GL_DYNAMIC_STORAGE_BIT.
+         * \param name_pool Optional buffer name pool, has to outlive the buffer object
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        SparseBufferObject(GLsizeiptr virtual_byte_size,
+                           GLbitfield flags = GL_DYNAMIC_STORAGE_BIT,
+                           NamePool*  name_pool = nullptr);
+
+        ~SparseBufferObject();
+
+        SparseBufferObject(const SparseBufferObject&) = delete;
+        SparseBufferObject& operator=(const SparseBufferObject&) = delete;
+
+        SparseBufferObject(SparseBufferObject&& other) noexcept;
+        SparseBufferObject& operator=(SparseBufferObject&& rhs) noexcept;
+
+        /**
+         * \brief Returns the implementation's sparse buffer page size.
+         */
+        static GLsizeiptr queryPageSize();
+
+        /**
+         * \brief Make the given range resident. byte_offset has to be page aligned, byte_size has to be a multiple
+         * of the page size or reach the end of the buffer.
+         */
+        void commit(GLintptr byte_offset, GLsizeiptr byte_size);
+
+        /**
+         * \brief Release the physical memory of the given range. Same alignment rules as commit().
+         */
+        void decommit(GLintptr byte_offset, GLsizeiptr byte_size);
+
+        void decommitAll();
+
+        /**
+         * \brief Returns true if all pages overlapping the given range are resident.
+         */
+        bool isResident(GLintptr byte_offset, GLsizeiptr byte_size) const;
+
+        /**
+         * \brief Upload data to a resident range of the buffer.
+         */
+        void bufferSubData(GLvoid const* data, GLsizeiptr byte_size, GLintptr byte_offset) const;
+
+        void bind(GLenum target) const;
+
+        void bindBase(GLenum target, GLuint index) const;
+
+        void bindRange(GLenum target, GLuint index, GLintptr byte_offset, GLsizeiptr byte_size) const;
+
+        GLuint getName() const;
+
+        /**
+         * \brief Returns the size of the virtual address range.
+         */
+        GLsizeiptr getByteSize() const;
+
+        GLsizeiptr getPageSize() const;
+
+        std::size_t getPageCount() const;
+
+        std::size_t getResidentPageCount() const;
+
+        GLsizeiptr getResidentByteSize() const;
+
+    private:
+        /**
+         * \brief Change the residency of all pages in the range, issuing one call per run of changing pages.
+         */
+        void setResidency(GLintptr byte_offset, GLsizeiptr byte_size, bool resident);
+
+        GLuint            m_name;
+        GLsizeiptr        m_byte_size;
+        GLsizeiptr        m_page_size;
+        std::vector<bool> m_resident_pages;
+        std::size_t       m_resident_page_cnt;
+        NamePool*         m_name_pool;
+    };
+
+    inline SparseBufferObject::SparseBufferObject(GLsizeiptr virtual_byte_size, GLbitfield flags, NamePool* name_pool)
+        : m_name(0),
+          m_byte_size(0),
+          m_page_size(queryPageSize()),
+          m_resident_pages(),
+          m_resident_page_cnt(0),
+          m_name_pool(name_pool)
+    {
+        if (m_page_size <= 0)
+        {
+            throw BufferObjectException("SparseBufferObject::SparseBufferObject - sparse buffers not supported");
+        }
+        if (virtual_byte_size <= 0)
+        {
+            throw BufferObjectException("SparseBufferObject::SparseBufferObject - invalid virtual byte size");
+        }
+
+        std::size_t page_cnt = static_cast<std::size_t>((virtual_byte_size + m_page_size - 1) / m_page_size);
+        m_byte_size = static_cast<GLsizeiptr>(page_cnt) * m_page_size;
+        m_resident_pages.resize(page_cnt, false);
+
+        m_name = acquireName(m_name_pool, NamePool::Type::Buffer);
+        glNamedBufferStorage(m_name, m_byte_size, nullptr, flags | GL_SPARSE_STORAGE_BIT_ARB);
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            releaseName(m_name_pool, NamePool::Type::Buffer, m_name, false);
+            throw BufferObjectException("SparseBufferObject::SparseBufferObject - OpenGL error " +
+                                        std::to_string(err));
+        }
+    }
+
+    inline SparseBufferObject::~SparseBufferObject()
+    {
+        // deleting the buffer releases all committed pages
+        releaseName(m_name_pool, NamePool::Type::Buffer, m_name, false);
+    }
+
+    inline SparseBufferObject::SparseBufferObject(SparseBufferObject&& other) noexcept
+        : m_name(std::exchange(other.m_name, 0)),
+          m_byte_size(std::exchange(other.m_byte_size, 0)),
+          m_page_size(other.m_page_size),
+          m_resident_pages(std::move(other.m_resident_pages)),
+          m_resident_page_cnt(std::exchange(other.m_resident_page_cnt, 0)),
+          m_name_pool(other.m_name_pool)
+    {
+    }
+
+    inline SparseBufferObject& SparseBufferObject::operator=(SparseBufferObject&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Buffer, m_name, false);
+            m_name = std::exchange(rhs.m_name, 0);
+            m_byte_size = std::exchange(rhs.m_byte_size, 0);
+            m_page_size = rhs.m_page_size;
+            m_resident_pages = std::move(rhs.m_resident_pages);
+            m_resident_page_cnt = std::exchange(rhs.m_resident_page_cnt, 0);
+            m_name_pool = rhs.m_name_pool;
+        }
+        return *this;
+    }
+
+    inline GLsizeiptr SparseBufferObject::queryPageSize()
+    {
+        GLint page_size = 0;
+        glGetIntegerv(GL_SPARSE_BUFFER_PAGE_SIZE_ARB, &page_size);
+        return static_cast<GLsizeiptr>(page_size);
+    }
+
+    inline void SparseBufferObject::commit(GLintptr byte_offset, GLsizeiptr byte_size)
+    {
+        setResidency(byte_offset, byte_size, true);
+    }
+
+    inline void SparseBufferObject::decommit(GLintptr byte_offset, GLsizeiptr byte_size)
+    {
+        setResidency(byte_offset, byte_size, false);
+    }
+
+    inline void SparseBufferObject::decommitAll()
+    {
+        setResidency(0, m_byte_size, false);
+    }
+
+    inline bool SparseBufferObject::isResident(GLintptr byte_offset, GLsizeiptr byte_size) const
+    {
+        if (byte_offset < 0 || byte_size <= 0 || (byte_offset + byte_size) > m_byte_size)
+        {
+            return false;
+        }
+
+        std::size_t first_page = static_cast<std::size_t>(byte_offset / m_page_size);
+        std::size_t last_page = static_cast<std::size_t>((byte_offset + byte_size - 1) / m_page_size);
+        for (std::size_t page = first_page; page <= last_page; ++page)
+        {
+            if (!m_resident_pages[page])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline void SparseBufferObject::bufferSubData(GLvoid const* data, GLsizeiptr byte_size, GLintptr byte_offset) const
+    {
+        if (!isResident(byte_offset, byte_size))
+        {
+            throw BufferObjectException("SparseBufferObject::bufferSubData - given range is not resident");
+        }
+
+        glNamedBufferSubData(m_name, byte_offset, byte_size, data);
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException("SparseBufferObject::bufferSubData - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline void SparseBufferObject::bind(GLenum target) const
+    {
+        glBindBuffer(target, m_name);
+    }
+
+    inline void SparseBufferObject::bindBase(GLenum target, GLuint index) const
+    {
+        glBindBufferBase(target, index, m_name);
+    }
+
+    inline void SparseBufferObject::bindRange(GLenum     target,
+                                              GLuint     index,
+                                              GLintptr   byte_offset,
+                                              GLsizeiptr byte_size) const
+    {
+        glBindBufferRange(target, index, m_name, byte_offset, byte_size);
+    }
+
+    inline GLuint SparseBufferObject::getName() const
+    {
+        return m_name;
+    }
+
+    inline GLsizeiptr SparseBufferObject::getByteSize() const
+    {
+        return m_byte_size;
+    }
+
+    inline GLsizeiptr SparseBufferObject::getPageSize() const
+    {
+        return m_page_size;
+    }
+
+    inline std::size_t SparseBufferObject::getPageCount() const
+    {
+        return m_resident_pages.size();
+    }
+
+    inline std::size_t SparseBufferObject::getResidentPageCount() const
+    {
+        return m_resident_page_cnt;
+    }
+
+    inline GLsizeiptr SparseBufferObject::getResidentByteSize() const
+    {
+        return static_cast<GLsizeiptr>(m_resident_page_cnt) * m_page_size;
+    }
+
+    inline void SparseBufferObject::setResidency(GLintptr byte_offset, GLsizeiptr byte_size, bool resident)
+    {
+        if (byte_offset < 0 || byte_size <= 0 || (byte_offset + byte_size) > m_byte_size)
+        {
+            throw BufferObjectException("SparseBufferObject::setResidency - given range out of buffer bounds");
+        }
+        if ((byte_offset % m_page_size) != 0 ||
+            ((byte_size % m_page_size) != 0 && (byte_offset + byte_size) != m_byte_size))
+        {
+            throw BufferObjectException("SparseBufferObject::setResidency - given range is not page aligned");
+        }
+
+        std::size_t first_page = static_cast<std::size_t>(byte_offset / m_page_size);
+        std::size_t end_page = static_cast<std::size_t>((byte_offset + byte_size + m_page_size - 1) / m_page_size);
+
+        std::size_t page = first_page;
+        while (page < end_page)
+        {
+            // skip pages that already have the requested residency
+            if (m_resident_pages[page] == resident)
+            {
+                ++page;
+                continue;
+            }
+
+            std::size_t run_begin = page;
+            while (page < end_page && m_resident_pages[page] != resident)
+            {
+                m_resident_pages[page] = resident;
+                ++page;
+            }
+
+            glNamedBufferPageCommitmentARB(m_name,
+                                           static_cast<GLintptr>(run_begin) * m_page_size,
+                                           static_cast<GLsizeiptr>(page - run_begin) * m_page_size,
+                                           resident ? GL_TRUE : GL_FALSE);
+
+            if (resident)
+            {
+                m_resident_page_cnt += page - run_begin;
+            }
+            else
+            {
+                m_resident_page_cnt -= page - run_begin;
+            }
+        }
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException("SparseBufferObject::setResidency - OpenGL error " + std::to_string(err));
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_USE_ARB_SPARSE_BUFFER
+
+#endif // GLOWL_SPARSEBUFFEROBJECT_HPP
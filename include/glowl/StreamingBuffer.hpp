@@ -0,0 +1,384 @@
+/*
+ * StreamingBuffer.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_STREAMINGBUFFER_HPP
+#define GLOWL_STREAMINGBUFFER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "ImmutableBufferObject.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class StreamingBuffer
+     *
+     * \brief Persistently mapped ring buffer for per-frame data uploads.
+     *
+     * The storage is split into a number of equally sized frame regions. Each region is guarded by a fence that is
+     * inserted at the end of the frame that wrote to it. Before a region is reused, the fence is checked and the CPU
+     * only waits if the GPU is still reading from it (counted as stall). If stalls occur regularly, increase the
+     * region count.
+     *
+     * Usage:
+     *   buffer.beginFrame();
+     *   auto alloc = buffer.write(instance_data, buffer.getOffsetAlignment(GL_SHADER_STORAGE_BUFFER));
+     *   buffer.bindRange(GL_SHADER_STORAGE_BUFFER, 0, alloc);
+     *   ... draw ...
+     *   buffer.endFrame();
+     *
+     * Data written through allocate() instead of write() has to be passed to flush() before it is used by the GPU.
+     *
+     * \author Michael Becher
+     */
+    class StreamingBuffer
+    {
+    public:
+        struct Allocation
+        {
+            GLvoid*    data;        ///< Mapped write pointer
+            GLintptr   byte_offset; ///< Byte offset within the whole buffer, e.g. for glBindBufferRange
+            GLsizeiptr byte_size;
+        };
+
+        /**
+         * \brief StreamingBuffer constructor.
+         *
+         * \param region_byte_size Byte size available per frame
+         * \param region_cnt Number of frame regions, i.e. frames that can be in flight
+         * \param coherent Use coherent mapping. Otherwise written ranges are flushed explicitly, see flush().
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        StreamingBuffer(GLsizeiptr region_byte_size, GLuint region_cnt = 3, bool coherent = true);
+
+        ~StreamingBuffer();
+
+        StreamingBuffer(const StreamingBuffer&) = delete;
+        StreamingBuffer(StreamingBuffer&& other) noexcept;
+        StreamingBuffer& operator=(StreamingBuffer&& rhs) noexcept;
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+        /**
+         * \brief Start writing to the current frame region. Waits for the GPU if the region is still in use.
+         */
+        void beginFrame();
+
+        /**
+         * \brief Finish writing to the current frame region, fence it and advance to the next region.
+         */
+        void endFrame();
+
+        /**
+         * \brief Reserve byte_size bytes within the current frame region.
+         * Call flush() after writing to the allocation and before issuing commands that read it.
+         *
+         * \param alignment Required alignment of the byte offset, see getOffsetAlignment()
+         */
+        Allocation allocate(GLsizeiptr byte_size, GLsizeiptr alignment = 1);
+
+        /**
+         * \brief Make CPU writes to an allocation visible to subsequent GL commands.
+         * No-op for coherent mappings. write() flushes its allocation itself.
+         */
+        void flush(Allocation const& allocation) const;
+
+        template<typename Container>
+        Allocation write(Container const& datastorage, GLsizeiptr alignment = 1);
+
+        Allocation write(GLvoid const* data, GLsizeiptr byte_size, GLsizeiptr alignment = 1);
+
+        void bindRange(GLenum target, GLuint index, Allocation const& allocation) const;
+
+        /**
+         * \brief Returns the minimal offset alignment required for binding ranges to the given target.
+         */
+        GLsizeiptr getOffsetAlignment(GLenum target) const;
+
+        GLuint getName() const;
+
+        GLsizeiptr getRegionByteSize() const;
+
+        GLuint getRegionCount() const;
+
+        /**
+         * \brief Returns the number of bytes still available in the current frame region.
+         */
+        GLsizeiptr getAvailableByteSize() const;
+
+        /**
+         * \brief Returns how often beginFrame() had to wait for the GPU to release a region.
+         */
+        std::uint64_t getStallCount() const;
+
+        std::uint64_t getFrameCount() const;
+
+    private:
+        /**
+         * \brief Delete pending fences and unmap the buffer.
+         */
+        void release();
+
+        ImmutableBufferObject m_buffer;
+        GLubyte*              m_mapped_data;
+
+        GLsizeiptr m_region_byte_size;
+        GLuint     m_region_cnt;
+        GLuint     m_current_region;
+        GLsizeiptr m_region_head;
+        bool       m_coherent;
+
+        std::vector<GLsync> m_fences;
+
+        GLsizeiptr m_uniform_alignment;
+        GLsizeiptr m_storage_alignment;
+
+        std::uint64_t m_stall_cnt;
+        std::uint64_t m_frame_cnt;
+    };
+
+    inline StreamingBuffer::StreamingBuffer(GLsizeiptr region_byte_size, GLuint region_cnt, bool coherent)
+        : m_buffer(nullptr,
+                   region_byte_size * region_cnt,
+                   GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | (coherent ? GL_MAP_COHERENT_BIT : 0)),
+          m_mapped_data(nullptr),
+          m_region_byte_size(region_byte_size),
+          m_region_cnt(region_cnt),
+          m_current_region(0),
+          m_region_head(0),
+          m_coherent(coherent),
+          m_fences(region_cnt, nullptr),
+          m_uniform_alignment(1),
+          m_storage_alignment(1),
+          m_stall_cnt(0),
+          m_frame_cnt(0)
+    {
+        if (region_cnt == 0)
+        {
+            throw BufferObjectException("StreamingBuffer::StreamingBuffer - region count must not be zero");
+        }
+
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+        access |= coherent ? GL_MAP_COHERENT_BIT : GL_MAP_FLUSH_EXPLICIT_BIT;
+        m_mapped_data =
+            static_cast<GLubyte*>(glMapNamedBufferRange(m_buffer.getName(), 0, m_buffer.getByteSize(), access));
+
+        GLint alignment = 1;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        m_uniform_alignment = alignment;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        m_storage_alignment = alignment;
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR || m_mapped_data == nullptr)
+        {
+            throw BufferObjectException("StreamingBuffer::StreamingBuffer - OpenGL error " + std::to_string(err));
+        }
+    }
+
+    inline StreamingBuffer::~StreamingBuffer()
+    {
+        release();
+    }
+
+    inline StreamingBuffer::StreamingBuffer(StreamingBuffer&& other) noexcept
+        : m_buffer(std::move(other.m_buffer)),
+          m_mapped_data(std::exchange(other.m_mapped_data, nullptr)),
+          m_region_byte_size(other.m_region_byte_size),
+          m_region_cnt(other.m_region_cnt),
+          m_current_region(other.m_current_region),
+          m_region_head(other.m_region_head),
+          m_coherent(other.m_coherent),
+          m_fences(std::exchange(other.m_fences, {})),
+          m_uniform_alignment(other.m_uniform_alignment),
+          m_storage_alignment(other.m_storage_alignment),
+          m_stall_cnt(other.m_stall_cnt),
+          m_frame_cnt(other.m_frame_cnt)
+    {
+    }
+
+    inline StreamingBuffer& StreamingBuffer::operator=(StreamingBuffer&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            m_buffer = std::move(rhs.m_buffer);
+            m_mapped_data = std::exchange(rhs.m_mapped_data, nullptr);
+            m_region_byte_size = rhs.m_region_byte_size;
+            m_region_cnt = rhs.m_region_cnt;
+            m_current_region = rhs.m_current_region;
+            m_region_head = rhs.m_region_head;
+            m_coherent = rhs.m_coherent;
+            m_fences = std::exchange(rhs.m_fences, {});
+            m_uniform_alignment = rhs.m_uniform_alignment;
+            m_storage_alignment = rhs.m_storage_alignment;
+            m_stall_cnt = rhs.m_stall_cnt;
+            m_frame_cnt = rhs.m_frame_cnt;
+        }
+        return *this;
+    }
+
+    inline void StreamingBuffer::beginFrame()
+    {
+        GLsync& fence = m_fences[m_current_region];
+
+        if (fence != nullptr)
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                ++m_stall_cnt;
+                do
+                {
+                    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+                } while (result == GL_TIMEOUT_EXPIRED);
+            }
+
+            glDeleteSync(fence);
+            fence = nullptr;
+
+            if (result == GL_WAIT_FAILED)
+            {
+                throw BufferObjectException("StreamingBuffer::beginFrame - waiting for fence failed");
+            }
+        }
+
+        m_region_head = 0;
+    }
+
+    inline void StreamingBuffer::endFrame()
+    {
+        m_fences[m_current_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        m_current_region = (m_current_region + 1) % m_region_cnt;
+        m_region_head = 0;
+        ++m_frame_cnt;
+    }
+
+    inline StreamingBuffer::Allocation StreamingBuffer::allocate(GLsizeiptr byte_size, GLsizeiptr alignment)
+    {
+        GLintptr region_offset = m_current_region * m_region_byte_size;
+        GLintptr offset = region_offset + m_region_head;
+
+        if (alignment > 1 && (offset % alignment) != 0)
+        {
+            offset += alignment - (offset % alignment);
+        }
+
+        if ((offset + byte_size) > (region_offset + m_region_byte_size))
+        {
+            throw BufferObjectException("StreamingBuffer::allocate - frame region exhausted");
+        }
+
+        m_region_head = (offset + byte_size) - region_offset;
+
+        return {m_mapped_data + offset, offset, byte_size};
+    }
+
+    inline void StreamingBuffer::flush(Allocation const& allocation) const
+    {
+        if (!m_coherent && allocation.byte_size > 0)
+        {
+            glFlushMappedNamedBufferRange(m_buffer.getName(), allocation.byte_offset, allocation.byte_size);
+        }
+    }
+
+    template<typename Container>
+    inline StreamingBuffer::Allocation StreamingBuffer::write(Container const& datastorage, GLsizeiptr alignment)
+    {
+        return write(datastorage.data(),
+                     static_cast<GLsizeiptr>(datastorage.size() * sizeof(typename Container::value_type)),
+                     alignment);
+    }
+
+    inline StreamingBuffer::Allocation StreamingBuffer::write(GLvoid const* data,
+                                                              GLsizeiptr    byte_size,
+                                                              GLsizeiptr    alignment)
+    {
+        auto allocation = allocate(byte_size, alignment);
+        std::memcpy(allocation.data, data, byte_size);
+        flush(allocation);
+        return allocation;
+    }
+
+    inline void StreamingBuffer::bindRange(GLenum target, GLuint index, Allocation const& allocation) const
+    {
+        glBindBufferRange(target, index, m_buffer.getName(), allocation.byte_offset, allocation.byte_size);
+    }
+
+    inline GLsizeiptr StreamingBuffer::getOffsetAlignment(GLenum target) const
+    {
+        switch (target)
+        {
+        case GL_UNIFORM_BUFFER:
+            return m_uniform_alignment;
+        case GL_SHADER_STORAGE_BUFFER:
+            return m_storage_alignment;
+        default:
+            return 1;
+        }
+    }
+
+    inline GLuint StreamingBuffer::getName() const
+    {
+        return m_buffer.getName();
+    }
+
+    inline GLsizeiptr StreamingBuffer::getRegionByteSize() const
+    {
+        return m_region_byte_size;
+    }
+
+    inline GLuint StreamingBuffer::getRegionCount() const
+    {
+        return m_region_cnt;
+    }
+
+    inline GLsizeiptr StreamingBuffer::getAvailableByteSize() const
+    {
+        return m_region_byte_size - m_region_head;
+    }
+
+    inline std::uint64_t StreamingBuffer::getStallCount() const
+    {
+        return m_stall_cnt;
+    }
+
+    inline std::uint64_t StreamingBuffer::getFrameCount() const
+    {
+        return m_frame_cnt;
+    }
+
+    inline void StreamingBuffer::release()
+    {
+        for (auto fence : m_fences)
+        {
+            if (fence != nullptr)
+            {
+                glDeleteSync(fence);
+            }
+        }
+        m_fences.clear();
+
+        if (m_mapped_data != nullptr)
+        {
+            glUnmapNamedBuffer(m_buffer.getName());
+            m_mapped_data = nullptr;
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_STREAMINGBUFFER_HPP
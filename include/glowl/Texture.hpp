@@ -10,8 +10,10 @@
 
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "NamePool.hpp"
 #include "glinclude.h"
 
 namespace glowl
@@ -133,18 +135,61 @@ namespace glowl
 
         GLsizei m_levels;
 
+        NamePool* m_name_pool; ///< Optional texture name pool, see NamePool
+
+        /**
+         * \brief Takes over the texture name, the moved-from texture is left with name 0.
+         * Deleting the previously owned texture on assignment is left to the derived classes.
+         */
+        Texture(Texture&& other) noexcept
+            : m_id(std::move(other.m_id)),
+              m_name(std::exchange(other.m_name, 0)),
+#ifndef GLOWL_NO_ARB_BINDLESS_TEXTURE
+              m_texture_handle(std::exchange(other.m_texture_handle, std::nullopt)),
+#endif
+              m_internal_format(other.m_internal_format),
+              m_format(other.m_format),
+              m_type(other.m_type),
+              m_levels(other.m_levels),
+              m_name_pool(other.m_name_pool)
+        {
+        }
+
+        Texture& operator=(Texture&& rhs) noexcept
+        {
+            m_id = std::move(rhs.m_id);
+            m_name = std::exchange(rhs.m_name, 0);
+#ifndef GLOWL_NO_ARB_BINDLESS_TEXTURE
+            m_texture_handle = std::exchange(rhs.m_texture_handle, std::nullopt);
+#endif
+            m_internal_format = rhs.m_internal_format;
+            m_format = rhs.m_format;
+            m_type = rhs.m_type;
+            m_levels = rhs.m_levels;
+            m_name_pool = rhs.m_name_pool;
+            return *this;
+        }
+
         // TODO: Store texture parameters as well ?
     public:
-        Texture(std::string id, GLint internal_format, GLenum format, GLenum type, GLsizei levels)
+        Texture(std::string id,
+                GLint       internal_format,
+                GLenum      format,
+                GLenum      type,
+                GLsizei     levels,
+                NamePool*   name_pool = nullptr)
             : m_id(id),
+              m_name(0),
               m_internal_format(internal_format),
               m_format(format),
               m_type(type),
-              m_levels(levels)
+              m_levels(levels),
+              m_name_pool(name_pool)
         {
         }
         virtual ~Texture() {}
         Texture(const Texture&) = delete;
+        Texture& operator=(const Texture&) = delete;
 
         virtual void bindTexture() const = 0;
 
@@ -42,11 +42,12 @@ namespace glowl
                   TextureLayout const& layout,
                   GLvoid const*        data,
                   bool                 generateMipmap = false,
-                  bool                 customLevels = false);
+                  bool                 customLevels = false,
+                  NamePool*            name_pool = nullptr);
         Texture2D(const Texture2D&) = delete;
-        Texture2D(Texture2D&& other) = delete;
+        Texture2D(Texture2D&& other) noexcept;
         Texture2D& operator=(const Texture2D& rhs) = delete;
-        Texture2D& operator=(Texture2D&& rhs) = delete;
+        Texture2D& operator=(Texture2D&& rhs) noexcept;
         ~Texture2D();
 
         /**
@@ -95,12 +96,13 @@ namespace glowl
                                 TextureLayout const& layout,
                                 GLvoid const*        data,
                                 bool                 generateMipmap,
-                                bool                 customLevels)
-        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels),
+                                bool                 customLevels,
+                                NamePool*            name_pool)
+        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels, name_pool),
           m_width(layout.width),
           m_height(layout.height)
     {
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_2D);
 
         for (auto& pname_pvalue : layout.int_parameters)
         {
@@ -139,7 +141,26 @@ namespace glowl
 
     inline Texture2D::~Texture2D()
     {
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+    }
+
+    inline Texture2D::Texture2D(Texture2D&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height)
+    {
+    }
+
+    inline Texture2D& Texture2D::operator=(Texture2D&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+        }
+        return *this;
     }
 
     inline void Texture2D::bindTexture() const
@@ -192,9 +213,9 @@ namespace glowl
         m_type = layout.type;
         m_levels = layout.levels;
 
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_2D);
 
         for (auto& pname_pvalue : layout.int_parameters)
         {
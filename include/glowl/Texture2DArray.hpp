@@ -36,12 +36,13 @@ namespace glowl
                        TextureLayout const& layout,
                        GLvoid const*        data,
                        bool                 generateMipmap = false,
-                       bool                 customLevels = false);
+                       bool                 customLevels = false,
+                       NamePool*            name_pool = nullptr);
         Texture2DArray(const Texture2DArray&) =
             delete; // TODO: think of meaningful copy operation...maybe copy texture content to new texture object?
-        Texture2DArray(Texture2DArray&& other) = delete;
+        Texture2DArray(Texture2DArray&& other) noexcept;
         Texture2DArray& operator=(const Texture2DArray& rhs) = delete;
-        Texture2DArray& operator=(Texture2DArray&& rhs) = delete;
+        Texture2DArray& operator=(Texture2DArray&& rhs) noexcept;
         ~Texture2DArray();
 
         void bindTexture() const;
@@ -76,13 +77,14 @@ namespace glowl
                                           TextureLayout const& layout,
                                           GLvoid const*        data,
                                           bool                 generateMipmap,
-                                          bool                 customLevels)
-        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels),
+                                          bool                 customLevels,
+                                          NamePool*            name_pool)
+        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels, name_pool),
           m_width(layout.width),
           m_height(layout.height),
           m_layers(layout.depth)
     {
-        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_2D_ARRAY);
 
         for (auto& pname_pvalue : layout.int_parameters)
         {
@@ -122,7 +124,28 @@ namespace glowl
 
     inline Texture2DArray::~Texture2DArray()
     {
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+    }
+
+    inline Texture2DArray::Texture2DArray(Texture2DArray&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_layers(other.m_layers)
+    {
+    }
+
+    inline Texture2DArray& Texture2DArray::operator=(Texture2DArray&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_layers = rhs.m_layers;
+        }
+        return *this;
     }
 
     inline void Texture2DArray::bindTexture() const
@@ -148,9 +171,9 @@ namespace glowl
         m_levels = layout.levels;
         m_type = layout.type;
 
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
 
-        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_2D_ARRAY);
 
         for (auto& pname_pvalue : layout.int_parameters)
             glTextureParameteri(m_name, pname_pvalue.first, pname_pvalue.second);
@@ -41,6 +41,10 @@ namespace glowl
                       GLuint               minlayer,
                       GLuint               numlayers);
         ~Texture2DView();
+        Texture2DView(const Texture2DView&) = delete;
+        Texture2DView(Texture2DView&& other) noexcept;
+        Texture2DView& operator=(const Texture2DView& rhs) = delete;
+        Texture2DView& operator=(Texture2DView&& rhs) noexcept;
 
         void bindTexture() const;
 
@@ -122,6 +126,27 @@ namespace glowl
         glDeleteTextures(1, &m_name);
     }
 
+    inline Texture2DView::Texture2DView(Texture2DView&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_depth(other.m_depth)
+    {
+    }
+
+    inline Texture2DView& Texture2DView::operator=(Texture2DView&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            glDeleteTextures(1, &m_name);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_depth = rhs.m_depth;
+        }
+        return *this;
+    }
+
     inline void Texture2DView::bindTexture() const
     {
         glBindTexture(GL_TEXTURE_2D, m_name);
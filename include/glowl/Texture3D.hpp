@@ -37,11 +37,12 @@ namespace glowl
                   TextureLayout const& layout,
                   GLvoid const*        data,
                   bool                 generateMipmap = false,
-                  bool                 customLevels = false);
+                  bool                 customLevels = false,
+                  NamePool*            name_pool = nullptr);
         Texture3D(const Texture3D&) = delete;
-        Texture3D(Texture3D&& other) = delete;
+        Texture3D(Texture3D&& other) noexcept;
         Texture3D& operator=(const Texture3D& rhs) = delete;
-        Texture3D& operator=(Texture3D&& rhs) = delete;
+        Texture3D& operator=(Texture3D&& rhs) noexcept;
         ~Texture3D();
 
         /**
@@ -76,13 +77,14 @@ namespace glowl
                                 TextureLayout const& layout,
                                 GLvoid const*        data,
                                 bool                 generateMipmap,
-                                bool                 customLevels)
-        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels),
+                                bool                 customLevels,
+                                NamePool*            name_pool)
+        : Texture(id, layout.internal_format, layout.format, layout.type, layout.levels, name_pool),
           m_width(layout.width),
           m_height(layout.height),
           m_depth(layout.depth)
     {
-        glCreateTextures(GL_TEXTURE_3D, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_3D);
 
         for (auto& pname_pvalue : layout.int_parameters)
         {
@@ -121,7 +123,28 @@ namespace glowl
 
     inline Texture3D::~Texture3D()
     {
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+    }
+
+    inline Texture3D::Texture3D(Texture3D&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_depth(other.m_depth)
+    {
+    }
+
+    inline Texture3D& Texture3D::operator=(Texture3D&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_depth = rhs.m_depth;
+        }
+        return *this;
     }
 
     inline void Texture3D::bindTexture() const
@@ -146,9 +169,9 @@ namespace glowl
         m_format = layout.format;
         m_type = layout.type;
 
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
 
-        glCreateTextures(GL_TEXTURE_3D, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_3D);
 
         for (auto& pname_pvalue : layout.int_parameters)
         {
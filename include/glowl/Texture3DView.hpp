@@ -39,6 +39,10 @@ namespace glowl
                       GLuint               minlayer,
                       GLuint               numlayers);
         ~Texture3DView();
+        Texture3DView(const Texture3DView&) = delete;
+        Texture3DView(Texture3DView&& other) noexcept;
+        Texture3DView& operator=(const Texture3DView& rhs) = delete;
+        Texture3DView& operator=(Texture3DView&& rhs) noexcept;
 
         void bindTexture() const;
 
@@ -97,6 +101,27 @@ namespace glowl
         glDeleteTextures(1, &m_name);
     }
 
+    inline Texture3DView::Texture3DView(Texture3DView&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_depth(other.m_depth)
+    {
+    }
+
+    inline Texture3DView& Texture3DView::operator=(Texture3DView&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            glDeleteTextures(1, &m_name);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_depth = rhs.m_depth;
+        }
+        return *this;
+    }
+
     inline void Texture3DView::bindTexture() const
     {
         glBindTexture(GL_TEXTURE_3D, m_name);
@@ -41,12 +41,13 @@ namespace glowl
                             GLenum        type,
                             GLsizei       levels,
                             GLvoid const* data,
-                            bool          generateMipmap = false);
+                            bool          generateMipmap = false,
+                            NamePool*     name_pool = nullptr);
         TextureCubemapArray(const TextureCubemapArray&) =
             delete; // TODO: think of meaningful copy operation...maybe copy texture context to new texture object?
-        TextureCubemapArray(TextureCubemapArray&& other) = delete;
+        TextureCubemapArray(TextureCubemapArray&& other) noexcept;
         TextureCubemapArray& operator=(const TextureCubemapArray& rhs) = delete;
-        TextureCubemapArray& operator=(TextureCubemapArray&& rhs) = delete;
+        TextureCubemapArray& operator=(TextureCubemapArray&& rhs) noexcept;
         ~TextureCubemapArray();
 
         /**
@@ -89,13 +90,14 @@ namespace glowl
                                                     GLenum        type,
                                                     GLsizei       levels,
                                                     GLvoid const* data,
-                                                    bool          generateMipmap)
-        : Texture(id, internal_format, format, type, levels),
+                                                    bool          generateMipmap,
+                                                    NamePool*     name_pool)
+        : Texture(id, internal_format, format, type, levels, name_pool),
           m_width(width),
           m_height(height),
           m_layers(layers)
     {
-        glCreateTextures(GL_TEXTURE_CUBE_MAP_ARRAY, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_CUBE_MAP_ARRAY);
 
         glTextureParameteri(m_name, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTextureParameteri(m_name, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -126,7 +128,28 @@ namespace glowl
 
     inline TextureCubemapArray::~TextureCubemapArray()
     {
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+    }
+
+    inline TextureCubemapArray::TextureCubemapArray(TextureCubemapArray&& other) noexcept
+        : Texture(std::move(other)),
+          m_width(other.m_width),
+          m_height(other.m_height),
+          m_layers(other.m_layers)
+    {
+    }
+
+    inline TextureCubemapArray& TextureCubemapArray::operator=(TextureCubemapArray&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
+            Texture::operator=(std::move(rhs));
+            m_width = rhs.m_width;
+            m_height = rhs.m_height;
+            m_layers = rhs.m_layers;
+        }
+        return *this;
     }
 
     inline void TextureCubemapArray::reload(unsigned int  width,
@@ -139,9 +162,9 @@ namespace glowl
         m_height = height;
         m_layers = layers;
 
-        glDeleteTextures(1, &m_name);
+        releaseName(m_name_pool, NamePool::Type::Texture, m_name, false);
 
-        glCreateTextures(GL_TEXTURE_CUBE_MAP_ARRAY, 1, &m_name);
+        m_name = acquireName(m_name_pool, NamePool::Type::Texture, GL_TEXTURE_CUBE_MAP_ARRAY);
         assert(m_name > 0);
 
         glTextureParameteri(m_name, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -0,0 +1,441 @@
+/*
+ * UniformBlock.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_UNIFORMBLOCK_HPP
+#define GLOWL_UNIFORMBLOCK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Auto detect glm header availability
+#ifndef GLOWL_USE_GLM
+#if __has_include(<glm/glm.hpp>)
+#define GLOWL_USE_GLM 1
+#else
+#define GLOWL_USE_GLM 0
+#endif
+#endif
+
+#if GLOWL_USE_GLM
+#include <glm/glm.hpp>
+#endif
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "ShadowedBufferObject.hpp"
+#include "glinclude.h"
+
+/**
+ * Compile-time check of a single block member against the given BlockLayout, e.g.
+ *   GLOWL_CHECK_BLOCK_MEMBER(glowl::BlockLayout::Std140, Lighting, direction);
+ * Fails if the C++ offset or size of the member differs from the std140/std430 rules.
+ */
+#define GLOWL_CHECK_BLOCK_MEMBER(layout, type, member)                                                  \
+    static_assert(::glowl::isBlockMemberValid<layout, decltype(type::member)>(offsetof(type, member)), \
+                  #type "::" #member " violates the block layout")
+
+namespace glowl
+{
+
+    enum class BlockLayout
+    {
+        Std140,
+        Std430
+    };
+
+    /**
+     * \struct BlockMemberTraits
+     *
+     * \brief Base alignment and size of a block member type according to the std140/std430 layout rules.
+     *
+     * Specialized for scalars, glm vectors and matrices and std::array. Only types whose C++ representation matches
+     * the layout are valid, e.g. glm::mat3 or arrays of float are rejected for std140 since their columns/elements
+     * would have to be padded to 16 bytes. Specialize for nested structs as required.
+     */
+    template<BlockLayout Layout, typename T>
+    struct BlockMemberTraits;
+
+    namespace detail
+    {
+        constexpr std::size_t roundUp(std::size_t value, std::size_t alignment)
+        {
+            return ((value + alignment - 1) / alignment) * alignment;
+        }
+
+        template<typename Scalar>
+        struct BlockScalarTraits
+        {
+            static constexpr std::size_t alignment = sizeof(Scalar);
+            static constexpr std::size_t size = sizeof(Scalar);
+        };
+
+        template<typename Scalar, std::size_t N>
+        struct BlockVectorTraits
+        {
+            static constexpr std::size_t alignment = sizeof(Scalar) * (N == 3 ? 4 : N);
+            static constexpr std::size_t size = sizeof(Scalar) * N;
+        };
+
+        /**
+         * Arrays (and matrix columns) are aligned to 16 bytes in std140, element strides are rounded up to the
+         * alignment in both layouts.
+         */
+        template<BlockLayout Layout, std::size_t ElementAlignment, std::size_t ElementSize, std::size_t N>
+        struct BlockArrayTraits
+        {
+            static constexpr std::size_t alignment =
+                Layout == BlockLayout::Std140 ? roundUp(ElementAlignment, 16) : ElementAlignment;
+            static constexpr std::size_t stride = roundUp(ElementSize, alignment);
+            static constexpr std::size_t size = stride * N;
+        };
+    } // namespace detail
+
+    template<BlockLayout Layout>
+    struct BlockMemberTraits<Layout, GLfloat> : detail::BlockScalarTraits<GLfloat>
+    {
+    };
+
+    template<BlockLayout Layout>
+    struct BlockMemberTraits<Layout, GLint> : detail::BlockScalarTraits<GLint>
+    {
+    };
+
+    template<BlockLayout Layout>
+    struct BlockMemberTraits<Layout, GLuint> : detail::BlockScalarTraits<GLuint>
+    {
+    };
+
+    template<BlockLayout Layout>
+    struct BlockMemberTraits<Layout, GLdouble> : detail::BlockScalarTraits<GLdouble>
+    {
+    };
+
+    template<BlockLayout Layout, typename T, std::size_t N>
+    struct BlockMemberTraits<Layout, std::array<T, N>>
+        : detail::BlockArrayTraits<Layout,
+                                   BlockMemberTraits<Layout, T>::alignment,
+                                   BlockMemberTraits<Layout, T>::size,
+                                   N>
+    {
+    };
+
+#if GLOWL_USE_GLM
+    template<BlockLayout Layout, glm::length_t N, typename T, glm::qualifier Q>
+    struct BlockMemberTraits<Layout, glm::vec<N, T, Q>> : detail::BlockVectorTraits<T, static_cast<std::size_t>(N)>
+    {
+    };
+
+    template<BlockLayout Layout, glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    struct BlockMemberTraits<Layout, glm::mat<C, R, T, Q>>
+        : detail::BlockArrayTraits<Layout,
+                                   BlockMemberTraits<Layout, glm::vec<R, T, Q>>::alignment,
+                                   BlockMemberTraits<Layout, glm::vec<R, T, Q>>::size,
+                                   static_cast<std::size_t>(C)>
+    {
+    };
+#endif
+
+    /**
+     * \brief Returns true if a member of type T at the given C++ offset matches the layout rules, i.e. the offset
+     * satisfies the base alignment and the C++ size equals the layout size (no implicit padding).
+     */
+    template<BlockLayout Layout, typename T>
+    constexpr bool isBlockMemberValid(std::size_t offset)
+    {
+        return (offset % BlockMemberTraits<Layout, T>::alignment) == 0 &&
+               BlockMemberTraits<Layout, T>::size == sizeof(T);
+    }
+
+    /**
+     * \class BufferBlock
+     *
+     * \brief Typed uniform or shader storage block that resides in a range of an existing BufferObject.
+     *
+     * The block keeps a CPU shadow copy of T. Members are written via set() or modify() using pointers to members,
+     * which records their byte ranges. flush() uploads only the changed ranges (merging ranges closer than the merge
+     * gap), bind() binds the block range via glBindBufferRange.
+     *
+     * Member types are checked against the layout rules at compile time when written, member offsets are checked
+     * against the base alignment at runtime when written (throwing a BufferObjectException). For compile time offset
+     * checks, use GLOWL_CHECK_BLOCK_MEMBER next to the struct definition, e.g.
+     *
+     *   struct Lighting { glm::vec3 direction; float intensity; glm::vec4 color; };
+     *   GLOWL_CHECK_BLOCK_MEMBER(glowl::BlockLayout::Std140, Lighting, direction);
+     *   GLOWL_CHECK_BLOCK_MEMBER(glowl::BlockLayout::Std140, Lighting, intensity);
+     *   GLOWL_CHECK_BLOCK_MEMBER(glowl::BlockLayout::Std140, Lighting, color);
+     *
+     *   glowl::UniformBlock<Lighting> lighting(buffer);
+     *   lighting.set(&Lighting::intensity, 2.0f);
+     *   lighting.flush();
+     *   lighting.bind(0);
+     *
+     * \author Michael Becher
+     */
+    template<typename T, BlockLayout Layout, GLenum Target>
+    class BufferBlock
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>,
+                      "BufferBlock requires a trivially copyable standard layout type");
+
+        /**
+         * \brief BufferBlock constructor. The whole block is uploaded on the first flush.
+         *
+         * \param buffer Buffer that holds the block, has to outlive the block
+         * \param byte_offset Offset of the block within the buffer, has to satisfy the target's offset alignment
+         * \param value Initial value of the block
+         * \param merge_gap Changed ranges that are at most this many bytes apart are uploaded together
+         *
+         * Note: Active OpenGL context required for construction.
+         */
+        BufferBlock(BufferObject& buffer, GLintptr byte_offset = 0, T const& value = T(), GLsizeiptr merge_gap = 64);
+
+        /**
+         * \brief Set a single member, e.g. block.set(&Lighting::color, color). Unchanged values are not uploaded.
+         */
+        template<typename M>
+        void set(M T::*member, typename std::common_type<M>::type const& value);
+
+        /**
+         * \brief Set the whole block. Only the byte range that actually differs is uploaded.
+         */
+        void set(T const& value);
+
+        /**
+         * \brief Returns a reference to a member of the shadow copy and marks it as changed.
+         */
+        template<typename M>
+        M& modify(M T::*member);
+
+        T const& get() const;
+
+        /**
+         * \brief Upload all changed ranges.
+         */
+        void flush();
+
+        void bind(GLuint index) const;
+
+        bool isDirty() const;
+
+        BufferObject& getBuffer() const;
+
+        GLintptr getByteOffset() const;
+
+        static constexpr GLsizeiptr getByteSize()
+        {
+            return static_cast<GLsizeiptr>(sizeof(T));
+        }
+
+        /**
+         * \brief Returns the accumulated number of uploaded bytes over all flushes.
+         */
+        std::uint64_t getUploadedByteSize() const;
+
+        /**
+         * \brief Returns the accumulated number of upload calls over all flushes.
+         */
+        std::uint64_t getUploadCount() const;
+
+        void resetStatistics();
+
+    private:
+        /**
+         * \brief Returns the byte offset of a member. Throws if the offset violates the member's base alignment.
+         */
+        template<typename M>
+        GLintptr getMemberOffset(M T::*member) const;
+
+        BufferObject* m_buffer;
+        GLintptr      m_byte_offset;
+        T             m_shadow;
+        DirtyRangeSet m_dirty_ranges;
+        GLsizeiptr    m_merge_gap;
+
+        std::uint64_t m_uploaded_byte_size;
+        std::uint64_t m_upload_cnt;
+    };
+
+    template<typename T>
+    using UniformBlock = BufferBlock<T, BlockLayout::Std140, GL_UNIFORM_BUFFER>;
+
+    template<typename T>
+    using StorageBlock = BufferBlock<T, BlockLayout::Std430, GL_SHADER_STORAGE_BUFFER>;
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline BufferBlock<T, Layout, Target>::BufferBlock(BufferObject& buffer,
+                                                       GLintptr      byte_offset,
+                                                       T const&      value,
+                                                       GLsizeiptr    merge_gap)
+        : m_buffer(&buffer),
+          m_byte_offset(byte_offset),
+          m_shadow(value),
+          m_dirty_ranges(),
+          m_merge_gap(merge_gap),
+          m_uploaded_byte_size(0),
+          m_upload_cnt(0)
+    {
+        GLint alignment = 1;
+        glGetIntegerv(Target == GL_UNIFORM_BUFFER ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+                                                  : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT,
+                      &alignment);
+
+        if (byte_offset < 0 || (alignment > 0 && (byte_offset % alignment) != 0))
+        {
+            throw BufferObjectException("BufferBlock::BufferBlock - byte offset violates the offset alignment of " +
+                                        std::to_string(alignment));
+        }
+        if ((byte_offset + getByteSize()) > buffer.getByteSize())
+        {
+            throw BufferObjectException("BufferBlock::BufferBlock - block exceeds the buffer size");
+        }
+
+        m_dirty_ranges.add(0, getByteSize());
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    template<typename M>
+    inline void BufferBlock<T, Layout, Target>::set(M T::*member, typename std::common_type<M>::type const& value)
+    {
+        static_assert(BlockMemberTraits<Layout, M>::size == sizeof(M), "Member type violates the block layout");
+
+        GLintptr offset = getMemberOffset(member);
+        M&       target = m_shadow.*member;
+        if (std::memcmp(&target, &value, sizeof(M)) != 0)
+        {
+            target = value;
+            m_dirty_ranges.add(offset, sizeof(M));
+        }
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline void BufferBlock<T, Layout, Target>::set(T const& value)
+    {
+        GLubyte const* current = reinterpret_cast<GLubyte const*>(&m_shadow);
+        GLubyte const* update = reinterpret_cast<GLubyte const*>(&value);
+
+        std::size_t begin = 0;
+        std::size_t end = sizeof(T);
+        while (begin < end && current[begin] == update[begin])
+        {
+            ++begin;
+        }
+        while (end > begin && current[end - 1] == update[end - 1])
+        {
+            --end;
+        }
+
+        if (begin < end)
+        {
+            m_shadow = value;
+            m_dirty_ranges.add(static_cast<GLintptr>(begin), static_cast<GLsizeiptr>(end - begin));
+        }
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    template<typename M>
+    inline M& BufferBlock<T, Layout, Target>::modify(M T::*member)
+    {
+        static_assert(BlockMemberTraits<Layout, M>::size == sizeof(M), "Member type violates the block layout");
+
+        m_dirty_ranges.add(getMemberOffset(member), sizeof(M));
+        return m_shadow.*member;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline T const& BufferBlock<T, Layout, Target>::get() const
+    {
+        return m_shadow;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline void BufferBlock<T, Layout, Target>::flush()
+    {
+        if (m_dirty_ranges.empty())
+        {
+            return;
+        }
+
+        GLubyte const* shadow = reinterpret_cast<GLubyte const*>(&m_shadow);
+        for (auto const& range : m_dirty_ranges.coalesce(m_merge_gap))
+        {
+            m_buffer->bufferSubData(shadow + range.begin, range.end - range.begin, m_byte_offset + range.begin);
+            m_uploaded_byte_size += range.end - range.begin;
+            ++m_upload_cnt;
+        }
+
+        m_dirty_ranges.clear();
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline void BufferBlock<T, Layout, Target>::bind(GLuint index) const
+    {
+        glBindBufferRange(Target, index, m_buffer->getName(), m_byte_offset, getByteSize());
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline bool BufferBlock<T, Layout, Target>::isDirty() const
+    {
+        return !m_dirty_ranges.empty();
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline BufferObject& BufferBlock<T, Layout, Target>::getBuffer() const
+    {
+        return *m_buffer;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline GLintptr BufferBlock<T, Layout, Target>::getByteOffset() const
+    {
+        return m_byte_offset;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline std::uint64_t BufferBlock<T, Layout, Target>::getUploadedByteSize() const
+    {
+        return m_uploaded_byte_size;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline std::uint64_t BufferBlock<T, Layout, Target>::getUploadCount() const
+    {
+        return m_upload_cnt;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    inline void BufferBlock<T, Layout, Target>::resetStatistics()
+    {
+        m_uploaded_byte_size = 0;
+        m_upload_cnt = 0;
+    }
+
+    template<typename T, BlockLayout Layout, GLenum Target>
+    template<typename M>
+    inline GLintptr BufferBlock<T, Layout, Target>::getMemberOffset(M T::*member) const
+    {
+        GLintptr offset =
+            reinterpret_cast<GLubyte const*>(&(m_shadow.*member)) - reinterpret_cast<GLubyte const*>(&m_shadow);
+
+        if (!isBlockMemberValid<Layout, M>(static_cast<std::size_t>(offset)))
+        {
+            throw BufferObjectException("BufferBlock - member at byte offset " + std::to_string(offset) +
+                                        " violates the base alignment of " +
+                                        std::to_string(BlockMemberTraits<Layout, M>::alignment) +
+                                        " required by the block layout");
+        }
+
+        return offset;
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_UNIFORMBLOCK_HPP
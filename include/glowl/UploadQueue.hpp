@@ -0,0 +1,574 @@
+/*
+ * UploadQueue.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_UPLOADQUEUE_HPP
+#define GLOWL_UPLOADQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Exceptions.hpp"
+#include "ImmutableBufferObject.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \class UploadQueue
+     *
+     * \brief Asynchronous buffer and texture uploads through a persistently mapped staging buffer.
+     *
+     * Uploads can be enqueued from any thread. Worker threads copy the source data into a staging ring buffer, while
+     * the GL thread only issues glCopyNamedBufferSubData or glTextureSubImage* calls (sourcing the staging buffer as
+     * GL_PIXEL_UNPACK_BUFFER) from process(). All copies issued within one process() call form a batch that is guarded
+     * by a fence; staging memory is recycled and completion is signalled once the fence is reached.
+     * The bytes issued per process() call are limited by a frame budget (a single upload exceeding the budget is
+     * issued on its own).
+     *
+     * Typical use is to create buffers and textures without initial data and fill them via the queue.
+     * Source data and targets have to stay alive until the returned future is ready.
+     *
+     * \author Michael Becher
+     */
+    class UploadQueue
+    {
+    public:
+        using Callback = std::function<void()>;
+
+        /**
+         * \brief UploadQueue constructor.
+         *
+         * \param staging_byte_size Size of the staging buffer. A single upload must not exceed it.
+         * \param frame_byte_budget Maximum number of bytes issued per call of process()
+         * \param worker_cnt Number of worker threads used for copying into the staging buffer
+         *
+         * Note: Active OpenGL context required for construction.
+         * Use std::unique_ptr (or shared_ptr) for delayed construction of class member variables of this type.
+         */
+        UploadQueue(GLsizeiptr staging_byte_size, GLsizeiptr frame_byte_budget, unsigned int worker_cnt = 2);
+
+        ~UploadQueue();
+
+        UploadQueue(const UploadQueue&) = delete;
+        UploadQueue(UploadQueue&&) = delete;
+        UploadQueue& operator=(UploadQueue&&) = delete;
+        UploadQueue& operator=(const UploadQueue&) = delete;
+
+        /**
+         * \brief Enqueue an upload of byte_size bytes into buffer at byte_offset.
+         */
+        std::future<void> uploadBuffer(GLuint        buffer,
+                                       GLintptr      byte_offset,
+                                       GLvoid const* data,
+                                       GLsizeiptr    byte_size,
+                                       Callback      callback = Callback());
+
+        /**
+         * \brief Enqueue an upload via glTextureSubImage2D. byte_size has to match the given region, format and type
+         * (respecting GL_UNPACK_ALIGNMENT).
+         */
+        std::future<void> uploadTexture2D(GLuint        texture,
+                                          GLint         level,
+                                          GLint         xoffset,
+                                          GLint         yoffset,
+                                          GLsizei       width,
+                                          GLsizei       height,
+                                          GLenum        format,
+                                          GLenum        type,
+                                          GLvoid const* data,
+                                          GLsizeiptr    byte_size,
+                                          Callback      callback = Callback());
+
+        /**
+         * \brief Enqueue an upload via glTextureSubImage3D, e.g. for 3D textures and 2D texture arrays. byte_size has
+         * to match the given region, format and type (respecting GL_UNPACK_ALIGNMENT).
+         */
+        std::future<void> uploadTexture3D(GLuint        texture,
+                                          GLint         level,
+                                          GLint         xoffset,
+                                          GLint         yoffset,
+                                          GLint         zoffset,
+                                          GLsizei       width,
+                                          GLsizei       height,
+                                          GLsizei       depth,
+                                          GLenum        format,
+                                          GLenum        type,
+                                          GLvoid const* data,
+                                          GLsizeiptr    byte_size,
+                                          Callback      callback = Callback());
+
+        /**
+         * \brief Retire finished batches, issue staged uploads within the frame budget and stage pending uploads.
+         * Call once per frame on the GL thread.
+         */
+        void process();
+
+        void setFrameByteBudget(GLsizeiptr frame_byte_budget);
+
+        GLsizeiptr getFrameByteBudget() const;
+
+        /**
+         * \brief Returns the number of bytes issued by the last call of process().
+         */
+        GLsizeiptr getIssuedByteSize() const;
+
+        /**
+         * \brief Returns the number of uploads that have not completed yet. May be called from any thread.
+         */
+        std::size_t getOutstandingCount() const;
+
+    private:
+        enum class UploadType
+        {
+            Buffer,
+            Texture2D,
+            Texture3D
+        };
+
+        struct Upload
+        {
+            UploadType type;
+            GLuint     target;
+            GLintptr   byte_offset;
+            GLint      level;
+            GLint      offset[3];
+            GLsizei    extent[3];
+            GLenum     format;
+            GLenum     data_type;
+
+            GLvoid const* data;
+            GLsizeiptr    byte_size;
+
+            GLintptr         staging_offset;
+            GLsizeiptr       staging_consumed; ///< Ring bytes consumed including alignment and wrap-around
+            std::atomic_bool staged;
+
+            std::promise<void> promise;
+            Callback           callback;
+        };
+
+        struct Batch
+        {
+            GLsync                               fence;
+            std::vector<std::shared_ptr<Upload>> uploads;
+        };
+
+        std::future<void> enqueue(std::shared_ptr<Upload> upload);
+
+        bool allocateStaging(Upload& upload);
+
+        void issue(Upload const& upload);
+
+        void workerLoop();
+
+        ImmutableBufferObject m_staging_buffer;
+        GLubyte*              m_staging_data;
+        GLsizeiptr            m_staging_head;
+        GLsizeiptr            m_staging_used;
+
+        GLsizeiptr m_frame_byte_budget;
+        GLsizeiptr m_issued_byte_size;
+
+        std::atomic<std::size_t>            m_outstanding_cnt;
+        std::mutex                          m_pending_mutex;
+        std::deque<std::shared_ptr<Upload>> m_pending;
+        std::deque<std::shared_ptr<Upload>> m_staged;
+        std::deque<Batch>                   m_in_flight;
+
+        std::mutex                          m_worker_mutex;
+        std::condition_variable             m_worker_cv;
+        std::deque<std::shared_ptr<Upload>> m_worker_tasks;
+        std::vector<std::thread>            m_workers;
+        bool                                m_stop_workers;
+    };
+
+    inline UploadQueue::UploadQueue(GLsizeiptr staging_byte_size, GLsizeiptr frame_byte_budget, unsigned int worker_cnt)
+        : m_staging_buffer(nullptr, staging_byte_size, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT),
+          m_staging_data(nullptr),
+          m_staging_head(0),
+          m_staging_used(0),
+          m_frame_byte_budget(frame_byte_budget),
+          m_issued_byte_size(0),
+          m_outstanding_cnt(0),
+          m_stop_workers(false)
+    {
+        m_staging_data = static_cast<GLubyte*>(
+            glMapNamedBufferRange(m_staging_buffer.getName(),
+                                  0,
+                                  staging_byte_size,
+                                  GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR || m_staging_data == nullptr)
+        {
+            throw BufferObjectException("UploadQueue::UploadQueue - OpenGL error " + std::to_string(err));
+        }
+
+        for (unsigned int i = 0; i < std::max(worker_cnt, 1u); ++i)
+        {
+            m_workers.emplace_back(&UploadQueue::workerLoop, this);
+        }
+    }
+
+    inline UploadQueue::~UploadQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_worker_mutex);
+            m_stop_workers = true;
+        }
+        m_worker_cv.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+
+        for (auto& batch : m_in_flight)
+        {
+            glDeleteSync(batch.fence);
+        }
+
+        glUnmapNamedBuffer(m_staging_buffer.getName());
+    }
+
+    inline std::future<void> UploadQueue::uploadBuffer(GLuint        buffer,
+                                                       GLintptr      byte_offset,
+                                                       GLvoid const* data,
+                                                       GLsizeiptr    byte_size,
+                                                       Callback      callback)
+    {
+        auto upload = std::make_shared<Upload>();
+        upload->type = UploadType::Buffer;
+        upload->target = buffer;
+        upload->byte_offset = byte_offset;
+        upload->data = data;
+        upload->byte_size = byte_size;
+        upload->callback = std::move(callback);
+
+        return enqueue(std::move(upload));
+    }
+
+    inline std::future<void> UploadQueue::uploadTexture2D(GLuint        texture,
+                                                          GLint         level,
+                                                          GLint         xoffset,
+                                                          GLint         yoffset,
+                                                          GLsizei       width,
+                                                          GLsizei       height,
+                                                          GLenum        format,
+                                                          GLenum        type,
+                                                          GLvoid const* data,
+                                                          GLsizeiptr    byte_size,
+                                                          Callback      callback)
+    {
+        auto upload = std::make_shared<Upload>();
+        upload->type = UploadType::Texture2D;
+        upload->target = texture;
+        upload->level = level;
+        upload->offset[0] = xoffset;
+        upload->offset[1] = yoffset;
+        upload->extent[0] = width;
+        upload->extent[1] = height;
+        upload->format = format;
+        upload->data_type = type;
+        upload->data = data;
+        upload->byte_size = byte_size;
+        upload->callback = std::move(callback);
+
+        return enqueue(std::move(upload));
+    }
+
+    inline std::future<void> UploadQueue::uploadTexture3D(GLuint        texture,
+                                                          GLint         level,
+                                                          GLint         xoffset,
+                                                          GLint         yoffset,
+                                                          GLint         zoffset,
+                                                          GLsizei       width,
+                                                          GLsizei       height,
+                                                          GLsizei       depth,
+                                                          GLenum        format,
+                                                          GLenum        type,
+                                                          GLvoid const* data,
+                                                          GLsizeiptr    byte_size,
+                                                          Callback      callback)
+    {
+        auto upload = std::make_shared<Upload>();
+        upload->type = UploadType::Texture3D;
+        upload->target = texture;
+        upload->level = level;
+        upload->offset[0] = xoffset;
+        upload->offset[1] = yoffset;
+        upload->offset[2] = zoffset;
+        upload->extent[0] = width;
+        upload->extent[1] = height;
+        upload->extent[2] = depth;
+        upload->format = format;
+        upload->data_type = type;
+        upload->data = data;
+        upload->byte_size = byte_size;
+        upload->callback = std::move(callback);
+
+        return enqueue(std::move(upload));
+    }
+
+    inline void UploadQueue::process()
+    {
+        // retire batches the GPU is done with, in submission order
+        while (!m_in_flight.empty())
+        {
+            GLenum result = glClientWaitSync(m_in_flight.front().fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                break;
+            }
+            if (result == GL_WAIT_FAILED)
+            {
+                throw BufferObjectException("UploadQueue::process - waiting for fence failed");
+            }
+
+            Batch batch = std::move(m_in_flight.front());
+            m_in_flight.pop_front();
+            glDeleteSync(batch.fence);
+
+            for (auto& upload : batch.uploads)
+            {
+                m_staging_used -= upload->staging_consumed;
+                m_outstanding_cnt.fetch_sub(1, std::memory_order_relaxed);
+                upload->promise.set_value();
+                if (upload->callback)
+                {
+                    upload->callback();
+                }
+            }
+        }
+
+        // issue staged uploads in staging order to keep the ring buffer FIFO
+        Batch batch{nullptr, {}};
+        m_issued_byte_size = 0;
+
+        while (!m_staged.empty() && m_staged.front()->staged.load(std::memory_order_acquire))
+        {
+            auto& upload = m_staged.front();
+            if (!batch.uploads.empty() && (m_issued_byte_size + upload->byte_size) > m_frame_byte_budget)
+            {
+                break;
+            }
+
+            issue(*upload);
+            m_issued_byte_size += upload->byte_size;
+            batch.uploads.push_back(std::move(upload));
+            m_staged.pop_front();
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (!batch.uploads.empty())
+        {
+            batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            m_in_flight.push_back(std::move(batch));
+        }
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw BufferObjectException("UploadQueue::process - OpenGL error " + std::to_string(err));
+        }
+
+        // hand pending uploads to the workers as long as staging memory is available
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        while (!m_pending.empty() && allocateStaging(*m_pending.front()))
+        {
+            m_staged.push_back(m_pending.front());
+
+            {
+                std::lock_guard<std::mutex> worker_lock(m_worker_mutex);
+                m_worker_tasks.push_back(m_pending.front());
+            }
+            m_worker_cv.notify_one();
+
+            m_pending.pop_front();
+        }
+    }
+
+    inline void UploadQueue::setFrameByteBudget(GLsizeiptr frame_byte_budget)
+    {
+        m_frame_byte_budget = frame_byte_budget;
+    }
+
+    inline GLsizeiptr UploadQueue::getFrameByteBudget() const
+    {
+        return m_frame_byte_budget;
+    }
+
+    inline GLsizeiptr UploadQueue::getIssuedByteSize() const
+    {
+        return m_issued_byte_size;
+    }
+
+    inline std::size_t UploadQueue::getOutstandingCount() const
+    {
+        // staged and in-flight uploads are owned by the GL thread, count all of them with a single atomic instead
+        return m_outstanding_cnt.load(std::memory_order_relaxed);
+    }
+
+    inline std::future<void> UploadQueue::enqueue(std::shared_ptr<Upload> upload)
+    {
+        if (upload->byte_size <= 0 || upload->byte_size > m_staging_buffer.getByteSize())
+        {
+            throw BufferObjectException("UploadQueue::enqueue - upload of " + std::to_string(upload->byte_size) +
+                                        " bytes does not fit into staging buffer");
+        }
+
+        upload->staged = false;
+        auto retval = upload->promise.get_future();
+
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending.push_back(std::move(upload));
+        m_outstanding_cnt.fetch_add(1, std::memory_order_relaxed);
+
+        return retval;
+    }
+
+    inline bool UploadQueue::allocateStaging(Upload& upload)
+    {
+        // keep staging offsets aligned for any pixel transfer type
+        constexpr GLsizeiptr alignment = 16;
+
+        GLsizeiptr staging_size = m_staging_buffer.getByteSize();
+
+        if (m_staging_used == 0)
+        {
+            m_staging_head = 0;
+        }
+        else if (m_staging_used >= staging_size)
+        {
+            return false;
+        }
+
+        GLsizeiptr tail = (m_staging_head + staging_size - m_staging_used) % staging_size;
+        GLsizeiptr aligned_head = ((m_staging_head + alignment - 1) / alignment) * alignment;
+
+        GLintptr   offset = 0;
+        GLsizeiptr consumed = 0;
+
+        if (m_staging_head >= tail)
+        {
+            // free space is [head, end) followed by [0, tail)
+            if ((aligned_head + upload.byte_size) <= staging_size)
+            {
+                offset = aligned_head;
+                consumed = (aligned_head + upload.byte_size) - m_staging_head;
+            }
+            else if (upload.byte_size <= tail)
+            {
+                offset = 0;
+                consumed = (staging_size - m_staging_head) + upload.byte_size;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // free space is [head, tail)
+            if ((aligned_head + upload.byte_size) <= tail)
+            {
+                offset = aligned_head;
+                consumed = (aligned_head + upload.byte_size) - m_staging_head;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        upload.staging_offset = offset;
+        upload.staging_consumed = consumed;
+        m_staging_head = (offset + upload.byte_size) % staging_size;
+        m_staging_used += consumed;
+
+        return true;
+    }
+
+    inline void UploadQueue::issue(Upload const& upload)
+    {
+        switch (upload.type)
+        {
+        case UploadType::Buffer:
+            glCopyNamedBufferSubData(m_staging_buffer.getName(),
+                                     upload.target,
+                                     upload.staging_offset,
+                                     upload.byte_offset,
+                                     upload.byte_size);
+            break;
+        case UploadType::Texture2D:
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging_buffer.getName());
+            glTextureSubImage2D(upload.target,
+                                upload.level,
+                                upload.offset[0],
+                                upload.offset[1],
+                                upload.extent[0],
+                                upload.extent[1],
+                                upload.format,
+                                upload.data_type,
+                                reinterpret_cast<GLvoid const*>(upload.staging_offset));
+            break;
+        case UploadType::Texture3D:
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging_buffer.getName());
+            glTextureSubImage3D(upload.target,
+                                upload.level,
+                                upload.offset[0],
+                                upload.offset[1],
+                                upload.offset[2],
+                                upload.extent[0],
+                                upload.extent[1],
+                                upload.extent[2],
+                                upload.format,
+                                upload.data_type,
+                                reinterpret_cast<GLvoid const*>(upload.staging_offset));
+            break;
+        }
+    }
+
+    inline void UploadQueue::workerLoop()
+    {
+        for (;;)
+        {
+            std::shared_ptr<Upload> upload;
+
+            {
+                std::unique_lock<std::mutex> lock(m_worker_mutex);
+                m_worker_cv.wait(lock, [this]() { return m_stop_workers || !m_worker_tasks.empty(); });
+
+                if (m_stop_workers)
+                {
+                    return;
+                }
+
+                upload = std::move(m_worker_tasks.front());
+                m_worker_tasks.pop_front();
+            }
+
+            std::memcpy(m_staging_data + upload->staging_offset, upload->data, upload->byte_size);
+            upload->staged.store(true, std::memory_order_release);
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_UPLOADQUEUE_HPP
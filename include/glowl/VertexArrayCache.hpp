@@ -0,0 +1,307 @@
+/*
+ * VertexArrayCache.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_VERTEXARRAYCACHE_HPP
+#define GLOWL_VERTEXARRAYCACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "BufferObject.hpp"
+#include "Exceptions.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \brief Sets up the attribute formats of a vertex array for the given vertex layouts.
+     *
+     * Each VertexLayout is assigned to the vertex buffer binding point of the same index, attribute indices are
+     * assigned consecutively over all layouts. The binding divisor of each binding point is set to the layout's
+     * divisor. Vertex and element buffers are not attached.
+     */
+    inline void setVertexArrayFormat(GLuint va_handle, std::vector<VertexLayout> const& vertex_descriptor)
+    {
+        GLuint attrib_idx = 0;
+
+        for (std::size_t vertex_layout_idx = 0; vertex_layout_idx < vertex_descriptor.size(); ++vertex_layout_idx)
+        {
+            for (std::size_t local_attrib_idx = 0;
+                 local_attrib_idx < vertex_descriptor[vertex_layout_idx].attributes.size();
+                 ++local_attrib_idx)
+            {
+                auto const& attribute = vertex_descriptor[vertex_layout_idx].attributes[local_attrib_idx];
+
+                glEnableVertexArrayAttrib(va_handle, attrib_idx);
+                switch (attribute.shader_input_type)
+                {
+                case GL_FLOAT:
+                    glVertexArrayAttribFormat(va_handle,
+                                              attrib_idx,
+                                              attribute.size,
+                                              attribute.type,
+                                              attribute.normalized,
+                                              attribute.offset);
+                    break;
+                case GL_INT:
+                    glVertexArrayAttribIFormat(va_handle, attrib_idx, attribute.size, attribute.type, attribute.offset);
+                    break;
+                case GL_DOUBLE:
+                    glVertexArrayAttribLFormat(va_handle, attrib_idx, attribute.size, attribute.type, attribute.offset);
+                    break;
+                default:
+                    throw MeshException(
+                        "setVertexArrayFormat - invalid vertex shader input type given (use float, double or int)");
+                    break;
+                }
+                glVertexArrayAttribBinding(va_handle, attrib_idx, static_cast<GLuint>(vertex_layout_idx));
+
+                ++attrib_idx;
+            }
+
+            glVertexArrayBindingDivisor(va_handle,
+                                        static_cast<GLuint>(vertex_layout_idx),
+                                        vertex_descriptor[vertex_layout_idx].divisor);
+        }
+    }
+
+    /**
+     * \brief Computes a hash of a set of vertex layouts, e.g. for finding meshes that can share a vertex array.
+     */
+    inline std::size_t hashVertexLayouts(std::vector<VertexLayout> const& vertex_descriptor)
+    {
+        std::size_t retval = vertex_descriptor.size();
+        auto        combine = [&retval](std::size_t value) {
+            retval ^= value + 0x9e3779b97f4a7c15ull + (retval << 6) + (retval >> 2);
+        };
+
+        for (auto const& vertex_layout : vertex_descriptor)
+        {
+            combine(std::hash<GLsizei>()(vertex_layout.stride));
+            combine(std::hash<GLuint>()(vertex_layout.divisor));
+            combine(vertex_layout.attributes.size());
+            for (auto const& attribute : vertex_layout.attributes)
+            {
+                combine(std::hash<GLint>()(attribute.size));
+                combine(std::hash<GLenum>()(attribute.type));
+                combine(std::hash<GLboolean>()(attribute.normalized));
+                combine(std::hash<GLsizei>()(attribute.offset));
+                combine(std::hash<GLenum>()(attribute.shader_input_type));
+            }
+        }
+
+        return retval;
+    }
+
+    /**
+     * \class VertexArrayCache
+     *
+     * \brief Shares one vertex array between all meshes with identical vertex layouts, see
+     * Mesh::setVertexArrayCache().
+     *
+     * The attribute format of a shared vertex array is set up once, drawing a mesh only attaches its buffers (with a
+     * single multi-bind call) if they are not attached already.
+     *
+     * Outside of a batch, meshes unbind the shared vertex array after drawing, so that later buffer bindings of
+     * other code cannot modify it behind the back of the cache. Between beginBatch() and endBatch(), meshes leave it
+     * bound, so sorting draws by vertex layouts results in one vertex array bind per group of meshes. Within a batch,
+     * GL_ELEMENT_ARRAY_BUFFER must not be bound by other code.
+     *
+     * The cache has to outlive all meshes using it. It is not thread-safe.
+     *
+     * \author Michael Becher
+     */
+    class VertexArrayCache
+    {
+    public:
+        /**
+         * \brief VertexArrayCache constructor.
+         *
+         * Note: Active OpenGL context required for usage.
+         */
+        VertexArrayCache() = default;
+
+        /**
+         * Deletes all vertex arrays of the cache.
+         */
+        ~VertexArrayCache();
+
+        VertexArrayCache(const VertexArrayCache&) = delete;
+        VertexArrayCache(VertexArrayCache&&) = delete;
+        VertexArrayCache& operator=(VertexArrayCache&&) = delete;
+        VertexArrayCache& operator=(const VertexArrayCache&) = delete;
+
+        /**
+         * \brief Returns the vertex array for the given vertex layouts, creating it if there is none yet.
+         */
+        GLuint acquire(std::vector<VertexLayout> const& vertex_descriptor);
+
+        /**
+         * \brief Attach vertex and index buffers to a vertex array of the cache, unless they are attached already.
+         */
+        void attachBuffers(GLuint va_handle, std::vector<BufferObject> const& vbos, BufferObject const& ibo);
+
+        /**
+         * \brief Forget the buffers attached to a vertex array, e.g. because they were reallocated or deleted.
+         */
+        void invalidate(GLuint va_handle);
+
+        /**
+         * \brief Start a batch of draws. Meshes leave the shared vertex array bound until endBatch().
+         */
+        void beginBatch()
+        {
+            m_batch_active = true;
+        }
+
+        /**
+         * \brief End a batch of draws and unbind the vertex array.
+         */
+        void endBatch()
+        {
+            m_batch_active = false;
+            glBindVertexArray(0);
+        }
+
+        bool isBatchActive() const
+        {
+            return m_batch_active;
+        }
+
+        std::size_t getVertexArrayCount() const
+        {
+            return m_entries.size();
+        }
+
+        /**
+         * \brief Returns the number of attachBuffers() calls that actually changed the attached buffers.
+         */
+        std::size_t getAttachCount() const
+        {
+            return m_attach_cnt;
+        }
+
+    private:
+        struct Entry
+        {
+            std::vector<VertexLayout> vertex_descriptor;
+            std::vector<GLuint>       attached_vbos;
+            std::vector<GLintptr>     offsets;
+            std::vector<GLsizei>      strides;
+            GLuint                    attached_ibo;
+        };
+
+        std::unordered_map<GLuint, Entry>            m_entries;
+        std::unordered_multimap<std::size_t, GLuint> m_handles;
+        std::size_t                                  m_attach_cnt = 0;
+        bool                                         m_batch_active = false;
+    };
+
+    inline VertexArrayCache::~VertexArrayCache()
+    {
+        for (auto const& entry : m_entries)
+        {
+            glDeleteVertexArrays(1, &entry.first);
+        }
+    }
+
+    inline GLuint VertexArrayCache::acquire(std::vector<VertexLayout> const& vertex_descriptor)
+    {
+        std::size_t hash = hashVertexLayouts(vertex_descriptor);
+
+        auto range = m_handles.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            // guard against hash collisions
+            if (m_entries[it->second].vertex_descriptor == vertex_descriptor)
+            {
+                return it->second;
+            }
+        }
+
+        GLuint va_handle = 0;
+        glCreateVertexArrays(1, &va_handle);
+        setVertexArrayFormat(va_handle, vertex_descriptor);
+
+        Entry entry;
+        entry.vertex_descriptor = vertex_descriptor;
+        entry.attached_vbos.assign(vertex_descriptor.size(), 0);
+        entry.offsets.assign(vertex_descriptor.size(), 0);
+        for (auto const& vertex_layout : vertex_descriptor)
+        {
+            entry.strides.push_back(vertex_layout.stride);
+        }
+        entry.attached_ibo = 0;
+
+        m_entries.emplace(va_handle, std::move(entry));
+        m_handles.emplace(hash, va_handle);
+
+        auto err = glGetError();
+        if (err != GL_NO_ERROR)
+        {
+            throw MeshException("VertexArrayCache::acquire - OpenGL error " + std::to_string(err));
+        }
+
+        return va_handle;
+    }
+
+    inline void VertexArrayCache::attachBuffers(GLuint                           va_handle,
+                                                std::vector<BufferObject> const& vbos,
+                                                BufferObject const&              ibo)
+    {
+        auto it = m_entries.find(va_handle);
+        if (it == m_entries.end() || vbos.size() != it->second.attached_vbos.size())
+        {
+            throw MeshException("VertexArrayCache::attachBuffers - vertex array or buffer count does not match");
+        }
+        Entry& entry = it->second;
+
+        bool attached = true;
+        for (std::size_t i = 0; i < vbos.size(); ++i)
+        {
+            attached &= entry.attached_vbos[i] == vbos[i].getName();
+        }
+        if (!attached)
+        {
+            for (std::size_t i = 0; i < vbos.size(); ++i)
+            {
+                entry.attached_vbos[i] = vbos[i].getName();
+            }
+            glVertexArrayVertexBuffers(va_handle,
+                                       0,
+                                       static_cast<GLsizei>(vbos.size()),
+                                       entry.attached_vbos.data(),
+                                       entry.offsets.data(),
+                                       entry.strides.data());
+        }
+        if (entry.attached_ibo != ibo.getName())
+        {
+            entry.attached_ibo = ibo.getName();
+            glVertexArrayElementBuffer(va_handle, entry.attached_ibo);
+            attached = false;
+        }
+
+        m_attach_cnt += attached ? 0 : 1;
+    }
+
+    inline void VertexArrayCache::invalidate(GLuint va_handle)
+    {
+        auto it = m_entries.find(va_handle);
+        if (it != m_entries.end())
+        {
+            it->second.attached_vbos.assign(it->second.attached_vbos.size(), 0);
+            it->second.attached_ibo = 0;
+        }
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_VERTEXARRAYCACHE_HPP
@@ -8,6 +8,8 @@
 #ifndef GLOWL_VERTEXLAYOUT_HPP
 #define GLOWL_VERTEXLAYOUT_HPP
 
+#include <vector>
+
 #include "glinclude.h"
 
 namespace glowl
@@ -35,6 +37,9 @@ namespace glowl
      * Fully interleaved vertex data,
      * e.g. three attribs in one buffer {{vec3,vec3,vec2},{vec3,vec3,vec2},...} have stride 32 in a single vertex layout
      *
+     * Per-instance data,
+     * e.g. a buffer {mat4,mat4,...} advancing once per instance has stride 64 and divisor 1 (four vec4 attributes)
+     *
      * \author Michael Becher
      */
     struct VertexLayout
@@ -61,15 +66,17 @@ namespace glowl
             GLenum    shader_input_type; ///< type used by vertex shader input: float, double or integer
         };
 
-        VertexLayout() : attributes() {}
+        VertexLayout() : attributes(), divisor(0) {}
         /**
          * Construct VertexLayout from set of strides and attributes
          *
          * \param strides Stride values in byte per vertex attribute. It is possible to use only a single stride value
          * for all attributes (see VertexLayout member documentation).
+         * \param divisor Number of instances per element of the buffer, 0 for per-vertex data
          *
          */
-        VertexLayout(GLsizei stride, std::vector<Attribute> const& attributes) : stride(stride), attributes(attributes)
+        VertexLayout(GLsizei stride, std::vector<Attribute> const& attributes, GLuint divisor = 0)
+            : stride(stride), attributes(attributes), divisor(divisor)
         {
         }
         /**
@@ -77,12 +84,17 @@ namespace glowl
          *
          * \param strides Stride values in byte per vertex attribute. It is possible to use only a single stride value
          * for all attributes (see VertexLayout member documentation).
+         * \param divisor Number of instances per element of the buffer, 0 for per-vertex data
          *
          */
-        VertexLayout(GLsizei stride, std::vector<Attribute>&& attributes) : stride(stride), attributes(attributes) {}
+        VertexLayout(GLsizei stride, std::vector<Attribute>&& attributes, GLuint divisor = 0)
+            : stride(stride), attributes(attributes), divisor(divisor)
+        {
+        }
 
         GLsizei                stride;
         std::vector<Attribute> attributes;
+        GLuint                 divisor; ///< binding divisor, i.e. instances per element (0 = per-vertex data)
     };
 
     inline bool operator==(VertexLayout::Attribute const& lhs, VertexLayout::Attribute const& rhs)
@@ -96,6 +108,7 @@ namespace glowl
         bool rtn = true;
 
         rtn &= lhs.stride == rhs.stride;
+        rtn &= lhs.divisor == rhs.divisor;
 
         if (lhs.attributes.size() == rhs.attributes.size())
         {
@@ -166,7 +179,15 @@ namespace glowl
 
     inline std::size_t computeAttributeByteSize(VertexLayout::Attribute attrib_desc)
     {
-        return computeByteSize(attrib_desc.type) * attrib_desc.size;
+        switch (attrib_desc.type)
+        {
+        case GL_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+            return computeByteSize(attrib_desc.type); // all components packed into one value
+        default:
+            return computeByteSize(attrib_desc.type) * (attrib_desc.size == GL_BGRA ? 4 : attrib_desc.size);
+        }
     }
 
 } // namespace glowl
@@ -0,0 +1,498 @@
+/*
+ * VertexPacking.hpp
+ *
+ * MIT License
+ * Copyright (c) 2026 Michael Becher
+ */
+
+#ifndef GLOWL_VERTEXPACKING_HPP
+#define GLOWL_VERTEXPACKING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__F16C__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Exceptions.hpp"
+#include "VertexLayout.hpp"
+#include "glinclude.h"
+
+namespace glowl
+{
+
+    /**
+     * \brief Compact encodings for float vertex attributes, see packVertexData().
+     */
+    enum class VertexEncoding
+    {
+        None,            ///< Keep the attribute as is
+        HalfFloat,       ///< GL_HALF_FLOAT per component
+        Snorm2_10_10_10, ///< GL_INT_2_10_10_10_REV, normalized. For normals or tangents in [-1,1], size 3 or 4.
+        Octahedral,      ///< Unit vector mapped to 2 normalized GL_SHORT, decode with octahedral_decode_glsl
+        Unorm16          ///< GL_UNSIGNED_SHORT per component, normalized. For texture coordinates in [0,1].
+    };
+
+    /**
+     * \brief GLSL function for decoding octahedral encoded vectors in the vertex shader.
+     */
+    constexpr char const* octahedral_decode_glsl =
+        "vec3 decodeOctahedral(vec2 e)\n"
+        "{\n"
+        "    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));\n"
+        "    float t = max(-n.z, 0.0);\n"
+        "    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);\n"
+        "    return normalize(n);\n"
+        "}\n";
+
+    /**
+     * \struct PackedVertexData
+     *
+     * \brief Result of packVertexData(). Holds one packed vertex buffer and the matching VertexLayout per input
+     * layout and can be passed to the Mesh constructor directly.
+     */
+    struct PackedVertexData
+    {
+        std::vector<std::vector<GLubyte>> vertex_data;
+        std::vector<VertexLayout>         vertex_descriptor;
+        std::size_t                       unpacked_byte_size = 0;
+        std::size_t                       packed_byte_size = 0;
+
+        std::vector<void const*> getDataPointers() const
+        {
+            std::vector<void const*> retval;
+            for (auto const& data : vertex_data)
+            {
+                retval.push_back(data.data());
+            }
+            return retval;
+        }
+
+        std::vector<std::size_t> getByteSizes() const
+        {
+            std::vector<std::size_t> retval;
+            for (auto const& data : vertex_data)
+            {
+                retval.push_back(data.size());
+            }
+            return retval;
+        }
+
+        /**
+         * \brief Returns the number of bytes saved by packing. Negative if alignment padding outweighs the savings.
+         */
+        std::ptrdiff_t getSavedByteSize() const
+        {
+            return static_cast<std::ptrdiff_t>(unpacked_byte_size) - static_cast<std::ptrdiff_t>(packed_byte_size);
+        }
+    };
+
+    /**
+     * \brief Convert a single float to half float (round to nearest even).
+     */
+    inline std::uint16_t convertFloatToHalf(float value)
+    {
+        constexpr std::uint32_t f32_infinity = 255u << 23;
+        constexpr std::uint32_t f16_max = (127u + 16u) << 23;
+        constexpr std::uint32_t denorm_magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        std::uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        std::uint16_t retval = 0;
+        if (bits >= f16_max)
+        {
+            // overflow to infinity, keep NaN a (quiet) NaN
+            retval = bits > f32_infinity ? 0x7E00 : 0x7C00;
+        }
+        else if (bits < (113u << 23))
+        {
+            // resulting half is subnormal, let the float addition do the rounding
+            float denorm_magic;
+            std::memcpy(&denorm_magic, &denorm_magic_bits, sizeof(denorm_magic));
+            float abs_value;
+            std::memcpy(&abs_value, &bits, sizeof(abs_value));
+            abs_value += denorm_magic;
+            std::memcpy(&bits, &abs_value, sizeof(bits));
+            retval = static_cast<std::uint16_t>(bits - denorm_magic_bits);
+        }
+        else
+        {
+            std::uint32_t mantissa_odd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xFFFu;
+            bits += mantissa_odd;
+            retval = static_cast<std::uint16_t>(bits >> 13);
+        }
+
+        return retval | static_cast<std::uint16_t>(sign >> 16);
+    }
+
+    /**
+     * \brief Convert a single half float to float (exact).
+     */
+    inline float convertHalfToFloat(std::uint16_t value)
+    {
+        std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+        std::uint32_t exponent = (value >> 10) & 0x1Fu;
+        std::uint32_t mantissa = value & 0x3FFu;
+
+        float retval;
+        if (exponent == 0)
+        {
+            // zero or subnormal, representable as normal float
+            retval = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign != 0 ? -retval : retval;
+        }
+
+        std::uint32_t bits = sign | (mantissa << 13);
+        bits |= exponent == 0x1Fu ? (255u << 23) : ((exponent + (127u - 15u)) << 23);
+        std::memcpy(&retval, &bits, sizeof(retval));
+        return retval;
+    }
+
+    /**
+     * \brief Convert count floats to half floats. Uses F16C if available.
+     */
+    inline void convertFloatToHalf(float const* src, std::uint16_t* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            dst[i] = convertFloatToHalf(src[i]);
+        }
+    }
+
+    /**
+     * \brief Convert count floats to normalized unsigned shorts, clamping to [0,1]. Uses AVX2 if available.
+     */
+    inline void convertFloatToUnorm16(float const* src, std::uint16_t* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        __m256 const zero = _mm256_setzero_ps();
+        __m256 const one = _mm256_set1_ps(1.0f);
+        __m256 const scale = _mm256_set1_ps(65535.0f);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256  value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), zero), one);
+            __m256i quantized = _mm256_cvtps_epi32(_mm256_mul_ps(value, scale));
+            // packing works per 128bit lane, gather the low halves of both lanes afterwards
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(quantized, quantized), 0x08);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            float value = std::min(std::max(src[i], 0.0f), 1.0f);
+            dst[i] = static_cast<std::uint16_t>(std::nearbyint(value * 65535.0f));
+        }
+    }
+
+    /**
+     * \brief Convert count floats to normalized signed shorts, clamping to [-1,1]. Uses AVX2 if available.
+     */
+    inline void convertFloatToSnorm16(float const* src, std::int16_t* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        __m256 const minus_one = _mm256_set1_ps(-1.0f);
+        __m256 const one = _mm256_set1_ps(1.0f);
+        __m256 const scale = _mm256_set1_ps(32767.0f);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256  value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), minus_one), one);
+            __m256i quantized = _mm256_cvtps_epi32(_mm256_mul_ps(value, scale));
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(quantized, quantized), 0x08);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            float value = std::min(std::max(src[i], -1.0f), 1.0f);
+            dst[i] = static_cast<std::int16_t>(std::nearbyint(value * 32767.0f));
+        }
+    }
+
+    /**
+     * \brief Pack a vector in [-1,1] to GL_INT_2_10_10_10_REV (x in the lowest bits).
+     */
+    inline std::uint32_t packSnorm2_10_10_10(float x, float y, float z, float w)
+    {
+        auto quantize = [](float value, float scale, std::uint32_t mask) {
+            float clamped = std::min(std::max(value, -1.0f), 1.0f);
+            return static_cast<std::uint32_t>(static_cast<std::int32_t>(std::nearbyint(clamped * scale))) & mask;
+        };
+
+        return quantize(x, 511.0f, 0x3FFu) | (quantize(y, 511.0f, 0x3FFu) << 10) |
+               (quantize(z, 511.0f, 0x3FFu) << 20) | (quantize(w, 1.0f, 0x3u) << 30);
+    }
+
+    /**
+     * \brief Map count unit vectors (3 floats each) to the octahedron parametrization in [-1,1]^2 (2 floats each).
+     */
+    inline void encodeOctahedral(float const* src, float* dst, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float x = src[3 * i + 0];
+            float y = src[3 * i + 1];
+            float z = src[3 * i + 2];
+
+            float l1_norm = std::abs(x) + std::abs(y) + std::abs(z);
+            if (l1_norm > 0.0f)
+            {
+                x /= l1_norm;
+                y /= l1_norm;
+                z /= l1_norm;
+            }
+
+            if (z < 0.0f)
+            {
+                // fold the lower hemisphere over the diagonals
+                float folded_x = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                float folded_y = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = folded_x;
+                y = folded_y;
+            }
+
+            dst[2 * i + 0] = x;
+            dst[2 * i + 1] = y;
+        }
+    }
+
+    /**
+     * \brief Rewrite float vertex attributes to compact encodings.
+     *
+     * Each vertex buffer is repacked to an interleaved buffer with the attributes of its layout in the original
+     * order, each aligned to 4 bytes. Attributes with an encoding other than VertexEncoding::None have to be of type
+     * GL_FLOAT with float shader input. Packed attributes remain float shader inputs, only octahedral encoded
+     * vectors require decoding in the shader (see octahedral_decode_glsl).
+     *
+     * \param vertex_data One data pointer per vertex layout
+     * \param vertex_data_byte_sizes Byte size per vertex layout, a multiple of the layout's stride
+     * \param encodings One encoding per attribute per vertex layout
+     */
+    inline PackedVertexData packVertexData(std::vector<void const*> const&                 vertex_data,
+                                           std::vector<std::size_t> const&                 vertex_data_byte_sizes,
+                                           std::vector<VertexLayout> const&                vertex_descriptor,
+                                           std::vector<std::vector<VertexEncoding>> const& encodings)
+    {
+        if (vertex_data.size() != vertex_data_byte_sizes.size() || vertex_data.size() != vertex_descriptor.size() ||
+            vertex_data.size() != encodings.size())
+        {
+            throw MeshException("packVertexData - Vector parameters of different size!");
+        }
+
+        // byte size of an unpacked attribute, packed formats store all components in one value
+        auto attributeByteSize = [](VertexLayout::Attribute const& attribute) {
+            if (attribute.type == GL_INT_2_10_10_10_REV || attribute.type == GL_UNSIGNED_INT_2_10_10_10_REV ||
+                attribute.type == GL_UNSIGNED_INT_10F_11F_11F_REV)
+            {
+                return std::size_t(4);
+            }
+            return computeAttributeByteSize(attribute);
+        };
+
+        PackedVertexData retval;
+
+        for (std::size_t layout_idx = 0; layout_idx < vertex_descriptor.size(); ++layout_idx)
+        {
+            VertexLayout const& layout = vertex_descriptor[layout_idx];
+
+            if (encodings[layout_idx].size() != layout.attributes.size())
+            {
+                throw MeshException("packVertexData - Number of encodings does not match number of attributes");
+            }
+            if (layout.stride <= 0)
+            {
+                throw MeshException("packVertexData - Vertex layout requires an explicit stride");
+            }
+
+            std::size_t vertex_cnt = vertex_data_byte_sizes[layout_idx] / static_cast<std::size_t>(layout.stride);
+
+            // compute the packed layout
+            VertexLayout packed_layout;
+            packed_layout.divisor = layout.divisor;
+            packed_layout.attributes.reserve(layout.attributes.size());
+            std::vector<std::size_t> packed_byte_sizes;
+            GLsizei                  packed_offset = 0;
+            for (std::size_t attrib_idx = 0; attrib_idx < layout.attributes.size(); ++attrib_idx)
+            {
+                VertexLayout::Attribute const& attribute = layout.attributes[attrib_idx];
+                VertexEncoding                 encoding = encodings[layout_idx][attrib_idx];
+
+                if (encoding != VertexEncoding::None &&
+                    (attribute.type != GL_FLOAT || attribute.shader_input_type != GL_FLOAT))
+                {
+                    throw MeshException("packVertexData - Only float attributes can be encoded");
+                }
+
+                VertexLayout::Attribute packed_attribute = attribute;
+                std::size_t             packed_byte_size = attributeByteSize(attribute);
+                switch (encoding)
+                {
+                case VertexEncoding::None:
+                    break;
+                case VertexEncoding::HalfFloat:
+                    packed_attribute = VertexLayout::Attribute(attribute.size, GL_HALF_FLOAT, GL_FALSE, 0);
+                    packed_byte_size = 2 * attribute.size;
+                    break;
+                case VertexEncoding::Snorm2_10_10_10:
+                    if (attribute.size != 3 && attribute.size != 4)
+                    {
+                        throw MeshException("packVertexData - 2_10_10_10 encoding requires 3 or 4 components");
+                    }
+                    packed_attribute = VertexLayout::Attribute(4, GL_INT_2_10_10_10_REV, GL_TRUE, 0);
+                    packed_byte_size = 4;
+                    break;
+                case VertexEncoding::Octahedral:
+                    if (attribute.size != 3)
+                    {
+                        throw MeshException("packVertexData - Octahedral encoding requires 3 components");
+                    }
+                    packed_attribute = VertexLayout::Attribute(2, GL_SHORT, GL_TRUE, 0);
+                    packed_byte_size = 4;
+                    break;
+                case VertexEncoding::Unorm16:
+                    packed_attribute = VertexLayout::Attribute(attribute.size, GL_UNSIGNED_SHORT, GL_TRUE, 0);
+                    packed_byte_size = 2 * attribute.size;
+                    break;
+                }
+
+                packed_attribute.offset = packed_offset;
+                packed_layout.attributes.push_back(packed_attribute);
+                packed_byte_sizes.push_back(packed_byte_size);
+                packed_offset += static_cast<GLsizei>((packed_byte_size + 3) & ~std::size_t(3));
+            }
+            packed_layout.stride = packed_offset;
+
+            // convert attribute by attribute: gather the components, convert them in one go and scatter the results
+            GLubyte const*       src = static_cast<GLubyte const*>(vertex_data[layout_idx]);
+            std::vector<GLubyte> packed(vertex_cnt * static_cast<std::size_t>(packed_layout.stride), 0);
+            std::vector<float>   components;
+            std::vector<GLubyte> converted;
+            for (std::size_t attrib_idx = 0; attrib_idx < layout.attributes.size(); ++attrib_idx)
+            {
+                VertexLayout::Attribute const& attribute = layout.attributes[attrib_idx];
+                VertexLayout::Attribute const& packed_attribute = packed_layout.attributes[attrib_idx];
+                VertexEncoding                 encoding = encodings[layout_idx][attrib_idx];
+                std::size_t                    src_byte_size = attributeByteSize(attribute);
+                std::size_t                    dst_byte_size = packed_byte_sizes[attrib_idx];
+                std::size_t                    dst_offset = static_cast<std::size_t>(packed_attribute.offset);
+                std::size_t                    src_stride = static_cast<std::size_t>(layout.stride);
+                std::size_t                    dst_stride = static_cast<std::size_t>(packed_layout.stride);
+
+                if (encoding == VertexEncoding::None)
+                {
+                    for (std::size_t v = 0; v < vertex_cnt; ++v)
+                    {
+                        std::memcpy(packed.data() + v * dst_stride + dst_offset,
+                                    src + v * src_stride + attribute.offset,
+                                    src_byte_size);
+                    }
+                    continue;
+                }
+
+                std::size_t component_cnt = static_cast<std::size_t>(attribute.size);
+                components.resize(vertex_cnt * component_cnt);
+                for (std::size_t v = 0; v < vertex_cnt; ++v)
+                {
+                    std::memcpy(components.data() + v * component_cnt,
+                                src + v * src_stride + attribute.offset,
+                                src_byte_size);
+                }
+
+                converted.resize(vertex_cnt * dst_byte_size);
+                switch (encoding)
+                {
+                case VertexEncoding::HalfFloat:
+                    convertFloatToHalf(components.data(),
+                                       reinterpret_cast<std::uint16_t*>(converted.data()),
+                                       components.size());
+                    break;
+                case VertexEncoding::Unorm16:
+                    convertFloatToUnorm16(components.data(),
+                                          reinterpret_cast<std::uint16_t*>(converted.data()),
+                                          components.size());
+                    break;
+                case VertexEncoding::Octahedral:
+                {
+                    std::vector<float> octahedral(vertex_cnt * 2);
+                    encodeOctahedral(components.data(), octahedral.data(), vertex_cnt);
+                    convertFloatToSnorm16(octahedral.data(),
+                                          reinterpret_cast<std::int16_t*>(converted.data()),
+                                          octahedral.size());
+                    break;
+                }
+                case VertexEncoding::Snorm2_10_10_10:
+                    for (std::size_t v = 0; v < vertex_cnt; ++v)
+                    {
+                        float const*  c = components.data() + v * component_cnt;
+                        std::uint32_t value = packSnorm2_10_10_10(c[0], c[1], c[2], component_cnt > 3 ? c[3] : 0.0f);
+                        std::memcpy(converted.data() + v * 4, &value, 4);
+                    }
+                    break;
+                case VertexEncoding::None:
+                    break;
+                }
+
+                for (std::size_t v = 0; v < vertex_cnt; ++v)
+                {
+                    std::memcpy(packed.data() + v * dst_stride + dst_offset,
+                                converted.data() + v * dst_byte_size,
+                                dst_byte_size);
+                }
+            }
+
+            retval.unpacked_byte_size += vertex_data_byte_sizes[layout_idx];
+            retval.packed_byte_size += packed.size();
+            retval.vertex_data.push_back(std::move(packed));
+            retval.vertex_descriptor.push_back(packed_layout);
+        }
+
+        return retval;
+    }
+
+    /**
+     * \brief Rewrite float vertex attributes to compact encodings, see above.
+     */
+    template<typename VertexDataType>
+    inline PackedVertexData packVertexData(std::vector<std::vector<VertexDataType>> const& vertex_data,
+                                           std::vector<VertexLayout> const&                vertex_descriptor,
+                                           std::vector<std::vector<VertexEncoding>> const& encodings)
+    {
+        std::vector<void const*> data_ptrs;
+        std::vector<std::size_t> byte_sizes;
+        for (auto const& data : vertex_data)
+        {
+            data_ptrs.push_back(data.data());
+            byte_sizes.push_back(data.size() * sizeof(VertexDataType));
+        }
+
+        return packVertexData(data_ptrs, byte_sizes, vertex_descriptor, encodings);
+    }
+
+} // namespace glowl
+
+#endif // GLOWL_VERTEXPACKING_HPP
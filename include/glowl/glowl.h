@@ -1,12 +1,30 @@
 #ifndef GLOWL_GLOWL_H
 #define GLOWL_GLOWL_H
 
+#include "BoundingVolumes.hpp"
+#include "BufferArena.hpp"
+#include "BufferKernels.hpp"
 #include "BufferObject.hpp"
 #include "FramebufferObject.hpp"
 #include "GLSLProgram.hpp"
+#include "GpuCulling.hpp"
 #include "ImmutableBufferObject.hpp"
+#include "IndexPacking.hpp"
+#include "MappedRange.hpp"
 #include "Mesh.hpp"
+#include "MeshArena.hpp"
+#include "MeshBatch.hpp"
+#include "MeshBuilder.hpp"
+#include "MeshCache.hpp"
+#include "MeshLod.hpp"
+#include "MeshOptimizer.hpp"
+#include "Meshlets.hpp"
+#include "NamePool.hpp"
+#include "ReadbackBuffer.hpp"
 #include "Sampler.hpp"
+#include "ShadowedBufferObject.hpp"
+#include "SparseBufferObject.hpp"
+#include "StreamingBuffer.hpp"
 #include "Texture.hpp"
 #include "Texture2D.hpp"
 #include "Texture2DArray.hpp"
@@ -14,6 +32,10 @@
 #include "Texture3D.hpp"
 #include "Texture3DView.hpp"
 #include "TextureCubemapArray.hpp"
+#include "UniformBlock.hpp"
+#include "UploadQueue.hpp"
+#include "VertexArrayCache.hpp"
 #include "VertexLayout.hpp"
+#include "VertexPacking.hpp"
 
 #endif // GLOWL_GLOWL_H